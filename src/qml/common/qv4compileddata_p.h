@@ -1355,6 +1355,67 @@ struct Unit
 
 static_assert(sizeof(Unit) == 248, "Unit structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
 
+static const char bundle_magic_str[] = "qv4bundl";
+
+// A bundle combines the compilation units of a whole application. The units are stored
+// unmodified and suitably aligned, so that they can be used in place once the bundle is mapped.
+// The bundle's own string table holds the unit URLs. For each unit, the bundle records the other
+// units it imports or instantiates, as indices into the unit table.
+struct BundleUnit
+{
+    quint32_le urlIndex;
+    quint32_le offsetToUnit;
+    quint32_le nDependencies;
+    quint32_le offsetToDependencies;
+};
+static_assert(sizeof(BundleUnit) == 16, "BundleUnit structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+
+struct Bundle
+{
+    char magic[8];
+    quint32_le version;
+    quint32_le qtVersion;
+    quint32_le bundleSize;
+    quint32_le stringTableSize;
+    quint32_le offsetToStringTable;
+    quint32_le unitTableSize;
+    quint32_le offsetToUnitTable;
+    quint32_le reserved;
+
+    QString stringAt(uint idx) const {
+        Q_ASSERT(idx < stringTableSize);
+        const quint32_le *offsetTable = reinterpret_cast<const quint32_le*>((reinterpret_cast<const char *>(this)) + offsetToStringTable);
+        const quint32_le offset = offsetTable[idx];
+        const String *str = reinterpret_cast<const String*>(reinterpret_cast<const char *>(this) + offset);
+        Q_ASSERT(str->size >= 0);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        // Bundles are never unmapped.
+        return QString::fromRawData(reinterpret_cast<const QChar *>(str + 1), str->size);
+#else
+        const quint16_le *characters = reinterpret_cast<const quint16_le *>(str + 1);
+        QString qstr(str->size, Qt::Uninitialized);
+        QChar *ch = qstr.data();
+        for (int i = 0; i < str->size; ++i)
+             ch[i] = QChar(characters[i]);
+         return qstr;
+#endif
+    }
+
+    const BundleUnit *unitAt(uint idx) const {
+        Q_ASSERT(idx < unitTableSize);
+        return reinterpret_cast<const BundleUnit *>(reinterpret_cast<const char *>(this) + offsetToUnitTable) + idx;
+    }
+
+    const Unit *unitData(uint idx) const {
+        return reinterpret_cast<const Unit *>(reinterpret_cast<const char *>(this) + unitAt(idx)->offsetToUnit);
+    }
+
+    const quint32_le *dependencyTable(uint idx) const {
+        return reinterpret_cast<const quint32_le *>(reinterpret_cast<const char *>(this) + unitAt(idx)->offsetToDependencies);
+    }
+};
+static_assert(sizeof(Bundle) == 40, "Bundle structure needs to have the expected size to be binary compatible on disk when generated by host compiler and loaded by target");
+
 struct TypeReference
 {
     TypeReference(const Location &loc)
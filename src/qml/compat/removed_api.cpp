@@ -32,7 +32,7 @@ bool QJSEngine::convertV2(const QJSValue &value, int type, void *ptr)
 bool QQmlPrivate::AOTCompiledContext::getEnumLookup(uint index, int *target) const
 {
     using namespace QQmlPrivate;
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     auto mt = QMetaType(l->qmlEnumValueLookup.metaType);
     QVariant buffer(mt);
     getEnumLookup(index, buffer.data());
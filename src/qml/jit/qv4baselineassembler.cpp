@@ -10,6 +10,7 @@
 #include <private/qv4function_p.h>
 #include <private/qv4runtime_p.h>
 #include <private/qv4stackframe_p.h>
+#include <private/qv4vme_moth_p.h>
 
 #include <wtf/Vector.h>
 #include <assembler/MacroAssembler.h>
@@ -343,6 +344,47 @@ public:
         passAsArg(AccumulatorRegister, 0);
         doCall();
     }
+
+#if ENABLE_OPTIMIZING_JIT
+    // Loads the lhs into ScratchRegister, bailing out unless both it and the accumulator
+    // are integers.
+    void speculateBothInt(Address lhsAddr, bool accumulatorIsInt, JumpList &bailouts)
+    {
+        if (!accumulatorIsInt) {
+            urshift64(AccumulatorRegister, TrustedImm32(32), ScratchRegister);
+            bailouts.append(branch32(NotEqual, TrustedImm32(int(IntegerTag)), ScratchRegister));
+        }
+        load64(lhsAddr, ScratchRegister);
+        urshift64(ScratchRegister, TrustedImm32(32), ScratchRegister2);
+        bailouts.append(branch32(NotEqual, TrustedImm32(int(IntegerTag)), ScratchRegister2));
+    }
+
+    void unboxNumber(RegisterID src, FPRegisterID dest, JumpList &bailouts)
+    {
+        urshift64(src, TrustedImm32(32), ScratchRegister2);
+        Jump notInt = branch32(NotEqual, TrustedImm32(int(IntegerTag)), ScratchRegister2);
+        convertInt32ToDouble(src, dest);
+        Jump done = jump();
+
+        notInt.link(this);
+        move(TrustedImm64(Value::NumberMask), ScratchRegister2);
+        and64(src, ScratchRegister2);
+        bailouts.append(branch64(LessThan, ScratchRegister2, TrustedImm64(Value::NumberDiscriminator)));
+        move(TrustedImm64(Value::EncodeMask), ScratchRegister2);
+        xor64(src, ScratchRegister2);
+        move64ToDouble(ScratchRegister2, dest);
+
+        done.link(this);
+    }
+
+    // Unboxes the lhs into FPScratchRegister and the accumulator into FPScratchRegister2.
+    void speculateBothNumber(Address lhsAddr, JumpList &bailouts)
+    {
+        load64(lhsAddr, ScratchRegister);
+        unboxNumber(ScratchRegister, FPScratchRegister, bailouts);
+        unboxNumber(AccumulatorRegister, FPScratchRegister2, bailouts);
+    }
+#endif // ENABLE_OPTIMIZING_JIT
 };
 
 typedef PlatformAssembler64 PlatformAssembler;
@@ -1004,8 +1046,14 @@ void BaselineAssembler::unot()
     });
 }
 
+enum ArithmeticOp { ArithmeticAdd, ArithmeticSub, ArithmeticMul };
+
 void BaselineAssembler::add(int lhs)
 {
+    const int site = typeFeedbackSites++;
+    if (speculateArithmetic(ArithmeticAdd, lhs, site))
+        return;
+
     auto done = pasm()->binopBothIntPath(regAddr(lhs), [this](){
         auto overflowed = pasm()->branchAdd32(PlatformAssembler::Overflow,
                                               PlatformAssembler::AccumulatorRegisterValue,
@@ -1017,6 +1065,7 @@ void BaselineAssembler::add(int lhs)
 
     // slow path:
     saveAccumulatorInFrame();
+    recordTypeFeedback(lhs, site);
     pasm()->prepareCallWithArgCount(3);
     pasm()->passAccumulatorAsArg(2);
     pasm()->passJSSlotAsArg(lhs, 1);
@@ -1159,6 +1208,10 @@ void BaselineAssembler::shlConst(int rhs)
 
 void BaselineAssembler::mul(int lhs)
 {
+    const int site = typeFeedbackSites++;
+    if (speculateArithmetic(ArithmeticMul, lhs, site))
+        return;
+
     auto done = pasm()->binopBothIntPath(regAddr(lhs), [this](){
         auto overflowed = pasm()->branchMul32(PlatformAssembler::Overflow,
                                               PlatformAssembler::AccumulatorRegisterValue,
@@ -1170,6 +1223,7 @@ void BaselineAssembler::mul(int lhs)
 
     // slow path:
     saveAccumulatorInFrame();
+    recordTypeFeedback(lhs, site);
     pasm()->prepareCallWithArgCount(2);
     pasm()->passAccumulatorAsArg(1);
     pasm()->passJSSlotAsArg(lhs, 0);
@@ -1202,6 +1256,10 @@ void BaselineAssembler::mod(int lhs)
 
 void BaselineAssembler::sub(int lhs)
 {
+    const int site = typeFeedbackSites++;
+    if (speculateArithmetic(ArithmeticSub, lhs, site))
+        return;
+
     auto done = pasm()->binopBothIntPath(regAddr(lhs), [this](){
         auto overflowed = pasm()->branchSub32(PlatformAssembler::Overflow,
                                               PlatformAssembler::AccumulatorRegisterValue,
@@ -1213,6 +1271,7 @@ void BaselineAssembler::sub(int lhs)
 
     // slow path:
     saveAccumulatorInFrame();
+    recordTypeFeedback(lhs, site);
     pasm()->prepareCallWithArgCount(2);
     pasm()->passAccumulatorAsArg(1);
     pasm()->passJSSlotAsArg(lhs, 0);
@@ -1284,8 +1343,12 @@ void BaselineAssembler::cmpneInt(int lhs)
     done.link(pasm());
 }
 
-void BaselineAssembler::cmp(int cond, CmpFunc function, int lhs)
+void BaselineAssembler::cmp(int cond, int doubleCond, CmpFunc function, int lhs)
 {
+    const int site = typeFeedbackSites++;
+    if (speculateComparison(cond, doubleCond, lhs, site))
+        return;
+
     auto c = static_cast<PlatformAssembler::RelationalCondition>(cond);
     auto done = pasm()->binopBothIntPath(regAddr(lhs), [this, c](){
         pasm()->compare32(c, PlatformAssembler::ScratchRegister,
@@ -1296,6 +1359,7 @@ void BaselineAssembler::cmp(int cond, CmpFunc function, int lhs)
 
     // slow path:
     saveAccumulatorInFrame();
+    recordTypeFeedback(lhs, site);
     pasm()->prepareCallWithArgCount(2);
     pasm()->passAccumulatorAsArg(1);
     pasm()->passJSSlotAsArg(lhs, 0);
@@ -1310,42 +1374,50 @@ void BaselineAssembler::cmp(int cond, CmpFunc function, int lhs)
 
 void BaselineAssembler::cmpeq(int lhs)
 {
-    cmp(PlatformAssembler::Equal, &Runtime::CompareEqual::call, lhs);
+    cmp(PlatformAssembler::Equal, PlatformAssembler::DoubleEqual,
+        &Runtime::CompareEqual::call, lhs);
 }
 
 void BaselineAssembler::cmpne(int lhs)
 {
-    cmp(PlatformAssembler::NotEqual, &Runtime::CompareNotEqual::call, lhs);
+    cmp(PlatformAssembler::NotEqual, PlatformAssembler::DoubleNotEqualOrUnordered,
+        &Runtime::CompareNotEqual::call, lhs);
 }
 
 void BaselineAssembler::cmpgt(int lhs)
 {
-    cmp(PlatformAssembler::GreaterThan, &Runtime::CompareGreaterThan::call, lhs);
+    cmp(PlatformAssembler::GreaterThan, PlatformAssembler::DoubleGreaterThan,
+        &Runtime::CompareGreaterThan::call, lhs);
 }
 
 void BaselineAssembler::cmpge(int lhs)
 {
-    cmp(PlatformAssembler::GreaterThanOrEqual, &Runtime::CompareGreaterEqual::call, lhs);
+    cmp(PlatformAssembler::GreaterThanOrEqual, PlatformAssembler::DoubleGreaterThanOrEqual,
+        &Runtime::CompareGreaterEqual::call, lhs);
 }
 
 void BaselineAssembler::cmplt(int lhs)
 {
-    cmp(PlatformAssembler::LessThan, &Runtime::CompareLessThan::call, lhs);
+    cmp(PlatformAssembler::LessThan, PlatformAssembler::DoubleLessThan,
+        &Runtime::CompareLessThan::call, lhs);
 }
 
 void BaselineAssembler::cmple(int lhs)
 {
-    cmp(PlatformAssembler::LessThanOrEqual, &Runtime::CompareLessEqual::call, lhs);
+    cmp(PlatformAssembler::LessThanOrEqual, PlatformAssembler::DoubleLessThanOrEqual,
+        &Runtime::CompareLessEqual::call, lhs);
 }
 
 void BaselineAssembler::cmpStrictEqual(int lhs)
 {
-    cmp(PlatformAssembler::Equal, &Runtime::CompareStrictEqual::call, lhs);
+    cmp(PlatformAssembler::Equal, PlatformAssembler::DoubleEqual,
+        &Runtime::CompareStrictEqual::call, lhs);
 }
 
 void BaselineAssembler::cmpStrictNotEqual(int lhs)
 {
-    cmp(PlatformAssembler::NotEqual, &Runtime::CompareStrictNotEqual::call, lhs);
+    cmp(PlatformAssembler::NotEqual, PlatformAssembler::DoubleNotEqualOrUnordered,
+        &Runtime::CompareStrictNotEqual::call, lhs);
 }
 
 int BaselineAssembler::jump(int offset)
@@ -1608,6 +1680,184 @@ void BaselineAssembler::ret()
     pasm()->generateFunctionExit();
 }
 
+static void recordTypeFeedbackHelper(Function *function, int site, const Value &lhs,
+                                     const Value &rhs)
+{
+    char &feedback = function->typeFeedback.data()[site];
+    feedback |= (lhs.isNumber() && rhs.isNumber()) ? Function::SawDouble : Function::SawOther;
+}
+
+void BaselineAssembler::collectTypeFeedback(Function *function)
+{
+    feedbackFunction = function;
+    speculating = false;
+}
+
+void BaselineAssembler::speculateOnTypeFeedback(Function *function)
+{
+    feedbackFunction = function;
+    speculating = true;
+}
+
+void BaselineAssembler::recordTypeFeedback(int lhs, int site)
+{
+    if (!feedbackFunction || speculating)
+        return;
+
+    // Expects the accumulator to be saved in the frame already.
+    pasm()->prepareCallWithArgCount(4);
+    pasm()->passAccumulatorAsArg(3);
+    pasm()->passJSSlotAsArg(lhs, 2);
+    pasm()->passInt32AsArg(site, 1);
+    pasm()->passFunctionAsArg(0);
+    pasm()->PlatformAssemblerCommon::callRuntime(
+                reinterpret_cast<void *>(&recordTypeFeedbackHelper), "recordTypeFeedbackHelper");
+}
+
+void BaselineAssembler::deoptimize()
+{
+    // Let the interpreter finish the function, starting over at the current instruction.
+    saveAccumulatorInFrame();
+    pasm()->prepareCallWithArgCount(3);
+    pasm()->passInt32AsArg(instructionOffset, 2);
+    pasm()->passEngineAsArg(1);
+    pasm()->passCppFrameAsArg(0);
+    pasm()->PlatformAssemblerCommon::callRuntime(
+                reinterpret_cast<void *>(&Moth::VME::deoptimize), "VME::deoptimize");
+    pasm()->saveReturnValueInAccumulator();
+    pasm()->generateFunctionExit();
+}
+
+bool BaselineAssembler::speculateArithmetic(int op, int lhs, int site)
+{
+    const bool accIsInt = accumulatorIsInt;
+    accumulatorIsInt = false;
+
+#if ENABLE_OPTIMIZING_JIT
+    if (!speculating || site >= feedbackFunction->typeFeedback.size())
+        return false;
+
+    const char feedback = feedbackFunction->typeFeedback.at(site);
+    if (feedback & Function::SawOther)
+        return false;
+
+    PlatformAssembler::JumpList notBothInt;
+    PlatformAssembler::JumpList bailouts;
+    pasm()->speculateBothInt(regAddr(lhs), accIsInt, notBothInt);
+
+    PlatformAssembler::Jump overflowed;
+    switch (op) {
+    case ArithmeticAdd:
+        overflowed = pasm()->branchAdd32(PlatformAssembler::Overflow,
+                                         PlatformAssembler::AccumulatorRegisterValue,
+                                         PlatformAssembler::ScratchRegister);
+        break;
+    case ArithmeticSub:
+        overflowed = pasm()->branchSub32(PlatformAssembler::Overflow,
+                                         PlatformAssembler::AccumulatorRegisterValue,
+                                         PlatformAssembler::ScratchRegister);
+        break;
+    case ArithmeticMul:
+        overflowed = pasm()->branchMul32(PlatformAssembler::Overflow,
+                                         PlatformAssembler::AccumulatorRegisterValue,
+                                         PlatformAssembler::ScratchRegister);
+        break;
+    }
+    pasm()->setAccumulatorTag(IntegerTag, PlatformAssembler::ScratchRegister);
+    PlatformAssembler::JumpList done;
+    done.append(pasm()->jump());
+
+    if (feedback & Function::SawDouble) {
+        // Both the overflow and any non-integer operands take the inline double path.
+        notBothInt.link(pasm());
+        overflowed.link(pasm());
+        pasm()->speculateBothNumber(regAddr(lhs), bailouts);
+        switch (op) {
+        case ArithmeticAdd:
+            pasm()->addDouble(PlatformAssembler::FPScratchRegister2,
+                              PlatformAssembler::FPScratchRegister);
+            break;
+        case ArithmeticSub:
+            pasm()->subDouble(PlatformAssembler::FPScratchRegister2,
+                              PlatformAssembler::FPScratchRegister);
+            break;
+        case ArithmeticMul:
+            pasm()->mulDouble(PlatformAssembler::FPScratchRegister2,
+                              PlatformAssembler::FPScratchRegister);
+            break;
+        }
+        pasm()->encodeDoubleIntoAccumulator(PlatformAssembler::FPScratchRegister);
+        done.append(pasm()->jump());
+    } else {
+        bailouts.append(notBothInt);
+        bailouts.append(overflowed);
+    }
+
+    bailouts.link(pasm());
+    deoptimize();
+
+    done.link(pasm());
+    accumulatorIsInt = !(feedback & Function::SawDouble);
+    return true;
+#else
+    Q_UNUSED(accIsInt);
+    Q_UNUSED(op);
+    Q_UNUSED(lhs);
+    Q_UNUSED(site);
+    return false;
+#endif
+}
+
+bool BaselineAssembler::speculateComparison(int cond, int doubleCond, int lhs, int site)
+{
+#if ENABLE_OPTIMIZING_JIT
+    if (!speculating || site >= feedbackFunction->typeFeedback.size())
+        return false;
+
+    const char feedback = feedbackFunction->typeFeedback.at(site);
+    if (feedback & Function::SawOther)
+        return false;
+
+    PlatformAssembler::JumpList notBothInt;
+    PlatformAssembler::JumpList bailouts;
+    pasm()->speculateBothInt(regAddr(lhs), accumulatorIsInt, notBothInt);
+    pasm()->compare32(static_cast<PlatformAssembler::RelationalCondition>(cond),
+                      PlatformAssembler::ScratchRegister,
+                      PlatformAssembler::AccumulatorRegisterValue,
+                      PlatformAssembler::AccumulatorRegisterValue);
+    PlatformAssembler::JumpList done;
+    done.append(pasm()->jump());
+
+    if (feedback & Function::SawDouble) {
+        notBothInt.link(pasm());
+        pasm()->speculateBothNumber(regAddr(lhs), bailouts);
+        auto isTrue = pasm()->branchDouble(
+                    static_cast<PlatformAssembler::DoubleCondition>(doubleCond),
+                    PlatformAssembler::FPScratchRegister, PlatformAssembler::FPScratchRegister2);
+        pasm()->move(TrustedImm64(0), PlatformAssembler::AccumulatorRegister);
+        done.append(pasm()->jump());
+        isTrue.link(pasm());
+        pasm()->move(TrustedImm64(1), PlatformAssembler::AccumulatorRegister);
+        done.append(pasm()->jump());
+    } else {
+        bailouts.append(notBothInt);
+    }
+
+    bailouts.link(pasm());
+    deoptimize();
+
+    done.link(pasm());
+    pasm()->setAccumulatorTag(QV4::Value::ValueTypeInternal::Boolean);
+    return true;
+#else
+    Q_UNUSED(cond);
+    Q_UNUSED(doubleCond);
+    Q_UNUSED(lhs);
+    Q_UNUSED(site);
+    return false;
+#endif
+}
+
 } // JIT namespace
 } // QV4 namepsace
 
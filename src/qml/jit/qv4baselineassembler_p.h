@@ -134,12 +134,30 @@ public:
     // other stuff
     void ret();
 
+    // type feedback and speculation
+    void collectTypeFeedback(Function *function);
+    void speculateOnTypeFeedback(Function *function);
+    int typeFeedbackSiteCount() const { return typeFeedbackSites; }
+    void setInstructionOffset(int offset) { instructionOffset = offset; }
+    void setAccumulatorIsInt(bool isInt) { accumulatorIsInt = isInt && speculating; }
+
 protected:
     void *d;
 
 private:
     typedef unsigned(*CmpFunc)(const Value&,const Value&);
-    void cmp(int cond, CmpFunc function, int lhs);
+    void cmp(int cond, int doubleCond, CmpFunc function, int lhs);
+
+    bool speculateArithmetic(int op, int lhs, int site);
+    bool speculateComparison(int cond, int doubleCond, int lhs, int site);
+    void recordTypeFeedback(int lhs, int site);
+    void deoptimize();
+
+    Function *feedbackFunction = nullptr;
+    bool speculating = false;
+    bool accumulatorIsInt = false;
+    int typeFeedbackSites = 0;
+    int instructionOffset = 0;
 };
 
 } // namespace JIT
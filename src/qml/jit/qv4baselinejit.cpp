@@ -13,10 +13,18 @@ using namespace QV4;
 using namespace QV4::JIT;
 using namespace QV4::Moth;
 
-BaselineJIT::BaselineJIT(Function *function)
+BaselineJIT::BaselineJIT(Function *function, Tier tier)
     : function(function)
       , as(new BaselineAssembler(&(function->compilationUnit->constants->asValue<Value>())))
-{}
+      , tier(tier)
+{
+#if ENABLE_OPTIMIZING_JIT
+    if (tier == OptimizedTier)
+        as->speculateOnTypeFeedback(function);
+    else if (ExecutionEngine::s_jitOptimizeThreshold != std::numeric_limits<int>::max())
+        as->collectTypeFeedback(function);
+#endif
+}
 
 BaselineJIT::~BaselineJIT()
 {}
@@ -36,6 +44,22 @@ void BaselineJIT::generate()
     decode(code, len);
     as->generateEpilogue();
 
+    if (tier == OptimizedTier) {
+        function->optimized = true;
+        if (!canOptimize)
+            return;
+
+        // The baseline code may still be running further up the stack.
+        function->baselineCodeRef = function->codeRef;
+        function->baselineJittedCode = function->jittedCode;
+        as->link(function);
+        if (!function->jittedCode)
+            function->jittedCode = function->baselineJittedCode;
+        return;
+    }
+
+    if (as->typeFeedbackSiteCount())
+        function->typeFeedback = QByteArray(as->typeFeedbackSiteCount(), '\0');
     as->link(function);
 //    qDebug()<<"done";
 }
@@ -142,6 +166,8 @@ void BaselineJIT::generate_StoreScopedLocal(int scope, int index)
 
 void BaselineJIT::generate_LoadRuntimeString(int stringId)
 {
+    // Runtime strings are created lazily, but the generated code loads them directly.
+    function->runtimeString(stringId);
     as->loadString(stringId);
 }
 
@@ -478,6 +504,11 @@ void BaselineJIT::generate_ConstructWithSpread(int func, int argc, int argv)
 
 void BaselineJIT::generate_SetUnwindHandler(int offset)
 {
+    // Unwind handlers are native code addresses, which the interpreter cannot resume at after
+    // a deoptimization.
+    if (tier == OptimizedTier)
+        canOptimize = false;
+
     if (offset)
         labels.insert(as->setUnwindHandler(absoluteOffset(offset)));
     else
@@ -906,14 +937,33 @@ void BaselineJIT::generate_GetTemplateObject(int index)
 
 ByteCodeHandler::Verdict BaselineJIT::startInstruction(Instr::Type /*instr*/)
 {
-    if (labels.contains(currentInstructionOffset()))
+    if (labels.contains(currentInstructionOffset())) {
         as->addLabel(currentInstructionOffset());
+        as->setAccumulatorIsInt(false);
+    }
+    as->setInstructionOffset(currentInstructionOffset());
     return ProcessInstruction;
 }
 
 void BaselineJIT::endInstruction(Instr::Type instr)
 {
-    Q_UNUSED(instr);
+    switch (instr) {
+    case Instr::Type::LoadZero:
+    case Instr::Type::LoadInt:
+        as->setAccumulatorIsInt(true);
+        break;
+    case Instr::Type::StoreReg:
+    case Instr::Type::MoveReg:
+    case Instr::Type::MoveConst:
+    case Instr::Type::Add:
+    case Instr::Type::Sub:
+    case Instr::Type::Mul:
+        // These leave the accumulator alone, or track its type themselves.
+        break;
+    default:
+        as->setAccumulatorIsInt(false);
+        break;
+    }
 }
 
 #endif // QT_CONFIG(qml_jit)
@@ -33,7 +33,12 @@ class BaselineAssembler;
 class BaselineJIT final: public Moth::ByteCodeHandler
 {
 public:
-    BaselineJIT(QV4::Function *);
+    enum Tier {
+        BaselineTier,   // generic code, collecting type feedback
+        OptimizedTier   // speculates on the type feedback, deoptimizes to the interpreter
+    };
+
+    BaselineJIT(QV4::Function *, Tier tier = BaselineTier);
     ~BaselineJIT() override;
 
     void generate();
@@ -180,6 +185,8 @@ private:
     QV4::Function *function;
     QScopedPointer<BaselineAssembler> as;
     QSet<int> labels;
+    Tier tier;
+    bool canOptimize = true;
 };
 
 } // namespace JIT
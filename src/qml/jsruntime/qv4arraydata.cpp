@@ -9,6 +9,9 @@
 #include "qv4string_p.h"
 #include "qv4jscall_p.h"
 
+#include <algorithm>
+#include <charconv>
+
 using namespace QV4;
 
 DEFINE_MANAGED_VTABLE(ArrayData);
@@ -51,9 +54,25 @@ Q_STATIC_ASSERT(sizeof(Heap::ArrayData) == sizeof(Heap::SparseArrayData));
 void Heap::ArrayData::markObjects(Heap::Base *base, MarkStack *stack)
 {
     ArrayData *a = static_cast<ArrayData *>(base);
+    // Packed arrays only contain numbers, there is nothing to mark in them
+    if (a->isPacked())
+        return;
     a->values.mark(stack);
 }
 
+Heap::ArrayData::ElementKind Heap::ArrayData::elementKindOf(const Value *v, uint n)
+{
+    ElementKind kind = PackedInt32;
+    for (const Value *end = v + n; v < end; ++v) {
+        if (v->isInteger())
+            continue;
+        if (!v->isDouble())
+            return Generic;
+        kind = PackedDouble;
+    }
+    return kind;
+}
+
 
 void ArrayData::realloc(Object *o, Type newType, uint requested, bool enforceAttributes)
 {
@@ -63,6 +82,7 @@ void ArrayData::realloc(Object *o, Type newType, uint requested, bool enforceAtt
     uint alloc = 8;
     uint toCopy = 0;
     uint offset = 0;
+    ushort elementKind = Heap::ArrayData::Generic;
 
     if (d) {
         bool hasAttrs = d->attrs();
@@ -81,6 +101,8 @@ void ArrayData::realloc(Object *o, Type newType, uint requested, bool enforceAtt
         }
         if (d->type() > newType)
             newType = d->type();
+        if (newType == Heap::ArrayData::Simple && !enforceAttributes)
+            elementKind = d->d()->elementKind;
     }
 
     while (alloc < requested)
@@ -95,6 +117,7 @@ void ArrayData::realloc(Object *o, Type newType, uint requested, bool enforceAtt
         n->init();
         n->offset = 0;
         n->values.size = d ? d->d()->values.size : 0;
+        n->elementKind = elementKind;
         newData = n;
     } else {
         Heap::SparseArrayData *n = scope.engine->memoryManager->allocManaged<SparseArrayData>(size);
@@ -192,6 +215,8 @@ bool SimpleArrayData::put(Object *o, uint index, const Value &value)
     Heap::SimpleArrayData *dd = o->d()->arrayData.cast<Heap::SimpleArrayData>();
     Q_ASSERT(index >= dd->values.size || !dd->attrs || !dd->attrs[index].isAccessor());
     // ### honour attributes
+    if (index > dd->values.size)
+        dd->elementKind = Heap::ArrayData::Generic;
     dd->setData(o->engine(), index, value);
     if (index >= dd->values.size) {
         if (dd->attrs)
@@ -220,6 +245,7 @@ bool SimpleArrayData::del(Object *o, uint index)
 
 void SimpleArrayData::setAttribute(Object *o, uint index, PropertyAttributes attrs)
 {
+    Q_ASSERT(!o->arrayData()->isPacked());
     o->arrayData()->attrs[index] = attrs;
 }
 
@@ -619,6 +645,17 @@ bool ArrayElementLessThan::operator()(Value v1, Value v2) const
     return p1s->toQString() < p2s->toQString();
 }
 
+// The default sort order compares the string representations of the elements. For integers
+// we can do that on the stack, without creating any strings.
+static bool int32StringLessThan(Value v1, Value v2)
+{
+    char s1[16];
+    char s2[16];
+    const char *e1 = std::to_chars(s1, s1 + sizeof(s1), v1.int_32()).ptr;
+    const char *e2 = std::to_chars(s2, s2 + sizeof(s2), v2.int_32()).ptr;
+    return std::lexicographical_compare(s1, e1, s2, e2);
+}
+
 void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &comparefn, uint len)
 {
     if (!len)
@@ -692,8 +729,8 @@ void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &c
         if (len > d->values.size)
             len = d->values.size;
 
-        // sort empty values to the end
-        for (uint i = 0; i < len; i++) {
+        // sort empty values to the end. Packed arrays don't have any.
+        for (uint i = 0; i < len && !d->isPacked(); i++) {
             if (d->data(i).isEmpty()) {
                 while (--len > i)
                     if (!d->data(len).isEmpty())
@@ -709,17 +746,19 @@ void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &c
     }
 
 
-    ArrayElementLessThan lessThan(engine, comparefn);
-
     const auto thisArrayData = thisObject->arrayData();
+    const auto sortRange = [&](Value *begin, Value *end) {
+        if (comparefn.isUndefined() && thisArrayData->elementKind == Heap::ArrayData::PackedInt32)
+            sortHelper(begin, end, int32StringLessThan);
+        else
+            sortHelper(begin, end, ArrayElementLessThan(engine, comparefn));
+    };
+
     uint startIndex = thisArrayData->mappedIndex(0);
     uint endIndex = thisArrayData->mappedIndex(len - 1) + 1;
     if (startIndex < endIndex) {
         // Values are contiguous. Sort right away.
-        sortHelper(
-                thisArrayData->values.values + startIndex,
-                thisArrayData->values.values + endIndex,
-                lessThan);
+        sortRange(thisArrayData->values.values + startIndex, thisArrayData->values.values + endIndex);
     } else {
         // Values wrap around the end of the allocation. Close the gap to form a contiguous array.
         // We're going to sort anyway. So we don't need to care about order.
@@ -739,7 +778,7 @@ void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &c
         }
 
         thisArrayData->offset = 0;
-        sortHelper(thisArrayData->values.values, thisArrayData->values.values + len, lessThan);
+        sortRange(thisArrayData->values.values, thisArrayData->values.values + len);
     }
 
 #ifdef CHECK_SPARSE_ARRAYS
@@ -56,7 +56,7 @@ namespace Heap {
 
 #define ArrayDataMembers(class, Member) \
     Member(class, NoMark, ushort, type) \
-    Member(class, NoMark, ushort, unused) \
+    Member(class, NoMark, ushort, elementKind) \
     Member(class, NoMark, uint, offset) \
     Member(class, NoMark, PropertyAttributes *, attrs) \
     Member(class, NoMark, SparseArray *, sparse) \
@@ -67,7 +67,21 @@ DECLARE_HEAP_OBJECT(ArrayData, Base) {
 
     enum Type { Simple = 0, Sparse = 1, Custom = 2 };
 
+    // Packed kinds are only ever set on Simple arrays without attributes and without
+    // holes. All their elements are numbers, so they don't hold any references to the
+    // heap. A packed array turns Generic on the first write that breaks that invariant,
+    // and never goes back.
+    enum ElementKind { Generic = 0, PackedInt32 = 1, PackedDouble = 2 };
+
     bool isSparse() const { return type == Sparse; }
+    bool isPacked() const { return elementKind != Generic; }
+
+    void updateElementKind(Value v) {
+        if (elementKind == Generic || v.isInteger())
+            return;
+        elementKind = v.isDouble() ? PackedDouble : Generic;
+    }
+    static ElementKind elementKindOf(const Value *v, uint n);
 
     const ArrayVTable *vtable() const { return reinterpret_cast<const ArrayVTable *>(internalClass->vtable); }
 
@@ -88,6 +102,7 @@ DECLARE_HEAP_OBJECT(ArrayData, Base) {
     }
 
     void setArrayData(EngineBase *e, uint index, Value newVal) {
+        updateElementKind(newVal);
         values.set(e, index, newVal);
     }
 
@@ -99,6 +114,7 @@ struct SimpleArrayData : public ArrayData {
     uint mappedIndex(uint index) const { index += offset; if (index >= values.alloc) index -= values.alloc; return index; }
     const Value &data(uint index) const { return values[mappedIndex(index)]; }
     void setData(EngineBase *e, uint index, Value newVal) {
+        updateElementKind(newVal);
         values.set(e, mappedIndex(index), newVal);
     }
 
@@ -332,6 +348,7 @@ void ArrayData::setProperty(QV4::EngineBase *e, uint index, const Property *p)
 {
     uint mapped = mappedIndex(index);
     Q_ASSERT(mapped != UINT_MAX);
+    updateElementKind(p->value);
     values.set(e, mapped, p->value);
     if (attributes(index).isAccessor())
         values.set(e, mapped + 1 /*QV4::Object::SetterOffset*/, p->set);
@@ -833,6 +833,22 @@ ReturnedValue ArrayPrototype::method_slice(const FunctionObject *b, const Value
             end = (uint) e;
     }
 
+    if (start < end && o->isArrayObject() && o->arrayData()
+            && o->arrayData()->isPacked() && end <= o->arrayData()->length()) {
+        const Heap::SimpleArrayData *sa = o->d()->arrayData.cast<Heap::SimpleArrayData>();
+        const uint count = end - start;
+        result->arrayCreate();
+        result->arrayReserve(count);
+        Heap::SimpleArrayData *rd = result->d()->arrayData.cast<Heap::SimpleArrayData>();
+        // no write barrier required, packed arrays don't hold references
+        for (uint i = 0; i < count; ++i)
+            rd->values.values[i] = sa->data(start + i);
+        rd->values.size = count;
+        rd->elementKind = sa->elementKind;
+        result->setArrayLengthUnchecked(count);
+        return result->asReturnedValue();
+    }
+
     ScopedValue v(scope);
     uint n = 0;
     for (uint i = start; i < end; ++i) {
@@ -1087,6 +1103,25 @@ ReturnedValue ArrayPrototype::method_indexOf(const FunctionObject *b, const Valu
         if (len > sa->values.size)
             len = sa->values.size;
         uint idx = fromIndex;
+        if (sa->isPacked()) {
+            // Only numbers in here, and none of them can be strictly equal to NaN
+            if (!searchValue->isNumber() || std::isnan(searchValue->asDouble()))
+                return Encode(-1);
+            if (sa->elementKind == Heap::ArrayData::PackedInt32 && searchValue->isInteger()) {
+                const int needle = searchValue->int_32();
+                for (; idx < len; ++idx) {
+                    if (sa->data(idx).int_32() == needle)
+                        return Encode(idx);
+                }
+            } else {
+                const double needle = searchValue->asDouble();
+                for (; idx < len; ++idx) {
+                    if (sa->data(idx).asDouble() == needle)
+                        return Encode(idx);
+                }
+            }
+            return Encode(-1);
+        }
         while (idx < len) {
             value = sa->data(idx);
             CHECK_EXCEPTION();
@@ -1309,6 +1344,7 @@ ReturnedValue ArrayPrototype::method_map(const FunctionObject *b, const Value *t
         return scope.engine->throwRangeError(QString::fromLatin1("Array length out of range."));
 
     ScopedArrayObject a(scope, scope.engine->newArrayObject());
+    a->arrayCreate();
     a->arrayReserve(len);
     a->setArrayLengthUnchecked(len);
 
@@ -1316,12 +1352,19 @@ ReturnedValue ArrayPrototype::method_map(const FunctionObject *b, const Value *t
     ScopedValue mapped(scope);
     ScopedValue that(scope, argc > 1 ? argv[1] : Value::undefinedValue());
     Value *arguments = scope.alloc(3);
+    const bool maybePacked = instance->isArrayObject();
 
     for (uint k = 0; k < len; ++k) {
-        bool exists;
-        arguments[0] = instance->get(k, &exists);
-        if (!exists)
-            continue;
+        // The callback may modify the array, so check every time
+        Heap::ArrayData *ad = instance->d()->arrayData;
+        if (maybePacked && ad && ad->isPacked() && k < ad->values.size) {
+            arguments[0] = static_cast<Heap::SimpleArrayData *>(ad)->data(k);
+        } else {
+            bool exists;
+            arguments[0] = instance->get(k, &exists);
+            if (!exists)
+                continue;
+        }
 
         arguments[1] = Value::fromDouble(k);
         arguments[2] = instance;
@@ -9,6 +9,7 @@
 #include <QtCore/qdatetime.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qresource.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -63,7 +64,9 @@ CompiledData::Unit *CompilationUnitMapper::get(
         return nullptr;
     }
 
-    CompiledData::Unit *data = open(cacheFilePath, sourceTimeStamp, errorString);
+    CompiledData::Unit *data = cacheFilePath.startsWith(QLatin1Char(':'))
+            ? openResource(cacheFilePath, sourceTimeStamp, errorString)
+            : open(cacheFilePath, sourceTimeStamp, errorString);
     if (data && (data->flags & CompiledData::Unit::StaticData)) {
         cache.set(cacheFilePath, *this);
         return data;
@@ -73,6 +76,59 @@ CompiledData::Unit *CompilationUnitMapper::get(
     }
 }
 
+CompiledData::Unit *CompilationUnitMapper::openResource(
+        const QString &cacheFilePath, const QDateTime &sourceTimeStamp, QString *errorString)
+{
+    close();
+
+    // Uncompressed resources live in the read-only data of the binary that embeds them. Like a
+    // mapped cache file, they can be used in place, without copying.
+    const QResource resource(cacheFilePath);
+    if (!resource.isValid()) {
+        *errorString = QStringLiteral("Resource does not exist");
+        return nullptr;
+    }
+
+    if (resource.compressionAlgorithm() != QResource::NoCompression) {
+        *errorString = QStringLiteral("Resource is compressed");
+        return nullptr;
+    }
+
+    const uchar *resourceData = resource.data();
+    const qint64 size = resource.size();
+    if (size < qint64(sizeof(CompiledData::Unit))) {
+        *errorString = QStringLiteral("File too small for the header fields");
+        return nullptr;
+    }
+
+    if (quintptr(resourceData) % alignof(CompiledData::Unit) != 0) {
+        *errorString = QStringLiteral("Resource data is not suitably aligned");
+        return nullptr;
+    }
+
+    auto *unit = reinterpret_cast<const CompiledData::Unit *>(resourceData);
+    if (!ExecutableCompilationUnit::verifyHeader(unit, sourceTimeStamp, errorString))
+        return nullptr;
+
+    if (size < qint64(unit->unitSize)) {
+        *errorString = QStringLiteral("Potential file corruption, file too small");
+        return nullptr;
+    }
+
+    // close() never unmaps StaticData units. Anything else would be passed to munmap() or
+    // UnmapViewOfFile(), which must not happen to resource memory.
+    if (!(unit->flags & CompiledData::Unit::StaticData)) {
+        *errorString = QStringLiteral("Resource does not contain static data");
+        return nullptr;
+    }
+
+    dataPtr = const_cast<uchar *>(resourceData);
+#if defined(Q_OS_UNIX)
+    length = size_t(size);
+#endif
+    return reinterpret_cast<CompiledData::Unit *>(dataPtr);
+}
+
 void CompilationUnitMapper::invalidate(const QString &cacheFilePath)
 {
     StaticUnitCache cache;
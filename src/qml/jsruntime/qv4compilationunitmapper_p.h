@@ -36,6 +36,8 @@ public:
 private:
     CompiledData::Unit *open(
             const QString &cacheFilePath, const QDateTime &sourceTimeStamp, QString *errorString);
+    CompiledData::Unit *openResource(
+            const QString &cacheFilePath, const QDateTime &sourceTimeStamp, QString *errorString);
     void close();
 
 #if defined(Q_OS_UNIX)
@@ -44,6 +44,7 @@
 #include <qv4argumentsobject_p.h>
 #include <qv4dateobject_p.h>
 #include <qv4jsonobject_p.h>
+#include <qv4lookup_p.h>
 #include <qv4stringobject_p.h>
 #include <qv4identifiertable_p.h>
 #include "qv4debugging_p.h"
@@ -108,6 +109,7 @@ using namespace QV4;
 static QBasicAtomicInt engineSerial = Q_BASIC_ATOMIC_INITIALIZER(1);
 int ExecutionEngine::s_maxCallDepth = -1;
 int ExecutionEngine::s_jitCallCountThreshold = 3;
+int ExecutionEngine::s_jitOptimizeThreshold = 1000;
 int ExecutionEngine::s_maxJSStackSize = 4 * 1024 * 1024;
 int ExecutionEngine::s_maxGCStackSize = 2 * 1024 * 1024;
 
@@ -316,6 +318,21 @@ void ExecutionEngine::initializeStaticMembers()
     if (qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER"))
         s_jitCallCountThreshold = std::numeric_limits<int>::max();
 
+    ok = false;
+    s_jitOptimizeThreshold = qEnvironmentVariableIntValue("QV4_JIT_OPTIMIZE_THRESHOLD", &ok);
+    if (!ok || s_jitOptimizeThreshold < 0)
+        s_jitOptimizeThreshold = 1000;
+    if (s_jitCallCountThreshold == std::numeric_limits<int>::max())
+        s_jitOptimizeThreshold = std::numeric_limits<int>::max();
+
+    // The baseline JIT stores into call context locals without going through the write
+    // barrier, which the incremental and the generational garbage collectors rely on.
+    if (!qEnvironmentVariableIsEmpty("QV4_MM_INCREMENTAL_GC")
+            || !qEnvironmentVariableIsEmpty("QV4_MM_GENERATIONAL_GC")) {
+        s_jitCallCountThreshold = std::numeric_limits<int>::max();
+        s_jitOptimizeThreshold = std::numeric_limits<int>::max();
+    }
+
     qMetaTypeId<QJSValue>();
     qMetaTypeId<QList<int> >();
 
@@ -865,6 +882,7 @@ ExecutionEngine::~ExecutionEngine()
 
     delete bumperPointerAllocator;
     delete regExpCache;
+    delete megamorphicLookupCache;
     delete regExpAllocator;
     delete executableAllocator;
     jsStack->deallocate();
@@ -986,6 +1004,7 @@ Heap::ArrayObject *ExecutionEngine::newArrayObject(const Value *values, int leng
         d->offset = 0;
         d->values.alloc = length;
         d->values.size = length;
+        d->elementKind = Heap::ArrayData::elementKindOf(values, length);
         // this doesn't require a write barrier, things will be ok, when the new array data gets inserted into
         // the parent object
         memcpy(&d->values.values, values, length*sizeof(Value));
@@ -492,6 +492,7 @@ public:
     quint32 m_engineId;
 
     RegExpCache *regExpCache;
+    MegamorphicLookupCache *megamorphicLookupCache = nullptr;
 
     // Scarce resources are "exceptionally high cost" QVariant types where allowing the
     // normal JavaScript GC to clean them up is likely to lead to out-of-memory or other
@@ -697,6 +698,18 @@ public:
 #endif
     }
 
+    bool canOptimize(Function *f)
+    {
+#if ENABLE_OPTIMIZING_JIT
+        return f->jittedCode != nullptr
+                && !f->optimized
+                && f->jittedCallCount >= s_jitOptimizeThreshold;
+#else
+        Q_UNUSED(f);
+        return false;
+#endif
+    }
+
     QV4::ReturnedValue global();
     void initQmlGlobalObject();
     void initializeGlobal();
@@ -834,6 +847,7 @@ private:
 
     static int s_maxCallDepth;
     static int s_jitCallCountThreshold;
+    static int s_jitOptimizeThreshold;
     static int s_maxJSStackSize;
     static int s_maxGCStackSize;
 
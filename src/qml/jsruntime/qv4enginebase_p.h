@@ -45,7 +45,8 @@ struct Q_QML_EXPORT EngineBase {
 
     quint8 isExecutingInRegExpJIT = false;
     quint8 isInitialized = false;
-    quint8 padding[2];
+    quint8 isGCOngoing = false; // incremental marking in progress, see WriteBarrier
+    quint8 isGenerationalGC = false; // old-to-young stores are remembered, see WriteBarrier
     MemoryManager *memoryManager = nullptr;
 
     union {
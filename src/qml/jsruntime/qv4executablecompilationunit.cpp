@@ -111,11 +111,9 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
 
     Q_ASSERT(!runtimeStrings);
     Q_ASSERT(data);
-    const quint32 stringCount = totalStringCount();
-    // strings need to be 0 in case a GC run happens while we're within the loop below
-    runtimeStrings = (QV4::Heap::String **)calloc(stringCount, sizeof(QV4::Heap::String*));
-    for (uint i = 0; i < stringCount; ++i)
-        runtimeStrings[i] = engine->newString(stringAt(i));
+    // The strings are created on first use, see runtimeString(). Most units only ever need
+    // a fraction of them.
+    runtimeStrings = (QV4::Heap::String **)calloc(totalStringCount(), sizeof(QV4::Heap::String*));
 
     // zero-initialize regexps in case a GC run happens while we're within the loop below
     runtimeRegularExpressions
@@ -128,28 +126,6 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
                 engine, stringAt(re->stringIndex()), flags);
     }
 
-    if (data->lookupTableSize) {
-        runtimeLookups = new QV4::Lookup[data->lookupTableSize];
-        memset(runtimeLookups, 0, data->lookupTableSize * sizeof(QV4::Lookup));
-        const CompiledData::Lookup *compiledLookups = data->lookupTable();
-        for (uint i = 0; i < data->lookupTableSize; ++i) {
-            QV4::Lookup *l = runtimeLookups + i;
-
-            CompiledData::Lookup::Type type
-                    = CompiledData::Lookup::Type(uint(compiledLookups[i].type()));
-            if (type == CompiledData::Lookup::Type_Getter)
-                l->getter = QV4::Lookup::getterGeneric;
-            else if (type == CompiledData::Lookup::Type_Setter)
-                l->setter = QV4::Lookup::setterGeneric;
-            else if (type == CompiledData::Lookup::Type_GlobalGetter)
-                l->globalGetter = QV4::Lookup::globalGetterGeneric;
-            else if (type == CompiledData::Lookup::Type_QmlContextPropertyGetter)
-                l->qmlContextPropertyGetter = QQmlContextWrapper::resolveQmlContextPropertyLookupGetter;
-            l->forCall = compiledLookups[i].mode() == CompiledData::Lookup::Mode_ForCall;
-            l->nameIndex = compiledLookups[i].nameIndex();
-        }
-    }
-
     if (data->jsClassTableSize) {
         // zero the regexps with calloc in case a GC run happens while we're within the loop below
         runtimeClasses
@@ -166,7 +142,7 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
                 runtimeClasses[i]
                         = runtimeClasses[i]->addMember(
                                 engine->identifierTable->asPropertyKey(
-                                        runtimeStrings[member->nameOffset()]),
+                                        runtimeString(member->nameOffset())),
                                 member->isAccessor()
                                         ? QV4::Attr_Accessor
                                         : QV4::Attr_Data);
@@ -211,7 +187,7 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
         const quint32_le *localsIndices = compiledBlock->localsTable();
         for (quint32 j = 0; j < compiledBlock->nLocals; ++j)
             ic = ic->addMember(
-                    engine->identifierTable->asPropertyKey(runtimeStrings[localsIndices[j]]),
+                    engine->identifierTable->asPropertyKey(runtimeString(localsIndices[j])),
                     Attr_NotConfigurable);
         runtimeBlocks[i] = ic->d();
     }
@@ -222,7 +198,7 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
         dumpConstantTable(constants, data->constantTableSize);
         qDebug() << "=== String table";
         for (uint i = 0, end = totalStringCount(); i < end; ++i)
-            qDebug() << "    " << i << ":" << runtimeStrings[i]->toQString();
+            qDebug() << "    " << i << ":" << runtimeString(i)->toQString();
         qDebug() << "=== Closure table";
         for (uint i = 0; i < data->functionTableSize; ++i)
             qDebug() << "    " << i << ":" << runtimeFunctions[i]->name()->toQString();
@@ -237,6 +213,42 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
         return nullptr;
 }
 
+Heap::String *ExecutableCompilationUnit::materializeRuntimeString(uint index) const
+{
+    Q_ASSERT(engine);
+    Q_ASSERT(index < totalStringCount());
+    Heap::String *string = engine->newString(stringAt(index));
+    runtimeStrings[index] = string;
+    return string;
+}
+
+void ExecutableCompilationUnit::materializeRuntimeLookups()
+{
+    Q_ASSERT(engine);
+    Q_ASSERT(!runtimeLookups);
+    Q_ASSERT(data->lookupTableSize);
+
+    runtimeLookups = new QV4::Lookup[data->lookupTableSize];
+    memset(runtimeLookups, 0, data->lookupTableSize * sizeof(QV4::Lookup));
+    const CompiledData::Lookup *compiledLookups = data->lookupTable();
+    for (uint i = 0; i < data->lookupTableSize; ++i) {
+        QV4::Lookup *l = runtimeLookups + i;
+
+        CompiledData::Lookup::Type type
+                = CompiledData::Lookup::Type(uint(compiledLookups[i].type()));
+        if (type == CompiledData::Lookup::Type_Getter)
+            l->getter = QV4::Lookup::getterGeneric;
+        else if (type == CompiledData::Lookup::Type_Setter)
+            l->setter = QV4::Lookup::setterGeneric;
+        else if (type == CompiledData::Lookup::Type_GlobalGetter)
+            l->globalGetter = QV4::Lookup::globalGetterGeneric;
+        else if (type == CompiledData::Lookup::Type_QmlContextPropertyGetter)
+            l->qmlContextPropertyGetter = QQmlContextWrapper::resolveQmlContextPropertyLookupGetter;
+        l->forCall = compiledLookups[i].mode() == CompiledData::Lookup::Mode_ForCall;
+        l->nameIndex = compiledLookups[i].nameIndex();
+    }
+}
+
 Heap::Object *ExecutableCompilationUnit::templateObjectAt(int index) const
 {
     Q_ASSERT(index < int(data->templateObjectTableSize));
@@ -253,9 +265,9 @@ Heap::Object *ExecutableCompilationUnit::templateObjectAt(int index) const
     Scoped<ArrayObject> raw(scope, engine->newArrayObject(t->size));
     ScopedValue s(scope);
     for (uint i = 0; i < t->size; ++i) {
-        s = runtimeStrings[t->stringIndexAt(i)];
+        s = runtimeString(t->stringIndexAt(i));
         a->arraySet(i, s);
-        s = runtimeStrings[t->rawStringIndexAt(i)];
+        s = runtimeString(t->rawStringIndexAt(i));
         raw->arraySet(i, s);
     }
 
@@ -279,8 +291,10 @@ void ExecutableCompilationUnit::unlink()
         ic.qmlType = QQmlType();
 
     if (runtimeLookups) {
-        for (uint i = 0; i < data->lookupTableSize; ++i)
+        for (uint i = 0; i < data->lookupTableSize; ++i) {
             runtimeLookups[i].releasePropertyCache();
+            runtimeLookups[i].releasePolymorphicCache();
+        }
     }
 
     dependentScripts.clear();
@@ -350,7 +364,7 @@ IdentifierHash ExecutableCompilationUnit::createNamedObjectsPerComponent(int com
     const quint32_le *namedObjectIndexPtr = component->namedObjectsInComponentTable();
     for (quint32 i = 0; i < component->nNamedObjectsInComponent; ++i, ++namedObjectIndexPtr) {
         const CompiledData::Object *namedObject = objectAt(*namedObjectIndexPtr);
-        namedObjectCache.add(runtimeStrings[namedObject->idNameIndex], namedObject->objectId());
+        namedObjectCache.add(runtimeString(namedObject->idNameIndex), namedObject->objectId());
     }
     Q_ASSERT(!namedObjectCache.isEmpty());
     return *namedObjectsPerComponentCache.insert(componentObjectIndex, namedObjectCache);
@@ -583,7 +597,7 @@ Heap::Module *ExecutableCompilationUnit::instantiate(ExecutionEngine *engine)
     for (uint i = 0; i < importCount; ++i) {
         const CompiledData::ImportEntry &entry = data->importEntryTable()[i];
         QUrl url = urlAt(entry.moduleRequest);
-        importName = runtimeStrings[entry.importName];
+        importName = runtimeString(entry.importName);
 
         const auto module = engine->loadModule(url, this);
         if (module.compiled) {
@@ -649,7 +663,7 @@ Heap::Module *ExecutableCompilationUnit::instantiate(ExecutionEngine *engine)
     for (uint i = 0; i < data->indirectExportEntryTableSize; ++i) {
         const CompiledData::ExportEntry &entry = data->indirectExportEntryTable()[i];
         auto dependentModule = engine->loadModule(urlAt(entry.moduleRequest), this);
-        ScopedString importName(scope, runtimeStrings[entry.importName]);
+        ScopedString importName(scope, runtimeString(entry.importName));
         if (const auto dependentModuleUnit = dependentModule.compiled) {
             if (!dependentModuleUnit->resolveExport(importName)) {
                 throwReferenceError(entry, importName->toQString());
@@ -688,7 +702,7 @@ const Value *ExecutableCompilationUnit::resolveExportRecursively(
 
     if (auto localExport = lookupNameInExportTable(
                 data->localExportEntryTable(), data->localExportEntryTableSize, exportName)) {
-        ScopedString localName(scope, runtimeStrings[localExport->localName]);
+        ScopedString localName(scope, runtimeString(localExport->localName));
         uint index = module()->scope->internalClass->indexOfValueOrGetter(localName->toPropertyKey());
         if (index == UINT_MAX)
             return nullptr;
@@ -701,7 +715,7 @@ const Value *ExecutableCompilationUnit::resolveExportRecursively(
                 data->indirectExportEntryTable(), data->indirectExportEntryTableSize, exportName)) {
         QUrl request = urlAt(indirectExport->moduleRequest);
         auto dependentModule = engine->loadModule(request, this);
-        ScopedString importName(scope, runtimeStrings[indirectExport->importName]);
+        ScopedString importName(scope, runtimeString(indirectExport->importName));
         if (dependentModule.compiled) {
             return dependentModule.compiled->resolveExportRecursively(importName, resolveSet);
         } else if (dependentModule.native) {
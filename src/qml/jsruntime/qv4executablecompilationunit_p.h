@@ -56,6 +56,9 @@ namespace QV4 {
 
 // index is per-object binding index
 typedef QVector<const QQmlPropertyData *> BindingPropertyData;
+typedef QVector<QVariant> BindingLiteralValues;
+// index is the object's own property index
+typedef QVector<QVariant> PropertyLiteralDefaults;
 
 class CompilationUnitMapper;
 class ResolvedTypeReference;
@@ -107,6 +110,7 @@ public:
         return m_finalUrl;
     }
 
+    // Created on first use, through runtimeLookup().
     QV4::Lookup *runtimeLookups = nullptr;
     QVector<QV4::Function *> runtimeFunctions;
     QVector<QV4::Heap::InternalClass *> runtimeBlocks;
@@ -125,6 +129,16 @@ public:
     // lookups by string (property name).
     QVector<BindingPropertyData> bindingPropertyDataPerObject;
 
+    // index is object index. Holds the values of literal bindings that have to be converted
+    // to the type of their property, such as colors, points or URLs. These are decoded once,
+    // by the type loader, rather than every time an object is created.
+    QVector<BindingLiteralValues> bindingLiteralValuesPerObject;
+
+    // index is object index. Holds the literal values that the int, bool, real and string
+    // properties declared by an object are initialized with. QQmlVMEMetaObject serves them
+    // until it has to allocate storage for the properties.
+    QVector<PropertyLiteralDefaults> propertyLiteralDefaultsPerObject;
+
     // mapping from component object index (CompiledData::Unit object index that points to component) to identifier hash of named objects
     // this is initialized on-demand by QQmlContextData
     QHash<int, IdentifierHash> namedObjectsPerComponentCache;
@@ -234,6 +248,14 @@ public:
 
     Heap::Object *templateObjectAt(int index) const;
 
+    Heap::String *runtimeString(uint index) const
+    {
+        Heap::String *string = runtimeStrings[index];
+        return Q_LIKELY(string) ? string : materializeRuntimeString(index);
+    }
+
+    inline QV4::Lookup *runtimeLookup(uint index); // defined in qv4lookup_p.h
+
     struct FunctionIterator
     {
         FunctionIterator(const CompiledData::Unit *unit, const CompiledObject *object, int index)
@@ -340,6 +362,8 @@ private:
     QUrl urlAt(int index) const { return QUrl(stringAt(index)); }
 
     Q_NEVER_INLINE IdentifierHash createNamedObjectsPerComponent(int componentObjectIndex);
+    Q_NEVER_INLINE Heap::String *materializeRuntimeString(uint index) const;
+    Q_NEVER_INLINE void materializeRuntimeLookups();
     const CompiledData::ExportEntry *lookupNameInExportTable(
             const CompiledData::ExportEntry *firstExportEntry, int tableSize,
             QV4::String *name) const;
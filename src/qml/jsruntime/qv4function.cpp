@@ -114,13 +114,13 @@ Function::Function(ExecutionEngine *engine, ExecutableCompilationUnit *unit,
     // first locals
     const quint32_le *localsIndices = compiledFunction->localsTable();
     for (quint32 i = 0; i < compiledFunction->nLocals; ++i)
-        ic = ic->addMember(engine->identifierTable->asPropertyKey(compilationUnit->runtimeStrings[localsIndices[i]]), Attr_NotConfigurable);
+        ic = ic->addMember(engine->identifierTable->asPropertyKey(runtimeString(localsIndices[i])), Attr_NotConfigurable);
 
     const CompiledData::Parameter *formalsIndices = compiledFunction->formalsTable();
     bool enforceJsTypes = !aotFunction && !unit->ignoresFunctionSignature();
 
     for (quint32 i = 0; i < compiledFunction->nFormals; ++i) {
-        ic = ic->addMember(engine->identifierTable->asPropertyKey(compilationUnit->runtimeStrings[formalsIndices[i].nameIndex]), Attr_NotConfigurable);
+        ic = ic->addMember(engine->identifierTable->asPropertyKey(runtimeString(formalsIndices[i].nameIndex)), Attr_NotConfigurable);
         if (enforceJsTypes && !isSpecificType(formalsIndices[i].type))
             enforceJsTypes = false;
     }
@@ -174,6 +174,10 @@ Function::~Function()
         destroyFunctionTable(this, codeRef);
         delete codeRef;
     }
+    if (baselineCodeRef) {
+        destroyFunctionTable(this, baselineCodeRef);
+        delete baselineCodeRef;
+    }
     if (kind == JsTyped)
         delete jsTypedFunction;
 }
@@ -212,7 +216,7 @@ void Function::updateInternalClass(ExecutionEngine *engine, const QList<QByteArr
     const quint32_le *localsIndices = compiledFunction->localsTable();
     for (quint32 i = 0; i < compiledFunction->nLocals; ++i) {
         internalClass = internalClass->addMember(
-                engine->identifierTable->asPropertyKey(compilationUnit->runtimeStrings[localsIndices[i]]),
+                engine->identifierTable->asPropertyKey(runtimeString(localsIndices[i])),
                 Attr_NotConfigurable);
     }
 
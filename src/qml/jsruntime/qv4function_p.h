@@ -66,7 +66,7 @@ public:
 
     QV4::Heap::String *runtimeString(uint i) const
     {
-        return compilationUnit->runtimeStrings[i];
+        return executableCompilationUnit()->runtimeString(i);
     }
 
     bool call(QObject *thisObject, void **a, const QMetaType *types, int argc,
@@ -79,6 +79,16 @@ public:
     typedef ReturnedValue (*JittedCode)(CppStackFrame *, ExecutionEngine *);
     JittedCode jittedCode;
     JSC::MacroAssemblerCodeRef *codeRef;
+
+    // When the optimizing JIT replaces the baseline code, the baseline code is kept here.
+    // Frames that deoptimize, or are still running the old code, may need it.
+    JittedCode baselineJittedCode = nullptr;
+    JSC::MacroAssemblerCodeRef *baselineCodeRef = nullptr;
+
+    // Per arithmetic and comparison site, in bytecode order. Filled in by the slow paths of
+    // the baseline JIT and consumed by the optimizing JIT.
+    enum TypeFeedback : quint8 { SawDouble = 0x1, SawOther = 0x2 };
+    QByteArray typeFeedback;
     union {
         const QQmlPrivate::AOTCompiledFunction *aotCompiledFunction = nullptr;
         const JSTypedFunction *jsTypedFunction;
@@ -87,10 +97,13 @@ public:
     // first nArguments names in internalClass are the actual arguments
     Heap::InternalClass *internalClass;
     int interpreterCallCount = 0;
+    int jittedCallCount = 0;
     quint16 nFormals;
+    quint16 deoptimizationCount = 0;
     enum Kind : quint8 { JsUntyped, JsTyped, AotCompiled, Eval };
     Kind kind = JsUntyped;
     bool detectedInjectedParameters = false;
+    bool optimized = false; // the optimizing JIT has run, successfully or not
 
     static Function *create(ExecutionEngine *engine, ExecutableCompilationUnit *unit,
                             const CompiledData::Function *function,
@@ -55,6 +55,21 @@ Heap::FunctionObject *GeneratorFunction::create(ExecutionContext *context, Funct
     return g->d();
 }
 
+// The interpreter writes the registers and the accumulator of a generator's frame without the
+// write barrier. While the generator is executing, the memory manager scans its frame as a root.
+// Once it is suspended, the barrier is applied to everything that has been left in the frame. In
+// generational mode, this puts young values left in an old frame into the remembered set.
+static void frameWriteBarrier(ExecutionEngine *engine, Heap::GeneratorObject *gp)
+{
+    if (Q_LIKELY(!WriteBarrier::isActive(engine)))
+        return;
+
+    Heap::Base *frame = gp->jsFrame->arrayData;
+    const Value *v = reinterpret_cast<const Value *>(gp->cppFrame.jsFrame);
+    for (const Value *end = v + gp->cppFrame.requiredJSStackFrameSize(); v < end; ++v)
+        WriteBarrier::barrier(engine, frame, v->asReturnedValue());
+}
+
 ReturnedValue GeneratorFunction::virtualCall(const FunctionObject *f, const Value *thisObject, const Value *argv, int argc)
 {
     const GeneratorFunction *gf = static_cast<const GeneratorFunction *>(f);
@@ -84,6 +99,7 @@ ReturnedValue GeneratorFunction::virtualCall(const FunctionObject *f, const Valu
 
     Moth::VME::interpret(&gp->cppFrame, engine, function->codeData);
     gp->state = GeneratorState::SuspendedStart;
+    frameWriteBarrier(engine, gp);
 
     gp->cppFrame.pop(engine);
     return g->asReturnedValue();
@@ -192,6 +208,7 @@ ReturnedValue GeneratorObject::resume(ExecutionEngine *engine, const Value &arg)
     ScopedValue result(scope, Moth::VME::interpret(&gp->cppFrame, engine, code));
 
     engine->currentStackFrame = gp->cppFrame.parentFrame();
+    frameWriteBarrier(engine, gp);
 
     bool done = (gp->cppFrame.yield() == nullptr);
     gp->state = done ? GeneratorState::Completed : GeneratorState::SuspendedYield;
@@ -28,10 +28,16 @@
 #define ENABLE_YARR_JIT 1
 #define ENABLE_JIT 1
 #define ENABLE_ASSEMBLER 1
+#if defined(Q_PROCESSOR_X86_64) && defined(Q_OS_LINUX)
+#define ENABLE_OPTIMIZING_JIT 1
+#else
+#define ENABLE_OPTIMIZING_JIT 0
+#endif
 #else
 #define ENABLE_YARR_JIT 0
 #define ENABLE_ASSEMBLER 0
 #define ENABLE_JIT 0
+#define ENABLE_OPTIMIZING_JIT 0
 #endif
 
 #if defined(Q_OS_QNX) && defined(_CPPLIB_VER)
@@ -125,6 +131,7 @@ struct Value;
 template<size_t> struct HeapValue;
 template<size_t> struct ValueArray;
 struct Lookup;
+struct MegamorphicLookupCache;
 struct ArrayData;
 struct VTable;
 struct Function;
@@ -9,6 +9,14 @@ QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
+// The table holds its entries weakly. Entries handed out while an incremental mark phase is in
+// progress may end up in places the write barrier does not see, so keep them alive.
+inline void IdentifierTable::shadeDuringGC(Heap::StringOrSymbol *e)
+{
+    if (Q_UNLIKELY(engine->isGCOngoing))
+        WriteBarrier::shade(engine, e);
+}
+
 IdentifierTable::IdentifierTable(ExecutionEngine *engine, int numBits)
     : engine(engine)
     , size(0)
@@ -115,8 +123,10 @@ Heap::String *IdentifierTable::resolveStringEntry(const QString &s, uint hash, u
 {
     uint idx = hash % alloc;
     while (Heap::StringOrSymbol *e = entriesByHash[idx]) {
-        if (e->stringHash == hash && e->toQString() == s)
+        if (e->stringHash == hash && e->toQString() == s) {
+            shadeDuringGC(e);
             return static_cast<Heap::String *>(e);
+        }
         ++idx;
         idx %= alloc;
     }
@@ -136,8 +146,10 @@ Heap::Symbol *IdentifierTable::insertSymbol(const QString &s)
     uint hash = String::createHashValue(s.constData(), s.size(), &subtype);
     uint idx = hash % alloc;
     while (Heap::StringOrSymbol *e = entriesByHash[idx]) {
-        if (e->stringHash == hash && e->toQString() == s)
+        if (e->stringHash == hash && e->toQString() == s) {
+            shadeDuringGC(e);
             return static_cast<Heap::Symbol *>(e);
+        }
         ++idx;
         idx %= alloc;
     }
@@ -164,6 +176,7 @@ PropertyKey IdentifierTable::asPropertyKeyImpl(const Heap::String *str)
     uint idx = hash % alloc;
     while (Heap::StringOrSymbol *e = entriesByHash[idx]) {
         if (e->stringHash == hash && e->toQString() == str->toQString()) {
+            shadeDuringGC(e);
             str->identifier = e->identifier;
             return e->identifier;
         }
@@ -76,6 +76,7 @@ public:
 
 private:
     Heap::String *resolveStringEntry(const QString &s, uint hash, uint subtype);
+    void shadeDuringGC(Heap::StringOrSymbol *e);
 };
 
 }
@@ -19,25 +19,50 @@ PropertyHashData::PropertyHashData(int numBits)
     , size(0)
     , numBits(numBits)
 {
-    alloc = qPrimeForNumBits(numBits);
-    entries = (PropertyHash::Entry *)malloc(alloc*sizeof(PropertyHash::Entry));
+    alloc = 1 << numBits;
+    const size_t controlSize = alloc + PropertyHashGroup::Width;
+    entries = (PropertyHash::Entry *)malloc(alloc*sizeof(PropertyHash::Entry) + controlSize);
     memset(entries, 0, alloc*sizeof(PropertyHash::Entry));
+    control = reinterpret_cast<uchar *>(entries + alloc);
+    memset(control, PropertyHash::Empty, controlSize);
+}
+
+void PropertyHashData::setControl(uint idx, uchar value)
+{
+    control[idx] = value;
+
+    // Keep the copy behind the end in sync. Tables smaller than a group are copied repeatedly.
+    for (uint copy = idx; copy < uint(PropertyHashGroup::Width); copy += alloc)
+        control[alloc + copy] = value;
+}
+
+void PropertyHashData::insert(const PropertyHash::Entry &entry)
+{
+    const quint64 h = PropertyHash::hash(entry.identifier);
+    const uint mask = uint(alloc) - 1;
+    uint pos = uint(h >> 7) & mask;
+    uint step = 0;
+    while (1) {
+        if (const PropertyHashGroup::Mask empty = PropertyHashGroup::matchEmpty(control + pos)) {
+            const uint idx = (pos + PropertyHashGroup::firstIndex(empty)) & mask;
+            entries[idx] = entry;
+            setControl(idx, uchar(h & 0x7f));
+            return;
+        }
+        step += PropertyHashGroup::Width;
+        pos = (pos + step) & mask;
+    }
 }
 
 void PropertyHash::addEntry(const PropertyHash::Entry &entry, int classSize)
 {
-    // fill up to max 50%
-    bool grow = (d->alloc <= d->size*2);
+    // fill up to max 7/8, there always has to be an empty slot to terminate lookups
+    bool grow = (d->alloc - d->alloc / 8 <= d->size + 1);
 
     if (classSize < d->size || grow)
         detach(grow, classSize);
 
-    uint idx = entry.identifier.id() % d->alloc;
-    while (d->entries[idx].identifier.isValid()) {
-        ++idx;
-        idx %= d->alloc;
-    }
-    d->entries[idx] = entry;
+    d->insert(entry);
     ++d->size;
 }
 
@@ -49,14 +74,9 @@ void PropertyHash::detach(bool grow, int classSize)
     PropertyHashData *dd = new PropertyHashData(grow ? d->numBits + 1 : d->numBits);
     for (int i = 0; i < d->alloc; ++i) {
         const Entry &e = d->entries[i];
-        if (!e.identifier.isValid() || e.index >= static_cast<unsigned>(classSize))
+        if (d->control[i] == Empty || e.index >= static_cast<unsigned>(classSize))
             continue;
-        uint idx = e.identifier.id() % dd->alloc;
-        while (dd->entries[idx].identifier.isValid()) {
-            ++idx;
-            idx %= dd->alloc;
-        }
-        dd->entries[idx] = e;
+        dd->insert(e);
     }
     dd->size = classSize;
     if (!--d->refCount)
@@ -64,6 +84,12 @@ void PropertyHash::detach(bool grow, int classSize)
     d = dd;
 }
 
+// The member data is held by internal classes, which are old right away in generational mode.
+static void rememberNameMapData(ExecutionEngine *engine, Heap::MemberData *data)
+{
+    if (Q_UNLIKELY(engine->isGenerationalGC))
+        WriteBarrier::remember(engine, nullptr, data);
+}
 
 SharedInternalClassDataPrivate<PropertyKey>::SharedInternalClassDataPrivate(const SharedInternalClassDataPrivate<PropertyKey> &other)
     : refcount(1),
@@ -73,6 +99,7 @@ SharedInternalClassDataPrivate<PropertyKey>::SharedInternalClassDataPrivate(cons
     if (other.alloc()) {
         const uint s = other.size();
         data = MemberData::allocate(engine, other.alloc(), other.data);
+        rememberNameMapData(engine, data);
         setSize(s);
     }
 }
@@ -83,6 +110,7 @@ SharedInternalClassDataPrivate<PropertyKey>::SharedInternalClassDataPrivate(cons
       engine(other.engine)
 {
     data = MemberData::allocate(engine, other.alloc(), nullptr);
+    rememberNameMapData(engine, data);
     memcpy(data, other.data, sizeof(Heap::MemberData) - sizeof(Value) + pos*sizeof(Value));
     data->values.size = pos + 1;
     data->values.set(engine, pos, Value::fromReturnedValue(value.id()));
@@ -93,6 +121,7 @@ void SharedInternalClassDataPrivate<PropertyKey>::grow()
     const uint a = alloc() * 2;
     const uint s = size();
     data = MemberData::allocate(engine, a, data);
+    rememberNameMapData(engine, data);
     setSize(s);
     Q_ASSERT(alloc() >= a);
 }
@@ -123,6 +152,10 @@ void SharedInternalClassDataPrivate<PropertyKey>::set(uint i, PropertyKey t)
 {
     Q_ASSERT(data && i < size());
     data->values.values[i].rawValueRef() = t.id();
+    if (Q_UNLIKELY(WriteBarrier::isActive(engine))) {
+        if (Heap::StringOrSymbol *key = t.asStringOrSymbol())
+            WriteBarrier::barrier(engine, data, key);
+    }
 }
 
 void SharedInternalClassDataPrivate<PropertyKey>::mark(MarkStack *s)
@@ -258,7 +291,9 @@ void InternalClass::init(Heap::InternalClass *other)
     internalClass.set(engine, other->internalClass);
 }
 
-void InternalClass::destroy()
+// Detaches an unmarked internal class from its parent and children, so that it cannot be found
+// through transitions anymore. The class itself stays valid until it is destroyed.
+void InternalClass::unlinkFromTransitions()
 {
     for (const auto &t : transitions) {
         if (t.lookup) {
@@ -268,9 +303,16 @@ void InternalClass::destroy()
             t.lookup->parent = nullptr;
         }
     }
+    transitions.clear();
 
     if (parent && parent->engine && parent->isMarked())
         parent->removeChildEntry(this);
+    parent = nullptr;
+}
+
+void InternalClass::destroy()
+{
+    unlinkFromTransitions();
 
     propertyTable.~PropertyHash();
     nameMap.~SharedInternalClassData<PropertyKey>();
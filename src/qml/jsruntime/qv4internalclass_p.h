@@ -18,6 +18,9 @@
 
 #include <QHash>
 #include <QVarLengthArray>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qendian.h>
+#include <QtCore/private/qsimd_p.h>
 #include <climits> // for UINT_MAX
 #include <private/qv4propertykey_p.h>
 #include <private/qv4heap_p.h>
@@ -36,6 +39,66 @@ struct InternalClassEntry {
     bool isValid() const { return !attributes.isEmpty(); }
 };
 
+// The property hash is an open addressed table in the style of a Swiss table: next to the
+// entries there is an array of control bytes, one per entry, holding either Empty or 7 bits of
+// the key's hash. A lookup compares a whole group of control bytes at once, and only looks at
+// the entries whose control byte matches. Entries are never removed.
+namespace PropertyHashGroup {
+#if defined(__SSE2__)
+enum { Width = 16, Shift = 0 };
+typedef uint Mask;
+
+inline Mask match(const uchar *control, uchar h2)
+{
+    const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(control));
+    return uint(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(char(h2)), group)));
+}
+
+inline Mask matchEmpty(const uchar *control)
+{
+    // Only Empty has the high bit set.
+    return uint(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control))));
+}
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+enum { Width = 8, Shift = 3 };
+typedef quint64 Mask;
+
+inline Mask match(const uchar *control, uchar h2)
+{
+    const uint8x8_t equal = vceq_u8(vld1_u8(control), vdup_n_u8(h2));
+    return vget_lane_u64(vreinterpret_u64_u8(equal), 0) & Q_UINT64_C(0x8080808080808080);
+}
+
+inline Mask matchEmpty(const uchar *control)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vld1_u8(control)), 0)
+            & Q_UINT64_C(0x8080808080808080);
+}
+#else
+enum { Width = 8, Shift = 3 };
+typedef quint64 Mask;
+
+inline Mask match(const uchar *control, uchar h2)
+{
+    // May report false positives, which the key comparison filters out.
+    constexpr quint64 lsbs = Q_UINT64_C(0x0101010101010101);
+    constexpr quint64 msbs = Q_UINT64_C(0x8080808080808080);
+    const quint64 x = qFromLittleEndian<quint64>(control) ^ (lsbs * h2);
+    return (x - lsbs) & ~x & msbs;
+}
+
+inline Mask matchEmpty(const uchar *control)
+{
+    return qFromLittleEndian<quint64>(control) & Q_UINT64_C(0x8080808080808080);
+}
+#endif
+
+inline uint firstIndex(Mask mask)
+{
+    return uint(qCountTrailingZeroBits(mask)) >> Shift;
+}
+}
+
 struct PropertyHashData;
 struct PropertyHash
 {
@@ -45,6 +108,8 @@ struct PropertyHash
         uint setterIndex;
     };
 
+    enum : uchar { Empty = 0x80 };
+
     PropertyHashData *d;
 
     inline PropertyHash();
@@ -55,6 +120,13 @@ struct PropertyHash
     void addEntry(const Entry &entry, int classSize);
     Entry *lookup(PropertyKey identifier) const;
     void detach(bool grow, int classSize);
+
+    static quint64 hash(PropertyKey identifier)
+    {
+        // String and symbol keys are heap pointers, so the low bits carry little information.
+        const quint64 h = identifier.id() * Q_UINT64_C(0x9e3779b97f4a7c15);
+        return h ^ (h >> 32);
+    }
 };
 
 struct PropertyHashData
@@ -64,11 +136,17 @@ struct PropertyHashData
         free(entries);
     }
 
+    void insert(const PropertyHash::Entry &entry);
+    void setControl(uint idx, uchar value);
+
     int refCount;
     int alloc;
     int size;
     int numBits;
     PropertyHash::Entry *entries;
+    // alloc control bytes, followed by a copy of the first ones so that groups can be loaded
+    // from any position without wrapping around.
+    uchar *control;
 };
 
 inline PropertyHash::PropertyHash()
@@ -103,14 +181,22 @@ inline PropertyHash::Entry *PropertyHash::lookup(PropertyKey identifier) const
 {
     Q_ASSERT(d->entries);
 
-    uint idx = identifier.id() % d->alloc;
+    const quint64 h = hash(identifier);
+    const uchar h2 = uchar(h & 0x7f);
+    const uint mask = uint(d->alloc) - 1;
+    uint pos = uint(h >> 7) & mask;
+    uint step = 0;
     while (1) {
-        if (d->entries[idx].identifier == identifier)
-            return d->entries + idx;
-        if (!d->entries[idx].identifier.isValid())
+        const uchar *group = d->control + pos;
+        for (PropertyHashGroup::Mask m = PropertyHashGroup::match(group, h2); m; m &= m - 1) {
+            Entry *e = d->entries + ((pos + PropertyHashGroup::firstIndex(m)) & mask);
+            if (e->identifier == identifier)
+                return e;
+        }
+        if (PropertyHashGroup::matchEmpty(group))
             return nullptr;
-        ++idx;
-        idx %= d->alloc;
+        step += PropertyHashGroup::Width;
+        pos = (pos + step) & mask;
     }
 }
 
@@ -332,6 +418,7 @@ struct InternalClass : Base {
     void init(ExecutionEngine *engine);
     void init(InternalClass *other);
     void destroy();
+    void unlinkFromTransitions();
 
     Q_QML_PRIVATE_EXPORT ReturnedValue keyAt(uint index) const;
     Q_REQUIRED_RESULT InternalClass *nonExtensible();
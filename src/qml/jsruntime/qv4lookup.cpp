@@ -8,10 +8,20 @@
 #include <private/qv4runtime_p.h>
 #include <private/qv4stackframe_p.h>
 
+#include <QtCore/qloggingcategory.h>
+
 QT_BEGIN_NAMESPACE
 
+Q_LOGGING_CATEGORY(lcLookupStats, "qt.qml.lookup.statistics")
+
 using namespace QV4;
 
+MegamorphicLookupCache::~MegamorphicLookupCache()
+{
+    qCDebug(lcLookupStats) << megamorphicLookups << "megamorphic lookups," << hits << "hits,"
+                           << misses << "misses in the megamorphic lookup cache";
+}
+
 
 void Lookup::resolveProtoGetter(PropertyKey name, const Heap::Object *proto)
 {
@@ -48,7 +58,7 @@ ReturnedValue Lookup::resolvePrimitiveGetter(ExecutionEngine *engine, const Valu
     case Value::Undefined_Type:
     case Value::Null_Type: {
         Scope scope(engine);
-        ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+        ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
         const QString message = QStringLiteral("Cannot read property '%1' of %2").arg(name->toQString())
             .arg(QLatin1String(primitiveLookup.type == Value::Undefined_Type ? "undefined" : "null"));
         return engine->throwTypeError(message);
@@ -62,7 +72,7 @@ ReturnedValue Lookup::resolvePrimitiveGetter(ExecutionEngine *engine, const Valu
         primitiveLookup.proto = static_cast<const Managed &>(object).internalClass()->prototype;
         Q_ASSERT(primitiveLookup.proto);
         Scope scope(engine);
-        ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+        ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
         if (object.isString() && name->equals(engine->id_length())) {
             // special case, as the property is on the object itself
             getter = stringLengthGetter;
@@ -75,7 +85,7 @@ ReturnedValue Lookup::resolvePrimitiveGetter(ExecutionEngine *engine, const Valu
         primitiveLookup.proto = engine->numberPrototype()->d();
     }
 
-    PropertyKey name = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    PropertyKey name = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     protoLookup.protoId = primitiveLookup.proto->internalClass->protoId;
     resolveProtoGetter(name, primitiveLookup.proto);
 
@@ -92,7 +102,7 @@ ReturnedValue Lookup::resolveGlobalGetter(ExecutionEngine *engine)
     Q_ASSERT(engine->isInitialized);
 
     Object *o = engine->globalObject;
-    PropertyKey name = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    PropertyKey name = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     protoLookup.protoId = o->internalClass()->protoId;
     resolveProtoGetter(name, o->d());
 
@@ -103,7 +113,7 @@ ReturnedValue Lookup::resolveGlobalGetter(ExecutionEngine *engine)
     else {
         globalGetter = globalGetterGeneric;
         Scope scope(engine);
-        ScopedString n(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+        ScopedString n(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
         return engine->throwReferenceError(n);
     }
     return globalGetter(this, engine);
@@ -142,17 +152,87 @@ static inline void setupProtoLookupTwoClasses(Lookup *l, const Lookup &first, co
     l->protoLookupTwoClasses.data2 = data2;
 }
 
+static bool cacheEntryFor(const Lookup &l, LookupCacheEntry *entry)
+{
+    if (l.getter == Lookup::getter0Inline || l.getter == Lookup::getter0MemberData) {
+        entry->ic = l.objectLookup.ic;
+        entry->protoId = 0;
+        entry->offset = l.objectLookup.offset;
+        entry->kind = (l.getter == Lookup::getter0Inline)
+                ? LookupCacheEntry::Inline
+                : LookupCacheEntry::MemberData;
+        return true;
+    }
+    if (l.getter == Lookup::getterProto) {
+        entry->ic = nullptr;
+        entry->protoId = l.protoLookup.protoId;
+        entry->data = l.protoLookup.data;
+        entry->kind = LookupCacheEntry::Proto;
+        return true;
+    }
+    return false;
+}
+
+static inline LookupCacheEntry objectCacheEntry(
+        Heap::InternalClass *ic, uint offset, LookupCacheEntry::Kind kind)
+{
+    LookupCacheEntry entry;
+    entry.ic = ic;
+    entry.protoId = 0;
+    entry.offset = offset;
+    entry.kind = kind;
+    return entry;
+}
+
+static inline LookupCacheEntry protoCacheEntry(quintptr protoId, const Value *data)
+{
+    LookupCacheEntry entry;
+    entry.ic = nullptr;
+    entry.protoId = protoId;
+    entry.data = data;
+    entry.kind = LookupCacheEntry::Proto;
+    return entry;
+}
+
+static void setupPolymorphicLookup(
+        Lookup *l, ExecutionEngine *engine, const LookupCacheEntry &first,
+        const LookupCacheEntry &second)
+{
+    PolymorphicLookupCache *cache = new PolymorphicLookupCache;
+    cache->entries[0] = first;
+    cache->entries[1] = second;
+    cache->size = 2;
+
+    // The classes are marked through the cache from now on
+    if (engine->isGCOngoing) {
+        for (uint i = 0; i < cache->size; ++i) {
+            if (cache->entries[i].ic)
+                WriteBarrier::shade(engine, cache->entries[i].ic);
+        }
+    }
+
+    l->polymorphicLookup.unused = 0;
+    l->polymorphicLookup.unused2 = 0;
+    l->polymorphicLookup.cache = cache;
+    l->getter = Lookup::getterPolymorphic;
+}
+
+static ReturnedValue resolveSecondGetter(Lookup *l, ExecutionEngine *engine, const Object *o, Lookup *second)
+{
+    memset(second, 0, sizeof(Lookup));
+    second->nameIndex = l->nameIndex;
+    second->forCall = l->forCall;
+    second->getter = Lookup::getterGeneric;
+    return second->resolveGetter(engine, o);
+}
+
 ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
     if (const Object *o = object.as<Object>()) {
 
         // Do the resolution on a second lookup, then merge.
         Lookup second;
-        memset(&second, 0, sizeof(Lookup));
-        second.nameIndex = l->nameIndex;
-        second.forCall = l->forCall;
-        second.getter = getterGeneric;
-        const ReturnedValue result = second.resolveGetter(engine, o);
+        const ReturnedValue result = resolveSecondGetter(l, engine, o, &second);
 
         if (l->getter == getter0Inline
                 && (second.getter == getter0Inline || second.getter == getter0MemberData)) {
@@ -185,6 +265,13 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
             return result;
         }
 
+        LookupCacheEntry first;
+        LookupCacheEntry next;
+        if (cacheEntryFor(*l, &first) && cacheEntryFor(second, &next)) {
+            setupPolymorphicLookup(l, engine, first, next);
+            return result;
+        }
+
         // If any of the above options were true, the propertyCache was inactive.
         second.releasePropertyCache();
     }
@@ -193,13 +280,119 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
     return getterFallback(l, engine, object);
 }
 
+static Q_NEVER_INLINE ReturnedValue getterPolymorphicMiss(
+        Lookup *l, ExecutionEngine *engine, const Value &object, const LookupCacheEntry &first,
+        const LookupCacheEntry &second)
+{
+    setupPolymorphicLookup(l, engine, first, second);
+    return Lookup::getterPolymorphic(l, engine, object);
+}
+
+static void setupMegamorphicLookup(Lookup *l, ExecutionEngine *engine)
+{
+    l->releasePolymorphicCache();
+    l->getter = Lookup::getterMegamorphic;
+
+    if (!engine->megamorphicLookupCache)
+        engine->megamorphicLookupCache = new MegamorphicLookupCache;
+    ++engine->megamorphicLookupCache->megamorphicLookups;
+
+    if (lcLookupStats().isDebugEnabled()) {
+        const Function *function = engine->currentStackFrame->v4Function;
+        qCDebug(lcLookupStats).nospace()
+                << "Lookup of \"" << function->runtimeString(l->nameIndex)->toQString()
+                << "\" in " << function->name()->toQString() << " ("
+                << function->sourceFile() << ":" << engine->currentStackFrame->lineNumber()
+                << ") saw more than " << PolymorphicLookupCache::MaxEntries
+                << " shapes and went megamorphic";
+    }
+}
+
+static Q_NEVER_INLINE ReturnedValue resolvePolymorphicMiss(
+        Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    const Object *o = object.as<Object>();
+    if (!o) {
+        l->releasePolymorphicCache();
+        l->getter = Lookup::getterFallback;
+        return Lookup::getterFallback(l, engine, object);
+    }
+
+    Lookup second;
+    const ReturnedValue result = resolveSecondGetter(l, engine, o, &second);
+
+    LookupCacheEntry entry;
+    if (!cacheEntryFor(second, &entry)) {
+        second.releasePropertyCache();
+        l->releasePolymorphicCache();
+        l->getter = Lookup::getterFallback;
+        return result;
+    }
+
+    PolymorphicLookupCache *cache = l->polymorphicLookup.cache;
+    if (cache->size < PolymorphicLookupCache::MaxEntries) {
+        if (engine->isGCOngoing && entry.ic)
+            WriteBarrier::shade(engine, entry.ic);
+        cache->entries[cache->size++] = entry;
+        return result;
+    }
+
+    setupMegamorphicLookup(l, engine);
+    return result;
+}
+
+ReturnedValue Lookup::getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    // we can safely cast to a QV4::Object here. If object is actually a string,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        if (const Value *v = l->polymorphicLookup.cache->find(o))
+            return v->asReturnedValue();
+    }
+    return resolvePolymorphicMiss(l, engine, object);
+}
+
+ReturnedValue Lookup::getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    const Object *o = object.as<Object>();
+    if (!o)
+        return getterFallback(l, engine, object);
+
+    MegamorphicLookupCache *cache = engine->megamorphicLookupCache;
+    Heap::InternalClass *ic = o->internalClass();
+    const PropertyKey key = engine->identifierTable->asPropertyKey(
+            engine->currentStackFrame->v4Function->runtimeString(l->nameIndex));
+    MegamorphicLookupCache::Entry &cached = cache->entries[MegamorphicLookupCache::hash(ic, key)];
+    if (cached.ic == ic && cached.key == key.id()) {
+        if (const Value *v = cached.find(o->d())) {
+            ++cache->hits;
+            return v->asReturnedValue();
+        }
+    }
+
+    ++cache->misses;
+    Lookup second;
+    const ReturnedValue result = resolveSecondGetter(l, engine, o, &second);
+
+    LookupCacheEntry entry;
+    if (cacheEntryFor(second, &entry)) {
+        static_cast<LookupCacheEntry &>(cached) = entry;
+        cached.ic = ic;
+        cached.key = key.id();
+    } else {
+        second.releasePropertyCache();
+    }
+    return result;
+}
+
 ReturnedValue Lookup::getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
     QV4::Scope scope(engine);
     QV4::ScopedObject o(scope, object.toObject(scope.engine));
     if (!o)
         return Encode::undefined();
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(l->nameIndex));
     return o->get(name);
 }
 
@@ -267,6 +460,12 @@ ReturnedValue Lookup::getter0Inlinegetter0Inline(Lookup *l, ExecutionEngine *eng
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset)->asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset2)->asReturnedValue();
+        return getterPolymorphicMiss(
+                l, engine, object,
+                objectCacheEntry(l->objectLookupTwoClasses.ic, l->objectLookupTwoClasses.offset,
+                                 LookupCacheEntry::Inline),
+                objectCacheEntry(l->objectLookupTwoClasses.ic2, l->objectLookupTwoClasses.offset2,
+                                 LookupCacheEntry::Inline));
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -282,6 +481,12 @@ ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset)->asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
+        return getterPolymorphicMiss(
+                l, engine, object,
+                objectCacheEntry(l->objectLookupTwoClasses.ic, l->objectLookupTwoClasses.offset,
+                                 LookupCacheEntry::Inline),
+                objectCacheEntry(l->objectLookupTwoClasses.ic2, l->objectLookupTwoClasses.offset2,
+                                 LookupCacheEntry::MemberData));
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -297,6 +502,12 @@ ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEng
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset].asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
+        return getterPolymorphicMiss(
+                l, engine, object,
+                objectCacheEntry(l->objectLookupTwoClasses.ic, l->objectLookupTwoClasses.offset,
+                                 LookupCacheEntry::MemberData),
+                objectCacheEntry(l->objectLookupTwoClasses.ic2, l->objectLookupTwoClasses.offset2,
+                                 LookupCacheEntry::MemberData));
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -315,7 +526,10 @@ ReturnedValue Lookup::getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine,
             return l->protoLookupTwoClasses.data->asReturnedValue();
         if (l->protoLookupTwoClasses.protoId2 == o->internalClass->protoId)
             return l->protoLookupTwoClasses.data2->asReturnedValue();
-        return getterFallback(l, engine, object);
+        return getterPolymorphicMiss(
+                l, engine, object,
+                protoCacheEntry(l->protoLookupTwoClasses.protoId, l->protoLookupTwoClasses.data),
+                protoCacheEntry(l->protoLookupTwoClasses.protoId2, l->protoLookupTwoClasses.data2));
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -392,9 +606,12 @@ ReturnedValue Lookup::getterIndexed(Lookup *l, ExecutionEngine *engine, const Va
         Heap::Object *ho = o->d();
         if (ho->arrayData && ho->arrayData->type == Heap::ArrayData::Simple) {
             Heap::SimpleArrayData *s = ho->arrayData.cast<Heap::SimpleArrayData>();
-            if (l->indexedLookup.index < s->values.size)
-                if (!s->data(l->indexedLookup.index).isEmpty())
-                    return s->data(l->indexedLookup.index).asReturnedValue();
+            if (l->indexedLookup.index < s->values.size) {
+                const Value &v = s->data(l->indexedLookup.index);
+                // packed arrays have no holes
+                if (s->isPacked() || !v.isEmpty())
+                    return v.asReturnedValue();
+            }
         }
         return o->get(l->indexedLookup.index);
     }
@@ -544,7 +761,7 @@ bool Lookup::setterGeneric(Lookup *l, ExecutionEngine *engine, Value &object, co
     ScopedObject o(scope, RuntimeHelpers::convertToObject(scope.engine, object));
     if (!o) // type error
         return false;
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(l->nameIndex));
     return o->put(name, value);
 }
 
@@ -587,7 +804,7 @@ bool Lookup::setterFallback(Lookup *l, ExecutionEngine *engine, Value &object, c
     if (!o)
         return false;
 
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(l->nameIndex));
     return o->put(name, value);
 }
 
@@ -28,6 +28,93 @@ namespace Heap {
     struct QObjectMethod;
 }
 
+// A lookup that has seen more than two shapes keeps them in a small out-of-line table. Own data
+// properties are keyed by InternalClass, data properties found on the prototype chain by protoId.
+struct LookupCacheEntry
+{
+    enum Kind : quint32 { Inline, MemberData, Proto };
+
+    Heap::InternalClass *ic;
+    quintptr protoId;
+    union {
+        uint offset;
+        const Value *data;
+    };
+    Kind kind;
+
+    const Value *find(const Heap::Object *o) const
+    {
+        switch (kind) {
+        case Inline:
+            return ic == o->internalClass ? o->inlinePropertyDataWithOffset(offset) : nullptr;
+        case MemberData:
+            return ic == o->internalClass ? o->memberData->values.data() + offset : nullptr;
+        case Proto:
+            return protoId == o->internalClass->protoId ? data : nullptr;
+        }
+        Q_UNREACHABLE_RETURN(nullptr);
+    }
+};
+
+struct PolymorphicLookupCache
+{
+    static constexpr uint MaxEntries = 8;
+
+    LookupCacheEntry entries[MaxEntries];
+    uint size = 0;
+
+    const Value *find(const Heap::Object *o) const
+    {
+        for (uint i = 0; i < size; ++i) {
+            if (const Value *v = entries[i].find(o))
+                return v;
+        }
+        return nullptr;
+    }
+
+    void markObjects(MarkStack *stack)
+    {
+        for (uint i = 0; i < size; ++i) {
+            if (entries[i].kind != LookupCacheEntry::Proto)
+                entries[i].ic->mark(stack);
+        }
+    }
+};
+
+// Engine wide cache for lookups that have seen too many shapes. It is indexed by
+// (InternalClass, name) and doesn't keep the classes alive, so it has to be cleared whenever
+// the garbage collector may free them.
+struct MegamorphicLookupCache
+{
+    static constexpr uint Size = 1024;
+
+    struct Entry : LookupCacheEntry
+    {
+        quint64 key;
+    };
+
+    Entry entries[Size] = {};
+
+    // Statistics, see qt.qml.lookup.statistics
+    uint megamorphicLookups = 0;
+    quint64 hits = 0;
+    quint64 misses = 0;
+
+    static uint hash(const Heap::InternalClass *ic, PropertyKey key)
+    {
+        const quintptr h = (quintptr(ic) >> 4) ^ quintptr(key.id());
+        return uint(h ^ (h >> 10)) & (Size - 1);
+    }
+
+    ~MegamorphicLookupCache();
+
+    void clear()
+    {
+        for (Entry &e : entries)
+            e.ic = nullptr;
+    }
+};
+
 // Note: We cannot hide the copy ctor and assignment operator of this class because it needs to
 //       be trivially copyable. But you should never ever copy it. There are refcounted members
 //       in there.
@@ -89,6 +176,11 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             uint index;
             uint unused;
         } indexedLookup;
+        struct {
+            quintptr unused;
+            quintptr unused2;
+            PolymorphicLookupCache *cache;
+        } polymorphicLookup;
         struct {
             Heap::InternalClass *ic;
             Heap::InternalClass *qmlTypeIc; // only used when lookup goes through QQmlTypeWrapper
@@ -129,6 +221,7 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             quintptr unused1;
             quintptr unused2;
             int objectId;
+            int componentObjectIndex; // Only used by AOT code, for ids of enclosing components
         } qmlContextIdObjectLookup;
         struct {
             // Same as protoLookup, as used for global lookups
@@ -164,6 +257,8 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
 
     static ReturnedValue getterGeneric(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterFallbackAsVariant(Lookup *l, ExecutionEngine *engine, const Value &object);
 
@@ -208,6 +303,16 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             markDef.h1->mark(stack);
         if (markDef.h2 && !(reinterpret_cast<quintptr>(markDef.h2) & 1))
             markDef.h2->mark(stack);
+        if (getter == getterPolymorphic)
+            polymorphicLookup.cache->markObjects(stack);
+    }
+
+    void releasePolymorphicCache()
+    {
+        if (getter == getterPolymorphic) {
+            delete polymorphicLookup.cache;
+            polymorphicLookup.cache = nullptr;
+        }
     }
 
     void releasePropertyCache()
@@ -236,6 +341,13 @@ Q_STATIC_ASSERT(std::is_standard_layout<Lookup>::value);
 // across 32-bit and 64-bit (matters when cross-compiling).
 Q_STATIC_ASSERT(offsetof(Lookup, getter) == 0);
 
+inline Lookup *ExecutableCompilationUnit::runtimeLookup(uint index)
+{
+    if (Q_UNLIKELY(!runtimeLookups))
+        materializeRuntimeLookups();
+    return runtimeLookups + index;
+}
+
 inline void setupQObjectLookup(
         Lookup *lookup, const QQmlData *ddata, const QQmlPropertyData *propertyData)
 {
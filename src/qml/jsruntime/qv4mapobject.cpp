@@ -214,7 +214,11 @@ ReturnedValue WeakMapPrototype::method_set(const FunctionObject *b, const Value
         (!argc || !argv[0].isObject()))
         return scope.engine->throwTypeError();
 
-    that->d()->esTable->set(argv[0], argc > 1 ? argv[1] : Value::undefinedValue());
+    const Value value = argc > 1 ? argv[1] : Value::undefinedValue();
+    that->d()->esTable->set(argv[0], value);
+    // The table is not part of the heap, so the write barrier needs to be triggered manually
+    WriteBarrier::barrier(scope.engine, that->d(), argv[0].asReturnedValue());
+    WriteBarrier::barrier(scope.engine, that->d(), value.asReturnedValue());
     return that.asReturnedValue();
 }
 
@@ -317,7 +321,12 @@ ReturnedValue MapPrototype::method_set(const FunctionObject *b, const Value *thi
     if (!that || that->d()->isWeakMap)
         return scope.engine->throwTypeError();
 
-    that->d()->esTable->set(argc ? argv[0] : Value::undefinedValue(), argc > 1 ? argv[1] : Value::undefinedValue());
+    const Value key = argc ? argv[0] : Value::undefinedValue();
+    const Value value = argc > 1 ? argv[1] : Value::undefinedValue();
+    that->d()->esTable->set(key, value);
+    // The table is not part of the heap, so the write barrier needs to be triggered manually
+    WriteBarrier::barrier(scope.engine, that->d(), key.asReturnedValue());
+    WriteBarrier::barrier(scope.engine, that->d(), value.asReturnedValue());
     return that.asReturnedValue();
 }
 
@@ -53,7 +53,7 @@ void Heap::Module::init(ExecutionEngine *engine, ExecutableCompilationUnit *modu
 
         for (uint i = 0; i < unit->data->importEntryTableSize; ++i) {
             const CompiledData::ImportEntry &import = unit->data->importEntryTable()[i];
-            ic = ic->addMember(engine->identifierTable->asPropertyKey(unit->runtimeStrings[import.localName]), Attr_NotConfigurable);
+            ic = ic->addMember(engine->identifierTable->asPropertyKey(unit->runtimeString(import.localName)), Attr_NotConfigurable);
         }
         scope->internalClass.set(engine, ic->d());
     }
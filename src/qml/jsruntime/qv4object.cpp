@@ -278,6 +278,8 @@ PropertyIndex Object::getValueOrSetter(PropertyKey id, PropertyAttributes *attrs
                 uint idx = o->arrayData->mappedIndex(index);
                 if (idx != UINT_MAX) {
                     *attrs = o->arrayData->attributes(index);
+                    // The caller may write anything through the returned index
+                    o->arrayData->elementKind = Heap::ArrayData::Generic;
                     return { o->arrayData , o->arrayData->values.values + (attrs->isAccessor() ? idx + SetterOffset : idx) };
                 }
             }
@@ -502,6 +504,8 @@ bool Object::internalPut(PropertyKey id, const Value &value, Value *receiver)
                     if (!ok)
                         return false;
                 } else {
+                    if (id.isArrayIndex())
+                        d()->arrayData->updateElementKind(value);
                     propertyIndex.set(scope.engine, value);
                 }
                 return true;
@@ -710,6 +714,7 @@ void Object::copyArrayData(Object *other)
             Heap::ArrayData *dd = d()->arrayData;
             dd->values.size = other->d()->arrayData->values.size;
             dd->offset = other->d()->arrayData->offset;
+            dd->elementKind = other->d()->arrayData->elementKind;
         }
         // ### need a write barrier
         memcpy(d()->arrayData->values.values, other->d()->arrayData->values.values, other->d()->arrayData->values.alloc*sizeof(Value));
@@ -743,7 +748,7 @@ ReturnedValue Object::virtualResolveLookupGetter(const Object *object, Execution
     Q_ASSERT(engine->isInitialized);
 
     Heap::Object *obj = object->d();
-    PropertyKey name = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[lookup->nameIndex]);
+    PropertyKey name = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->runtimeString(lookup->nameIndex));
     if (name.isArrayIndex()) {
         lookup->indexedLookup.index = name.asArrayIndex();
         lookup->getter = Lookup::getterIndexed;
@@ -781,7 +786,7 @@ bool Object::virtualResolveLookupSetter(Object *object, ExecutionEngine *engine,
     Q_ASSERT(engine->isInitialized);
 
     Scope scope(engine);
-    ScopedString name(scope, scope.engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[lookup->nameIndex]);
+    ScopedString name(scope, scope.engine->currentStackFrame->v4Function->runtimeString(lookup->nameIndex));
 
     Heap::InternalClass *c = object->internalClass();
     PropertyKey key = name->toPropertyKey();
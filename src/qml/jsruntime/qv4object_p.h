@@ -238,6 +238,7 @@ public:
         Q_ASSERT(t != Heap::ArrayData::Simple && t != Heap::ArrayData::Sparse);
         arrayCreate();
         d()->arrayData->type = t;
+        d()->arrayData->elementKind = Heap::ArrayData::Generic;
     }
 
     inline void arrayReserve(uint n) {
@@ -245,8 +246,12 @@ public:
     }
 
     void arrayCreate() {
-        if (!arrayData())
+        if (!arrayData()) {
             ArrayData::realloc(this, Heap::ArrayData::Simple, 0, false);
+            // An empty array is trivially packed. It will turn generic once something else than
+            // a number is stored in it.
+            d()->arrayData->elementKind = Heap::ArrayData::PackedInt32;
+        }
 #ifdef CHECK_SPARSE_ARRAYS
         initSparseArray();
 #endif
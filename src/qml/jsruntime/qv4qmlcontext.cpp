@@ -501,7 +501,7 @@ ReturnedValue QQmlContextWrapper::resolveQmlContextPropertyLookupGetter(Lookup *
     Scope scope(engine);
     auto *func = engine->currentStackFrame->v4Function;
     ScopedPropertyKey name(scope, engine->identifierTable->asPropertyKey(
-                            func->compilationUnit->runtimeStrings[l->nameIndex]));
+                            func->runtimeString(l->nameIndex)));
 
     // Special hack for bounded signal expressions, where the parameters of signals are injected
     // into the handler expression through the locals of the call context. So for onClicked: { ... }
@@ -765,8 +765,8 @@ ReturnedValue QQmlContextWrapper::lookupInParentContextHierarchy(Lookup *l, Exec
 
     QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine->qmlEngine());
 
-    PropertyKey id =engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->
-                                                           runtimeStrings[l->nameIndex]);
+    PropertyKey id =engine->identifierTable->asPropertyKey(
+            engine->currentStackFrame->v4Function->runtimeString(l->nameIndex));
     ScopedString name(scope, id.asStringOrSymbol());
 
     ScopedValue result(scope);
@@ -1067,8 +1067,8 @@ OwnPropertyKeyIterator *QObjectWrapper::virtualOwnPropertyKeys(const Object *m,
 ReturnedValue QObjectWrapper::virtualResolveLookupGetter(const Object *object, ExecutionEngine *engine, Lookup *lookup)
 {
     // Keep this code in sync with ::getQmlProperty
-    PropertyKey id = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->
-                                                            runtimeStrings[lookup->nameIndex]);
+    PropertyKey id = engine->identifierTable->asPropertyKey(
+            engine->currentStackFrame->v4Function->runtimeString(lookup->nameIndex));
     if (!id.isString())
         return Object::virtualResolveLookupGetter(object, engine, lookup);
     Scope scope(engine);
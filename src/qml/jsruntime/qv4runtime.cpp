@@ -186,7 +186,7 @@ void RuntimeCounters::count(const char *func, uint tag1, uint tag2)
 
 static QV4::Lookup *runtimeLookup(Function *f, uint i)
 {
-    return f->executableCompilationUnit()->runtimeLookups + i;
+    return f->executableCompilationUnit()->runtimeLookup(i);
 }
 
 void RuntimeHelpers::numberToString(QString *result, double num, int radix)
@@ -316,7 +316,7 @@ ReturnedValue Runtime::DeleteProperty::call(ExecutionEngine *engine, QV4::Functi
 Bool Runtime::DeleteName_NoThrow::call(ExecutionEngine *engine, int nameIndex)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     return engine->currentContext()->deleteProperty(name);
 }
 
@@ -637,7 +637,7 @@ void Runtime::StoreProperty::call(ExecutionEngine *engine, const Value &object,
 {
     Scope scope(engine);
     QV4::Function *v4Function = engine->currentStackFrame->v4Function;
-    ScopedString name(scope, v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, v4Function->runtimeString(nameIndex));
     ScopedObject o(scope, object);
     if (!o) {
         if (v4Function->isStrict()) {
@@ -982,7 +982,7 @@ ReturnedValue Runtime::DestructureRestElement::call(ExecutionEngine *engine, con
 void Runtime::StoreNameSloppy::call(ExecutionEngine *engine, int nameIndex, const Value &value)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     ExecutionContext::Error e = engine->currentContext()->setProperty(name, value);
 
     if (e == ExecutionContext::RangeError)
@@ -992,7 +992,7 @@ void Runtime::StoreNameSloppy::call(ExecutionEngine *engine, int nameIndex, cons
 void Runtime::StoreNameStrict::call(ExecutionEngine *engine, int nameIndex, const Value &value)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     ExecutionContext::Error e = engine->currentContext()->setProperty(name, value);
     if (e == ExecutionContext::TypeError)
         engine->throwTypeError();
@@ -1003,7 +1003,7 @@ void Runtime::StoreNameStrict::call(ExecutionEngine *engine, int nameIndex, cons
 ReturnedValue Runtime::LoadProperty::call(ExecutionEngine *engine, const Value &object, int nameIndex)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
 
     ScopedObject o(scope, object);
     if (o)
@@ -1023,7 +1023,7 @@ ReturnedValue Runtime::LoadProperty::call(ExecutionEngine *engine, const Value &
 ReturnedValue Runtime::LoadName::call(ExecutionEngine *engine, int nameIndex)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     return engine->currentContext()->getProperty(name);
 }
 
@@ -1394,7 +1394,7 @@ ReturnedValue Runtime::CallGlobalLookup::call(ExecutionEngine *engine, uint inde
     Value thisObject = Value::undefinedValue();
     if (!function.isFunctionObject()) {
         return throwPropertyIsNotAFunctionTypeError(engine, &thisObject,
-                                                    engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]->toQString());
+                                                    engine->currentStackFrame->v4Function->runtimeString(l->nameIndex)->toQString());
     }
 
     return checkedResult(engine, static_cast<FunctionObject &>(function).call(
@@ -1410,7 +1410,7 @@ ReturnedValue Runtime::CallQmlContextPropertyLookup::call(ExecutionEngine *engin
     Value function = Value::fromReturnedValue(l->qmlContextPropertyGetter(l, engine, thisObject));
     if (!function.isFunctionObject()) {
         return throwPropertyIsNotAFunctionTypeError(engine, thisObject,
-                                                    engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]->toQString());
+                                                    engine->currentStackFrame->v4Function->runtimeString(l->nameIndex)->toQString());
     }
 
     return checkedResult(engine, static_cast<FunctionObject &>(function).call(
@@ -1440,7 +1440,7 @@ ReturnedValue Runtime::CallName::call(ExecutionEngine *engine, int nameIndex, Va
 {
     Scope scope(engine);
     ScopedValue thisObject(scope);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
 
     ScopedFunctionObject f(scope, engine->currentContext()->getPropertyAndBase(name, thisObject));
     if (engine->hasException)
@@ -1448,8 +1448,8 @@ ReturnedValue Runtime::CallName::call(ExecutionEngine *engine, int nameIndex, Va
 
     if (!f) {
         return throwPropertyIsNotAFunctionTypeError(
-                engine, thisObject, engine->currentStackFrame->v4Function->compilationUnit
-                                            ->runtimeStrings[nameIndex]->toQString());
+                engine, thisObject,
+                engine->currentStackFrame->v4Function->runtimeString(nameIndex)->toQString());
     }
 
     return checkedResult(engine, f->call(thisObject, argv, argc));
@@ -1461,7 +1461,7 @@ ReturnedValue Runtime::CallProperty::call(ExecutionEngine *engine, const Value &
     Scope scope(engine);
     ScopedString name(
             scope,
-            engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+            engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     ScopedObject lookupObject(scope, base);
 
     if (!lookupObject) {
@@ -1680,7 +1680,7 @@ ReturnedValue Runtime::TypeofValue::call(ExecutionEngine *engine, const Value &v
 QV4::ReturnedValue Runtime::TypeofName::call(ExecutionEngine *engine, int nameIndex)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     ScopedValue prop(scope, engine->currentContext()->getProperty(name));
     // typeof doesn't throw. clear any possible exception
     scope.engine->hasException = false;
@@ -1711,7 +1711,7 @@ ReturnedValue Runtime::PushWithContext::call(ExecutionEngine *engine, const Valu
 void Runtime::PushCatchContext::call(ExecutionEngine *engine, int blockIndex, int exceptionVarNameIndex)
 {
     Q_ASSERT(engine->currentStackFrame->isJSTypesFrame());
-    auto name = engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[exceptionVarNameIndex];
+    auto name = engine->currentStackFrame->v4Function->runtimeString(exceptionVarNameIndex);
     static_cast<JSTypesStackFrame *>(engine->currentStackFrame)->jsFrame->context
             = ExecutionContext::newCatchContext(engine->currentStackFrame, blockIndex, name)->asReturnedValue();
 }
@@ -1754,7 +1754,7 @@ void Runtime::PopScriptContext::call(ExecutionEngine *engine)
 void Runtime::ThrowReferenceError::call(ExecutionEngine *engine, int nameIndex)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     engine->throwReferenceError(name);
 }
 
@@ -1779,7 +1779,7 @@ ReturnedValue Runtime::ConvertThisToObject::call(ExecutionEngine *engine, const
 void Runtime::DeclareVar::call(ExecutionEngine *engine, Bool deletable, int nameIndex)
 {
     Scope scope(engine);
-    ScopedString name(scope, engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[nameIndex]);
+    ScopedString name(scope, engine->currentStackFrame->v4Function->runtimeString(nameIndex));
     engine->currentContext()->createMutableBinding(name, deletable);
 }
 
@@ -1904,7 +1904,7 @@ ReturnedValue Runtime::CreateClass::call(ExecutionEngine *engine, int classIndex
 
     ScopedString name(scope);
     if (cls->nameIndex != UINT_MAX) {
-        name = unit->runtimeStrings[cls->nameIndex];
+        name = unit->runtimeString(cls->nameIndex);
         constructor->defineReadonlyConfigurableProperty(engine->id_name(), name);
     }
 
@@ -1924,7 +1924,7 @@ ReturnedValue Runtime::CreateClass::call(ExecutionEngine *engine, int classIndex
                 return Encode::undefined();
             ++computedNames;
         } else {
-            name = unit->runtimeStrings[methods[i].name];
+            name = unit->runtimeString(methods[i].name);
             propertyName = name->toPropertyKey();
         }
         QV4::Function *f = unit->runtimeFunctions[methods[i].function];
@@ -105,6 +105,8 @@ ReturnedValue WeakSetPrototype::method_add(const FunctionObject *b, const Value
         return scope.engine->throwTypeError();
 
     that->d()->esTable->set(argv[0], Value::undefinedValue());
+    // The table is not part of the heap, so the write barrier needs to be triggered manually
+    WriteBarrier::barrier(scope.engine, that->d(), argv[0].asReturnedValue());
     return that.asReturnedValue();
 }
 
@@ -193,6 +195,8 @@ ReturnedValue SetPrototype::method_add(const FunctionObject *b, const Value *thi
         return scope.engine->throwTypeError();
 
     that->d()->esTable->set(argv[0], Value::undefinedValue());
+    // The table is not part of the heap, so the write barrier needs to be triggered manually
+    WriteBarrier::barrier(scope.engine, that->d(), argv[0].asReturnedValue());
     return that.asReturnedValue();
 }
 
@@ -470,6 +470,13 @@ ReturnedValue VME::exec(JSTypesStackFrame *frame, ExecutionEngine *engine)
                 QV4::JIT::BaselineJIT(function).generate();
             else
                 ++function->interpreterCallCount;
+        } else if (!function->optimized) {
+            // Hot baseline code is compiled once more, speculating on the type feedback the
+            // baseline code has collected. See VME::deoptimize() for the way back.
+            if (engine->canOptimize(function))
+                QV4::JIT::BaselineJIT(function, QV4::JIT::BaselineJIT::OptimizedTier).generate();
+            else
+                ++function->jittedCallCount;
         }
     }
 #endif // QT_CONFIG(qml_jit)
@@ -493,6 +500,23 @@ ReturnedValue VME::exec(JSTypesStackFrame *frame, ExecutionEngine *engine)
     return result;
 }
 
+QV4::ReturnedValue VME::deoptimize(JSTypesStackFrame *frame, ExecutionEngine *engine,
+                                   int instructionOffset)
+{
+    // Called from optimized JIT code when one of its speculations fails. The registers and the
+    // accumulator live in the JS stack frame, so the interpreter can take over the frame and
+    // re-execute the failing instruction generically.
+    Function *function = frame->v4Function;
+    Q_ASSERT(function->baselineJittedCode);
+    if (function->jittedCode != function->baselineJittedCode
+            && ++function->deoptimizationCount >= MaxDeoptimizationCount) {
+        // Keep the optimized code alive, as it may still be on the stack, but stop using it.
+        function->jittedCode = function->baselineJittedCode;
+    }
+
+    return interpret(frame, engine, function->codeData + instructionOffset);
+}
+
 QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *engine, const char *code)
 {
     QV4::Function *function = frame->v4Function;
@@ -579,7 +603,7 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
     MOTH_END_INSTR(StoreScopedLocal)
 
     MOTH_BEGIN_INSTR(LoadRuntimeString)
-        acc = function->compilationUnit->runtimeStrings[stringId]->asReturnedValue();
+        acc = function->runtimeString(stringId)->asReturnedValue();
     MOTH_END_INSTR(LoadRuntimeString)
 
     MOTH_BEGIN_INSTR(MoveRegExp)
@@ -598,14 +622,14 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
 
     MOTH_BEGIN_INSTR(LoadGlobalLookup)
         STORE_IP();
-        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookups + index;
+        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookup(index);
         acc = l->globalGetter(l, engine);
         CHECK_EXCEPTION;
     MOTH_END_INSTR(LoadGlobalLookup)
 
     MOTH_BEGIN_INSTR(LoadQmlContextPropertyLookup)
         STORE_IP();
-        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookups + index;
+        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookup(index);
         acc = l->qmlContextPropertyGetter(l, engine, nullptr);
         CHECK_EXCEPTION;
     MOTH_END_INSTR(LoadQmlContextPropertyLookup)
@@ -661,11 +685,11 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
         STORE_IP();
         STORE_ACC();
 
-        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookups + index;
+        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookup(index);
 
         if (accumulator.isNullOrUndefined()) {
             QString message = QStringLiteral("Cannot read property '%1' of %2")
-                    .arg(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]->toQString())
+                    .arg(engine->currentStackFrame->v4Function->runtimeString(l->nameIndex)->toQString())
                     .arg(accumulator.toQStringNoThrow());
             acc = engine->throwTypeError(message);
             goto handleUnwind;
@@ -679,7 +703,7 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
         STORE_IP();
         STORE_ACC();
 
-        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookups + index;
+        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookup(index);
 
         if (accumulator.isNullOrUndefined()) {
             code += offset;
@@ -699,7 +723,7 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
     MOTH_BEGIN_INSTR(SetLookup)
         STORE_IP();
         STORE_ACC();
-        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookups + index;
+        QV4::Lookup *l = function->executableCompilationUnit()->runtimeLookup(index);
         if (!l->setter(l, engine, STACK_VALUE(base), accumulator) && function->isStrict())
             engine->throwTypeError();
         CHECK_EXCEPTION;
@@ -781,11 +805,11 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
 
     MOTH_BEGIN_INSTR(CallPropertyLookup)
         STORE_IP();
-        Lookup *l = function->executableCompilationUnit()->runtimeLookups + lookupIndex;
+        Lookup *l = function->executableCompilationUnit()->runtimeLookup(lookupIndex);
 
         if (STACK_VALUE(base).isNullOrUndefined()) {
             QString message = QStringLiteral("Cannot call method '%1' of %2")
-                    .arg(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]->toQString())
+                    .arg(engine->currentStackFrame->v4Function->runtimeString(l->nameIndex)->toQString())
                     .arg(STACK_VALUE(base).toQStringNoThrow());
             acc = engine->throwTypeError(message);
             goto handleUnwind;
@@ -796,7 +820,7 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
 
         if (Q_UNLIKELY(!f.isFunctionObject())) {
             QString message = QStringLiteral("Property '%1' of object %2 is not a function")
-                    .arg(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[l->nameIndex]->toQString())
+                    .arg(engine->currentStackFrame->v4Function->runtimeString(l->nameIndex)->toQString())
                     .arg(STACK_VALUE(base).toQStringNoThrow());
             acc = engine->throwTypeError(message);
             goto handleUnwind;
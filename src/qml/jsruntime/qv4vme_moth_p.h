@@ -34,6 +34,10 @@ public:
     static void exec(MetaTypesStackFrame *frame, ExecutionEngine *engine);
     static QV4::ReturnedValue exec(JSTypesStackFrame *frame, ExecutionEngine *engine);
     static QV4::ReturnedValue interpret(JSTypesStackFrame *frame, ExecutionEngine *engine, const char *codeEntry);
+    static QV4::ReturnedValue deoptimize(JSTypesStackFrame *frame, ExecutionEngine *engine, int instructionOffset);
+
+    // After this many failed speculations, a function goes back to its baseline JIT code.
+    static constexpr int MaxDeoptimizationCount = 8;
 };
 
 } // namespace Moth
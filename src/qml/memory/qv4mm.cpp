@@ -6,6 +6,7 @@
 #include "qv4mm_p.h"
 #include "qv4qobjectwrapper_p.h"
 #include "qv4identifiertable_p.h"
+#include "qv4lookup_p.h"
 #include <QtCore/qalgorithms.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/qloggingcategory.h>
@@ -16,11 +17,17 @@
 
 #include <QElapsedTimer>
 #include <QMap>
+#include <QMutex>
 #include <QScopedValueRollback>
+#include <QWaitCondition>
+#if QT_CONFIG(thread)
+#include <QThreadPool>
+#endif
 
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
+#include <deque>
 #include "qv4profiling_p.h"
 #include "qv4mapobject_p.h"
 #include "qv4setobject_p.h"
@@ -70,6 +77,8 @@ enum {
     GCOverallocation = 200 /* Max overallocation by the GC in % */
 };
 
+static constexpr std::chrono::microseconds DefaultGCSliceBudget = std::chrono::milliseconds(2);
+
 struct MemorySegment {
     enum {
 #ifdef Q_OS_RTEMS
@@ -326,6 +335,56 @@ bool Chunk::sweep(ExecutionEngine *engine)
     return hasUsedSlots;
 }
 
+// Variant of sweep() that can run on a different thread than the engine's. Dead items with a
+// destroy() function are kept allocated and returned in \a finalizers instead, as their
+// finalizers may touch objects owned by the engine's thread.
+bool Chunk::sweepDeferringFinalizers(std::vector<HeapItem *> *finalizers)
+{
+    bool hasLiveItems = false;
+    HeapItem *o = realBase();
+    bool lastSlotFree = false;
+    for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+        quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
+        Q_ASSERT((toFree & objectBitmap[i]) == toFree); // check all black objects are marked as being used
+        quintptr kept = blackBitmap[i];
+        quintptr e = extendsBitmap[i];
+        if (lastSlotFree)
+            e &= (e + 1); // clear all lowest extent bits
+        while (toFree) {
+            uint index = qCountTrailingZeroBits(toFree);
+            quintptr bit = (static_cast<quintptr>(1) << index);
+
+            toFree ^= bit; // mask out freed slot
+
+            HeapItem *itemToFree = o + index;
+            Heap::Base *b = *itemToFree;
+            if (b->internalClass->vtable->destroy) {
+                kept |= bit;
+                finalizers->push_back(itemToFree);
+                continue;
+            }
+
+            // remove all extends slots that have been freed, see sweep()
+            quintptr mask = (bit << 1) - 1;
+            quintptr objmask = e | mask;
+            quintptr result = objmask + 1;
+            Q_ASSERT(qCountTrailingZeroBits(result) - index != 0); // ensure we freed something
+            result |= mask;
+            e &= result;
+#ifdef V4_USE_HEAPTRACK
+            heaptrack_report_free(itemToFree);
+#endif
+        }
+        objectBitmap[i] = kept;
+        hasLiveItems |= (blackBitmap[i] != 0);
+        extendsBitmap[i] = e;
+        lastSlotFree = !((objectBitmap[i]|extendsBitmap[i]) >> (sizeof(quintptr)*8 - 1));
+        Q_ASSERT((objectBitmap[i] & extendsBitmap[i]) == 0);
+        o += Chunk::Bits;
+    }
+    return hasLiveItems;
+}
+
 void Chunk::freeAll(ExecutionEngine *engine)
 {
     //    DEBUG << "sweeping chunk" << this << (*freeList);
@@ -451,6 +510,7 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
 
     HeapItem *m;
 
+retry:
     if (slotsRequired < NumBins - 1) {
         m = freeBins[slotsRequired];
         if (m) {
@@ -520,6 +580,8 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
     }
 
     if (!m) {
+        if (nChunksBeingSwept && adoptSweptChunk())
+            goto retry;
         if (!forceAllocation)
             return nullptr;
         if (nFree) {
@@ -578,6 +640,183 @@ void BlockAllocator::sweep()
     chunks.erase(firstEmptyChunk, chunks.end());
 }
 
+struct BackgroundSweep
+{
+    struct SweptChunk
+    {
+        Chunk *chunk = nullptr;
+        HeapItem *bins[BlockAllocator::NumBins] = {};
+        HeapItem *binTails[BlockAllocator::NumBins] = {};
+        std::vector<HeapItem *> finalizers;
+        size_t freedSlots = 0;
+        bool hasLiveItems = false;
+    };
+
+    // Sweeps one of the remaining chunks. Returns false if there are none left.
+    bool sweepNext()
+    {
+        Chunk *c = nullptr;
+        {
+            QMutexLocker locker(&mutex);
+            if (unswept.empty())
+                return false;
+            c = unswept.back();
+            unswept.pop_back();
+            ++inProgress;
+        }
+
+        SweptChunk result;
+        result.chunk = c;
+        const uint usedBefore = c->nUsedSlots();
+        result.hasLiveItems = c->sweepDeferringFinalizers(&result.finalizers);
+        result.freedSlots = usedBefore - c->nUsedSlots();
+        c->resetBlackBits();
+        if (result.hasLiveItems) {
+            c->sortIntoBins(result.bins, BlockAllocator::NumBins);
+            for (uint i = 0; i < BlockAllocator::NumBins; ++i) {
+                for (HeapItem *h = result.bins[i]; h; h = h->freeData.next)
+                    result.binTails[i] = h;
+            }
+        }
+
+        QMutexLocker locker(&mutex);
+        --inProgress;
+        swept.push_back(std::move(result));
+        chunkSwept.wakeAll();
+        return true;
+    }
+
+    void run()
+    {
+        while (sweepNext()) {}
+    }
+
+    // Called from the engine's thread. Sweeps a chunk itself rather than waiting for the worker
+    // to get around to it.
+    bool takeSweptChunk(SweptChunk *result)
+    {
+        QMutexLocker locker(&mutex);
+        while (true) {
+            if (!swept.empty()) {
+                *result = std::move(swept.front());
+                swept.pop_front();
+                return true;
+            }
+            if (!unswept.empty()) {
+                locker.unlock();
+                sweepNext();
+                locker.relock();
+                continue;
+            }
+            if (!inProgress)
+                return false;
+            chunkSwept.wait(&mutex);
+        }
+    }
+
+    QMutex mutex;
+    QWaitCondition chunkSwept;
+    std::vector<Chunk *> unswept;
+    std::deque<SweptChunk> swept;
+    int inProgress = 0;
+};
+
+void BlockAllocator::startBackgroundSweep()
+{
+    Q_ASSERT(!backgroundSweep);
+
+    nextFree = nullptr;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+    usedSlotsAfterLastSweep = 0;
+
+    backgroundSweep = std::make_shared<BackgroundSweep>();
+    backgroundSweep->unswept.swap(chunks);
+    nChunksBeingSwept = backgroundSweep->unswept.size();
+
+#if QT_CONFIG(thread)
+    if (QThreadPool *pool = QThreadPool::globalInstance())
+        pool->start([sweep = backgroundSweep]() { sweep->run(); });
+#endif
+    // Without a worker thread the chunks get swept lazily, as allocation adopts them.
+}
+
+bool BlockAllocator::adoptSweptChunk()
+{
+    BackgroundSweep::SweptChunk swept;
+    if (!backgroundSweep || !backgroundSweep->takeSweptChunk(&swept))
+        return false;
+
+    --nChunksBeingSwept;
+    Chunk *c = swept.chunk;
+    Q_V4_PROFILE_DEALLOC(engine, swept.freedSlots * Chunk::SlotSize, Profiling::SmallItem);
+
+    if (!swept.hasLiveItems && swept.finalizers.empty()) {
+        Q_V4_PROFILE_DEALLOC(engine, Chunk::DataSize, Profiling::HeapPage);
+        chunkAllocator->free(c);
+        return true;
+    }
+
+    // The items that still need to be finalized stay allocated until runDeferredFinalizers()
+    // gets to them. Finalizers may allocate, and therefore cannot run in here.
+    if (swept.hasLiveItems) {
+        for (uint i = 0; i < NumBins; ++i) {
+            if (!swept.bins[i])
+                continue;
+            swept.binTails[i]->freeData.next = freeBins[i];
+            freeBins[i] = swept.bins[i];
+        }
+    } else {
+        c->sortIntoBins(freeBins, NumBins);
+    }
+    deferredFinalizers.insert(deferredFinalizers.end(), swept.finalizers.begin(),
+                              swept.finalizers.end());
+
+    chunks.push_back(c);
+    usedSlotsAfterLastSweep += c->nUsedSlots();
+    return true;
+}
+
+// Runs the finalizers of the dead items found by the background sweep, and frees the items.
+// Finalizers that allocate may adopt further chunks, and thereby add to the list.
+void BlockAllocator::runDeferredFinalizers()
+{
+    while (!deferredFinalizers.empty()) {
+        HeapItem *item = deferredFinalizers.back();
+        deferredFinalizers.pop_back();
+
+        Heap::Base *b = *item;
+        b->internalClass->vtable->destroy(b);
+        b->_checkIsDestroyed();
+#ifdef V4_USE_HEAPTRACK
+        heaptrack_report_free(item);
+#endif
+        Chunk *c = item->chunk();
+        const size_t nSlots = item->size() >> Chunk::SlotSizeShift;
+        const size_t index = item - c->realBase();
+        Chunk::clearBit(c->objectBitmap, index);
+        for (size_t i = 1; i < nSlots; ++i)
+            Chunk::clearBit(c->extendsBitmap, index + i);
+        Q_V4_PROFILE_DEALLOC(engine, nSlots * Chunk::SlotSize, Profiling::SmallItem);
+        usedSlotsAfterLastSweep -= nSlots;
+
+        const size_t bin = binForSlots(nSlots);
+        item->freeData.availableSlots = nSlots;
+        item->freeData.next = freeBins[bin];
+        freeBins[bin] = item;
+    }
+}
+
+void BlockAllocator::finishBackgroundSweep()
+{
+    if (!backgroundSweep)
+        return;
+
+    while (adoptSweptChunk()) {}
+    Q_ASSERT(!nChunksBeingSwept);
+    backgroundSweep.reset();
+}
+
 void BlockAllocator::freeAll()
 {
     for (auto c : chunks)
@@ -641,11 +880,12 @@ static void freeHugeChunk(ChunkAllocator *chunkAllocator, const HugeItemAllocato
 #endif
 }
 
-void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
+void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr, bool keepBlackBits)
 {
-    auto isBlack = [this, classCountPtr] (const HugeChunk &c) {
+    auto isBlack = [this, classCountPtr, keepBlackBits] (const HugeChunk &c) {
         bool b = c.chunk->first()->isBlack();
-        Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
+        if (!keepBlackBits)
+            Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
         if (!b) {
             Q_V4_PROFILE_DEALLOC(engine, c.size, Profiling::LargeItem);
             freeHugeChunk(chunkAllocator, c, classCountPtr);
@@ -684,7 +924,22 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     , aggressiveGC(!qEnvironmentVariableIsEmpty("QV4_MM_AGGRESSIVE_GC"))
     , gcStats(lcGcStats().isDebugEnabled())
     , gcCollectorStats(lcGcAllocatorStats().isDebugEnabled())
+    , generationalGC(!qEnvironmentVariableIsEmpty("QV4_MM_GENERATIONAL_GC"))
+    // Both rely on all mark bits being cleared between collections.
+    , incrementalGC(!qEnvironmentVariableIsEmpty("QV4_MM_INCREMENTAL_GC") && !generationalGC)
+    // The allocator statistics and the consistency checks of the aggressive mode need to see
+    // the heap fully swept right after a collection.
+    , concurrentSweep(!qEnvironmentVariableIsEmpty("QV4_MM_CONCURRENT_SWEEP")
+                      && !aggressiveGC && !gcCollectorStats && !generationalGC)
+    , m_gcSliceBudget(DefaultGCSliceBudget)
 {
+    bool ok = false;
+    const int sliceBudget = qEnvironmentVariableIntValue("QV4_GC_SLICE_BUDGET", &ok);
+    if (ok && sliceBudget > 0)
+        m_gcSliceBudget = std::chrono::milliseconds(sliceBudget);
+
+    engine->isGenerationalGC = generationalGC;
+
 #ifdef V4_USE_VALGRIND
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
@@ -708,7 +963,12 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
         // If the gc is running right now, it will not have a chance to mark the newly created item
         // and may therefore sweep it right away.
         // Protect the new object from the current GC run to avoid this.
-        m->as<Heap::Base>()->setMarkBit();
+        if (generationalGC)
+            rememberAllocatedOld(m->as<Heap::Base>());
+        else
+            m->as<Heap::Base>()->setMarkBit();
+    } else if (m_markStack) {
+        markAllocatedDuringGC(m->as<Heap::Base>());
     }
 
     return *m;
@@ -730,7 +990,12 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
         // If the gc is running right now, it will not have a chance to mark the newly created item
         // and may therefore sweep it right away.
         // Protect the new object from the current GC run to avoid this.
-        m->as<Heap::Base>()->setMarkBit();
+        if (generationalGC)
+            rememberAllocatedOld(m->as<Heap::Base>());
+        else
+            m->as<Heap::Base>()->setMarkBit();
+    } else if (m_markStack) {
+        markAllocatedDuringGC(m->as<Heap::Base>());
     }
 
     return *m;
@@ -798,6 +1063,25 @@ void MarkStack::drain()
     }
 }
 
+MarkStack::DrainState MarkStack::drain(QDeadlineTimer deadline)
+{
+    // Querying the clock is not free. Only do it every so often.
+    enum { DeadlineCheckInterval = 256 };
+
+    do {
+        for (int i = 0; i < DeadlineCheckInterval; ++i) {
+            if (m_top == m_base)
+                return DrainState::Complete;
+            Heap::Base *h = pop();
+            ++markStackSize;
+            Q_ASSERT(h);
+            h->internalClass->vtable->markObjects(h, this);
+        }
+    } while (!deadline.hasExpired());
+
+    return m_top == m_base ? DrainState::Complete : DrainState::Ongoing;
+}
+
 void MemoryManager::collectRoots(MarkStack *markStack)
 {
     engine->markObjects(markStack);
@@ -805,6 +1089,7 @@ void MemoryManager::collectRoots(MarkStack *markStack)
 //    qDebug() << "   mark stack after engine->mark" << (engine->jsStackTop - markBase);
 
     collectFromJSStack(markStack);
+    collectFromGeneratorFrames(markStack);
 
 //    qDebug() << "   mark stack after js stack collect" << (engine->jsStackTop - markBase);
     m_persistentValues->mark(markStack);
@@ -842,14 +1127,178 @@ void MemoryManager::collectRoots(MarkStack *markStack)
 
 void MemoryManager::mark()
 {
+    if (m_markStack) {
+        // Finish the ongoing incremental cycle. The roots may have changed since it was started,
+        // so they have to be scanned again. Everything marked so far stays marked.
+        for (Heap::Base *b : m_allocatedDuringGC)
+            m_markStack->push(b);
+        m_allocatedDuringGC.clear();
+        collectRoots(m_markStack.get());
+        m_markStack->drain();
+        m_markStack.reset();
+        engine->isGCOngoing = false;
+        return;
+    }
+
     markStackSize = 0;
     MarkStack markStack(engine);
     collectRoots(&markStack);
     // dtor of MarkStack drains
 }
 
+bool MemoryManager::runGCSlice(std::chrono::microseconds budget)
+{
+    if (gcBlocked || runningFinalizers)
+        return false;
+
+    {
+        QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+        const QDeadlineTimer deadline(budget, Qt::PreciseTimer);
+
+        if (!m_markStack) {
+            finishBackgroundSweep();
+            markStackSize = 0;
+            m_markStack = std::make_unique<MarkStack>(engine);
+            engine->isGCOngoing = true;
+            collectRoots(m_markStack.get());
+        }
+
+        for (Heap::Base *b : m_allocatedDuringGC)
+            m_markStack->push(b);
+        m_allocatedDuringGC.clear();
+
+        if (m_markStack->drain(deadline) == MarkStack::DrainState::Ongoing)
+            return false;
+    }
+
+    // Marking has caught up with the mutator. Rescan the roots, finish marking and sweep.
+    runGC();
+    return true;
+}
+
+void MemoryManager::shade(Heap::Base *b)
+{
+    Q_ASSERT(m_markStack);
+    b->mark(m_markStack.get());
+}
+
+void MemoryManager::abortIncrementalGC()
+{
+    if (!m_markStack)
+        return;
+
+    m_markStack->clear();
+    m_markStack.reset();
+    m_allocatedDuringGC.clear();
+    engine->isGCOngoing = false;
+
+    blockAllocator.resetBlackBits();
+    hugeItemAllocator.resetBlackBits();
+    icAllocator.resetBlackBits();
+}
+
+void WriteBarrier::shade(EngineBase *engine, Heap::Base *value)
+{
+    engine->memoryManager->shade(value);
+}
+
+void WriteBarrier::shade(EngineBase *engine, ReturnedValue value)
+{
+    if (Heap::Base *b = Value::fromReturnedValue(value).heapObject())
+        engine->memoryManager->shade(b);
+}
+
+void MemoryManager::runMinorGC()
+{
+    if (gcBlocked)
+        return;
+
+    Q_ASSERT(generationalGC);
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+
+    QElapsedTimer t;
+    if (gcCollectorStats)
+        t.start();
+    const size_t nurserySlots = m_nurserySlots;
+    const size_t rememberedObjects = m_rememberedSet.size();
+    const size_t usedBefore = gcCollectorStats ? getUsedMem() : 0;
+
+    markStackSize = 0;
+    {
+        // Old objects are marked already, so marking stops at them. The young objects they
+        // reference have been put into the remembered set by the write barrier.
+        MarkStack markStack(engine);
+        for (Heap::Base *b : m_rememberedSet)
+            b->internalClass->vtable->markObjects(b, &markStack);
+        m_rememberedSet.clear();
+        markStack.drain();
+        collectRoots(&markStack);
+        // dtor of MarkStack drains
+    }
+    const qint64 markTime = gcCollectorStats ? t.nsecsElapsed() / 1000 : 0;
+    if (gcCollectorStats)
+        t.restart();
+
+    // Everything that survives is old from now on.
+    sweep();
+    m_nurserySlots = 0;
+    usedSlotsAfterLastMinorSweep = blockAllocator.usedSlotsAfterLastSweep
+            + icAllocator.usedSlotsAfterLastSweep;
+
+    if (gcCollectorStats) {
+        const qint64 sweepTime = t.nsecsElapsed() / 1000;
+        const QLoggingCategory &stats = lcGcAllocatorStats();
+        qDebug(stats) << "========== Minor GC ==========";
+        qDebug(stats) << "Nursery size" << nurserySlots * Chunk::SlotSize << "bytes";
+        qDebug(stats) << "Remembered objects" << rememberedObjects;
+        qDebug(stats) << "Marked object in" << markTime << "us.";
+        qDebug(stats) << "   " << markStackSize << "objects marked";
+        qDebug(stats) << "Sweeped object in" << sweepTime << "us.";
+        qDebug(stats) << "Freed up bytes      :" << (usedBefore - getUsedMem());
+        qDebug(stats) << "Old generation      :" << usedSlotsAfterLastMinorSweep * Chunk::SlotSize;
+        qDebug(stats) << "====== End Minor GC ======";
+    }
+}
+
+void MemoryManager::remember(Heap::Base *base, Heap::Base *value)
+{
+    Q_ASSERT(generationalGC);
+    if (value->isMarked() || (base && !base->isMarked()))
+        return; // not an old-to-young reference
+
+    value->setMarkBit();
+    m_rememberedSet.push_back(value);
+}
+
+void WriteBarrier::remember(EngineBase *engine, Heap::Base *base, Heap::Base *value)
+{
+    engine->memoryManager->remember(base, value);
+}
+
+void WriteBarrier::remember(EngineBase *engine, Heap::Base *base, ReturnedValue value)
+{
+    if (Heap::Base *b = Value::fromReturnedValue(value).heapObject())
+        engine->memoryManager->remember(base, b);
+}
+
+// Turns all objects young again, so that a full collection or the final sweep can see which ones
+// are still alive.
+void MemoryManager::resetGenerations()
+{
+    m_rememberedSet.clear();
+    m_nurserySlots = 0;
+    blockAllocator.resetBlackBits();
+    hugeItemAllocator.resetBlackBits();
+    icAllocator.resetBlackBits();
+}
+
 void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr)
 {
+    // The megamorphic lookup cache doesn't keep internal classes alive, and we are about to
+    // free the unmarked ones.
+    if (engine->megamorphicLookupCache)
+        engine->megamorphicLookupCache->clear();
+
     for (PersistentValueStorage::Iterator it = m_weakValues->begin(); it != m_weakValues->end(); ++it) {
         Managed *m = (*it).managed();
         if (!m || m->markBit())
@@ -919,12 +1368,55 @@ void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPt
 
     if (!lastSweep) {
         engine->identifierTable->sweep();
-        blockAllocator.sweep(/*classCountPtr*/);
-        hugeItemAllocator.sweep(classCountPtr);
-        icAllocator.sweep(/*classCountPtr*/);
+        if (concurrentSweep) {
+            hugeItemAllocator.sweep(classCountPtr);
+            // The dead items in the block allocator still need their internal classes, so those
+            // are only swept once the background sweep is done. Until then, make sure they
+            // cannot be revived through the transitions of live classes.
+            unlinkUnmarkedInternalClasses();
+            blockAllocator.startBackgroundSweep();
+        } else {
+            blockAllocator.sweep(/*classCountPtr*/);
+            hugeItemAllocator.sweep(classCountPtr, /*keepBlackBits*/generationalGC);
+            icAllocator.sweep(/*classCountPtr*/);
+        }
     }
 }
 
+void MemoryManager::unlinkUnmarkedInternalClasses()
+{
+    for (Chunk *c : icAllocator.chunks) {
+        HeapItem *o = c->realBase();
+        for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+            quintptr unmarked = c->objectBitmap[i] & ~c->blackBitmap[i];
+            while (unmarked) {
+                const uint index = qCountTrailingZeroBits(unmarked);
+                unmarked &= unmarked - 1;
+                Heap::Base *b = *(o + index);
+                static_cast<Heap::InternalClass *>(b)->unlinkFromTransitions();
+            }
+            o += Chunk::Bits;
+        }
+    }
+}
+
+void MemoryManager::finishBackgroundSweep()
+{
+    // Finalizers that allocate end up in here. The outermost call has to finish the sweep, as the
+    // finalizers still need the internal classes.
+    if (!blockAllocator.isBackgroundSweepPending() || runningFinalizers)
+        return;
+
+    blockAllocator.finishBackgroundSweep();
+    runDeferredFinalizers();
+
+    // All finalizers have run now. The internal classes can be swept.
+    icAllocator.sweep();
+    icAllocator.resetBlackBits();
+    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep
+            + icAllocator.usedSlotsAfterLastSweep;
+}
+
 bool MemoryManager::shouldRunGC() const
 {
     size_t total = blockAllocator.totalSlots() + icAllocator.totalSlots();
@@ -933,6 +1425,14 @@ bool MemoryManager::shouldRunGC() const
     return false;
 }
 
+// In generational mode, the old generation is only collected once it has grown beyond the usual
+// overallocation since the last full collection.
+bool MemoryManager::shouldRunFullGC() const
+{
+    const size_t limit = std::max(usedSlotsAfterLastFullSweep, size_t(MinSlotsGCLimit));
+    return usedSlotsAfterLastMinorSweep * 100 > limit * GCOverallocation;
+}
+
 static size_t dumpBins(BlockAllocator *b, const char *title)
 {
     const QLoggingCategory &stats = lcGcAllocatorStats();
@@ -962,9 +1462,20 @@ static size_t dumpBins(BlockAllocator *b, const char *title)
     return totalSlotMem*Chunk::SlotSize;
 }
 
+void MemoryManager::runDeferredFinalizers()
+{
+    if (runningFinalizers)
+        return; // the outer call picks up the finalizers added in the meantime
+
+    // Finalizers may allocate. Collections have to wait until all of them have run, as they
+    // would otherwise sweep the items that are still waiting for their finalizers.
+    QScopedValueRollback<bool> blocker(runningFinalizers, true);
+    blockAllocator.runDeferredFinalizers();
+}
+
 void MemoryManager::runGC()
 {
-    if (gcBlocked) {
+    if (gcBlocked || runningFinalizers) {
 //        qDebug() << "Not running GC.";
         return;
     }
@@ -972,6 +1483,10 @@ void MemoryManager::runGC()
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    finishBackgroundSweep();
+    if (generationalGC)
+        resetGenerations();
+
     if (gcStats) {
         statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
         statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
@@ -1068,11 +1583,21 @@ void MemoryManager::runGC()
                  == icAllocator.usedMem() + dumpBins(&icAllocator, nullptr));
     }
 
-    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+    if (generationalGC) {
+        // All survivors are old now, and stay marked.
+        usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep
+                + icAllocator.usedSlotsAfterLastSweep;
+        usedSlotsAfterLastMinorSweep = usedSlotsAfterLastFullSweep;
+        return;
+    }
 
     // reset all black bits
-    blockAllocator.resetBlackBits();
     hugeItemAllocator.resetBlackBits();
+    if (blockAllocator.isBackgroundSweepPending())
+        return; // the rest happens in finishBackgroundSweep()
+
+    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+    blockAllocator.resetBlackBits();
     icAllocator.resetBlackBits();
 }
 
@@ -1105,10 +1630,14 @@ void MemoryManager::registerWeakSet(Heap::SetObject *set)
 
 MemoryManager::~MemoryManager()
 {
+    abortIncrementalGC();
+    finishBackgroundSweep();
     delete m_persistentValues;
 
     dumpStats();
 
+    if (generationalGC)
+        resetGenerations();
     sweep(/*lastSweep*/true);
     blockAllocator.freeAll();
     hugeItemAllocator.freeAll();
@@ -1153,6 +1682,25 @@ void MemoryManager::collectFromJSStack(MarkStack *markStack) const
     }
 }
 
+// Generators run on frames of their own, which live in the heap rather than on the JS stack. The
+// interpreter writes the registers of such a frame without the write barrier, so the frames of
+// generators that are executing right now are roots as well.
+void MemoryManager::collectFromGeneratorFrames(MarkStack *markStack) const
+{
+    for (CppStackFrame *f = engine->currentStackFrame; f; f = f->parentFrame()) {
+        if (!f->isJSTypesFrame())
+            continue;
+        JSTypesStackFrame *frame = static_cast<JSTypesStackFrame *>(f);
+        Value *v = reinterpret_cast<Value *>(frame->jsFrame);
+        if (v >= engine->jsStackBase && v < engine->jsStackTop)
+            continue;
+        for (Value *end = v + frame->requiredJSStackFrameSize(); v < end; ++v) {
+            if (Managed *m = v->managed())
+                m->mark(markStack);
+        }
+    }
+}
+
 } // namespace QV4
 
 QT_END_NAMESPACE
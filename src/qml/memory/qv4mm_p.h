@@ -22,6 +22,9 @@
 #include <private/qv4mmdefs_p.h>
 #include <QVector>
 
+#include <chrono>
+#include <memory>
+
 #define MM_DEBUG 0
 
 QT_BEGIN_NAMESPACE
@@ -30,6 +33,7 @@ namespace QV4 {
 
 struct ChunkAllocator;
 struct MemorySegment;
+struct BackgroundSweep;
 
 struct BlockAllocator {
     BlockAllocator(ChunkAllocator *chunkAllocator, ExecutionEngine *engine)
@@ -47,11 +51,11 @@ struct BlockAllocator {
     HeapItem *allocate(size_t size, bool forceAllocation = false);
 
     size_t totalSlots() const {
-        return Chunk::AvailableSlots*chunks.size();
+        return Chunk::AvailableSlots*(chunks.size() + nChunksBeingSwept);
     }
 
     size_t allocatedMem() const {
-        return chunks.size()*Chunk::DataSize;
+        return (chunks.size() + nChunksBeingSwept)*Chunk::DataSize;
     }
     size_t usedMem() const {
         uint used = 0;
@@ -64,6 +68,16 @@ struct BlockAllocator {
     void freeAll();
     void resetBlackBits();
 
+    // Background sweeping. All chunks are handed over to a worker thread that frees dead items
+    // and rebuilds the free lists. Allocation adopts the swept chunks one by one. The finalizers
+    // of their dead items are deferred, and run on the engine's thread outside of allocate().
+    void startBackgroundSweep();
+    bool adoptSweptChunk();
+    void finishBackgroundSweep();
+    bool isBackgroundSweepPending() const { return backgroundSweep != nullptr; }
+    void runDeferredFinalizers();
+    bool hasDeferredFinalizers() const { return !deferredFinalizers.empty(); }
+
     // bump allocations
     HeapItem *nextFree = nullptr;
     size_t nFree = 0;
@@ -73,6 +87,9 @@ struct BlockAllocator {
     ExecutionEngine *engine;
     std::vector<Chunk *> chunks;
     uint *allocationStats = nullptr;
+    std::shared_ptr<BackgroundSweep> backgroundSweep;
+    size_t nChunksBeingSwept = 0;
+    std::vector<HeapItem *> deferredFinalizers;
 };
 
 struct HugeItemAllocator {
@@ -81,7 +98,7 @@ struct HugeItemAllocator {
     {}
 
     HeapItem *allocate(size_t size);
-    void sweep(ClassDestroyStatsCallback classCountPtr);
+    void sweep(ClassDestroyStatsCallback classCountPtr, bool keepBlackBits = false);
     void freeAll();
     void resetBlackBits();
 
@@ -244,6 +261,32 @@ public:
 
     void runGC();
 
+    // Incremental garbage collection. A collection cycle is split into slices of bounded
+    // duration: marking makes progress in each slice while the write barrier keeps track of
+    // mutations in between. The last slice rescans the roots, finishes marking and sweeps.
+    bool isIncrementalGCEnabled() const { return incrementalGC; }
+    bool isGCInProgress() const { return m_markStack != nullptr; }
+    std::chrono::microseconds gcSliceBudget() const { return m_gcSliceBudget; }
+    void setGCSliceBudget(std::chrono::microseconds budget) { m_gcSliceBudget = budget; }
+
+    // Starts a collection cycle if none is in progress and runs marking for at most \a budget.
+    // Returns true if the cycle has been completed by this slice.
+    bool runGCSlice(std::chrono::microseconds budget);
+    bool runGCSlice() { return runGCSlice(m_gcSliceBudget); }
+
+    // Called by the write barrier for objects stored into the heap during a mark phase.
+    void shade(Heap::Base *b);
+
+    // Generational garbage collection. Objects that survive a collection are old and stay marked
+    // until the next full collection. Minor collections only free young objects. They mark from
+    // the roots and from the remembered set, which the write barrier fills with young objects
+    // stored into old ones.
+    bool isGenerationalGCEnabled() const { return generationalGC; }
+    void runMinorGC();
+
+    // Called by the write barrier in generational mode.
+    void remember(Heap::Base *base, Heap::Base *value);
+
     void dumpStats() const;
 
     size_t getUsedMem() const;
@@ -258,6 +301,12 @@ public:
     typename ManagedType::Data *allocIC()
     {
         Heap::Base *b = *allocate(&icAllocator, align(sizeof(typename ManagedType::Data)));
+        if (m_markStack)
+            markAllocatedDuringGC(b);
+        else if (blockAllocator.isBackgroundSweepPending())
+            b->setMarkBit(); // internal classes are swept once the background sweep is done
+        else if (generationalGC)
+            rememberAllocatedOld(b); // internal classes are only collected by full collections
         return static_cast<typename ManagedType::Data *>(b);
     }
 
@@ -272,26 +321,71 @@ protected:
 
 private:
     enum {
-        MinUnmanagedHeapSizeGCLimit = 128 * 1024
+        MinUnmanagedHeapSizeGCLimit = 128 * 1024,
+        NurserySlotsLimit = Chunk::AvailableSlots * 16
     };
 
     void collectFromJSStack(MarkStack *markStack) const;
+    void collectFromGeneratorFrames(MarkStack *markStack) const;
     void mark();
     void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
     bool shouldRunGC() const;
+    bool shouldRunFullGC() const;
+    void resetGenerations();
     void collectRoots(MarkStack *markStack);
+    void abortIncrementalGC();
+    void unlinkUnmarkedInternalClasses();
+    void finishBackgroundSweep();
+    void runDeferredFinalizers();
+
+    // Objects allocated during an incremental mark phase are born marked, but still need to be
+    // scanned later on, as their members are not necessarily written through the barrier.
+    void markAllocatedDuringGC(Heap::Base *b)
+    {
+        b->setMarkBit();
+        m_allocatedDuringGC.push_back(b);
+    }
+
+    // Objects allocated as old ones still need to be scanned once, as they are initialized
+    // without going through the write barrier.
+    void rememberAllocatedOld(Heap::Base *b)
+    {
+        b->setMarkBit();
+        m_rememberedSet.push_back(b);
+    }
+
+    void triggerGC()
+    {
+        if (incrementalGC)
+            runGCSlice();
+        else if (generationalGC && !shouldRunFullGC())
+            runMinorGC();
+        else
+            runGC();
+    }
 
     HeapItem *allocate(BlockAllocator *allocator, std::size_t size)
     {
+        if (Q_UNLIKELY(blockAllocator.hasDeferredFinalizers()) && !gcBlocked)
+            runDeferredFinalizers();
+
         bool didGCRun = false;
         if (aggressiveGC) {
             runGC();
             didGCRun = true;
         }
 
+        if (Q_UNLIKELY(generationalGC) && allocator != &icAllocator) {
+            m_nurserySlots += size >> Chunk::SlotSizeShift;
+            if (m_nurserySlots > NurserySlotsLimit && !didGCRun) {
+                triggerGC();
+                didGCRun = true;
+            }
+        }
+
         if (unmanagedHeapSize > unmanagedHeapSizeGCLimit) {
             if (!didGCRun)
-                runGC();
+                triggerGC();
 
             if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
                 // more than 75% full, raise limit
@@ -311,8 +405,10 @@ private:
         if (HeapItem *m = allocator->allocate(size))
             return m;
 
+        finishBackgroundSweep();
+
         if (!didGCRun && shouldRunGC())
-            runGC();
+            triggerGC();
 
         return allocator->allocate(size, true);
     }
@@ -332,11 +428,23 @@ public:
     std::size_t unmanagedHeapSize = 0; // the amount of bytes of heap that is not managed by the memory manager, but which is held onto by managed items.
     std::size_t unmanagedHeapSizeGCLimit;
     std::size_t usedSlotsAfterLastFullSweep = 0;
+    std::size_t usedSlotsAfterLastMinorSweep = 0;
 
     bool gcBlocked = false;
+    bool runningFinalizers = false; // collections are postponed until they are done
     bool aggressiveGC = false;
     bool gcStats = false;
     bool gcCollectorStats = false;
+    bool generationalGC = false;
+    bool incrementalGC = false;
+    bool concurrentSweep = false;
+
+    std::unique_ptr<MarkStack> m_markStack;
+    std::vector<Heap::Base *> m_allocatedDuringGC;
+    std::chrono::microseconds m_gcSliceBudget;
+
+    std::vector<Heap::Base *> m_rememberedSet;
+    std::size_t m_nurserySlots = 0; // allocated since the last collection
 
     int allocationCount = 0;
     size_t lastAllocRequestedSlots = 0;
@@ -17,8 +17,11 @@
 #include <private/qv4global_p.h>
 #include <private/qv4runtimeapi_p.h>
 #include <QtCore/qalgorithms.h>
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qmath.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
@@ -152,6 +155,7 @@ struct Chunk {
     bool sweep(ClassDestroyStatsCallback classCountPtr);
     void resetBlackBits();
     bool sweep(ExecutionEngine *engine);
+    bool sweepDeferringFinalizers(std::vector<HeapItem *> *finalizers);
     void freeAll(ExecutionEngine *engine);
 
     void sortIntoBins(HeapItem **bins, uint nBins);
@@ -251,10 +255,18 @@ struct Q_QML_PRIVATE_EXPORT MarkStack {
     }
 
     ExecutionEngine *engine() const { return m_engine; }
+    bool isEmpty() const { return m_top == m_base; }
+    void clear() { m_top = m_base; }
+
+    enum class DrainState { Ongoing, Complete };
+
+    // Drains the stack until it is empty or the deadline has expired. Used for the time-sliced
+    // mark phase of the incremental garbage collector.
+    DrainState drain(QDeadlineTimer deadline);
+    void drain();
 
 private:
     Heap::Base *pop() { return *(--m_top); }
-    void drain();
 
     Heap::Base **m_top = nullptr;
     Heap::Base **m_base = nullptr;
@@ -15,15 +15,15 @@
 //
 
 #include <private/qv4global_p.h>
+#include <private/qv4enginebase_p.h>
 
 QT_BEGIN_NAMESPACE
 
-#define WRITEBARRIER_none 1
+#define WRITEBARRIER_dijkstra 1
 
 #define WRITEBARRIER(x) (1/WRITEBARRIER_##x == 1)
 
 namespace QV4 {
-struct EngineBase;
 
 namespace WriteBarrier {
 
@@ -41,25 +41,65 @@ enum NewValueType {
 // ### this needs to be filled with a real memory fence once marking is concurrent
 Q_ALWAYS_INLINE void fence() {}
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(dijkstra)
+
+/*
+   Insertion barrier for the incremental garbage collector. While a mark phase is in
+   progress, every heap object that gets stored into another heap object is shaded
+   (marked and queued for scanning). This way an object that was already scanned can
+   never end up being the only reference to an unmarked one.
+
+   In generational mode, the same hooks feed the remembered set instead: a young object
+   stored into an old one is promoted and scanned by the next minor collection.
+*/
 
 template <NewValueType type>
 static constexpr inline bool isRequired() {
-    return false;
+    return type != Primitive;
+}
+
+Q_QML_EXPORT void shade(EngineBase *engine, Heap::Base *value);
+Q_QML_EXPORT void shade(EngineBase *engine, ReturnedValue value);
+
+// \a base may be nullptr if the reference is held by something other than a heap object, for
+// example an internal class's shared data. The value is then always remembered.
+Q_QML_EXPORT void remember(EngineBase *engine, Heap::Base *base, Heap::Base *value);
+Q_QML_EXPORT void remember(EngineBase *engine, Heap::Base *base, ReturnedValue value);
+
+inline bool isActive(const EngineBase *engine)
+{
+    return engine->isGCOngoing || engine->isGenerationalGC;
+}
+
+// For references stored into memory owned by \a base that cannot be written through write(),
+// for example the tables of maps and sets.
+inline void barrier(EngineBase *engine, Heap::Base *base, ReturnedValue value)
+{
+    if (Q_UNLIKELY(engine->isGCOngoing))
+        shade(engine, value);
+    else if (Q_UNLIKELY(engine->isGenerationalGC))
+        remember(engine, base, value);
+}
+
+inline void barrier(EngineBase *engine, Heap::Base *base, Heap::Base *value)
+{
+    if (Q_UNLIKELY(engine->isGCOngoing))
+        shade(engine, value);
+    else if (Q_UNLIKELY(engine->isGenerationalGC))
+        remember(engine, base, value);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, ReturnedValue *slot, ReturnedValue value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    barrier(engine, base, value);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap::Base *value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    if (Q_UNLIKELY(isActive(engine)) && value)
+        barrier(engine, base, value);
 }
 
 #endif
@@ -31,6 +31,7 @@ public:
     inline void prepend(N *);
     template <typename OtherTag>
     inline void copyAndClearPrepend(QForwardFieldList<N, nextMember, OtherTag> &);
+    inline void reverse();
 
     inline bool isEmpty() const;
     inline bool isOne() const;
@@ -123,6 +124,20 @@ void QForwardFieldList<N, nextMember, Tag>::copyAndClearPrepend(QForwardFieldLis
     while (N *n = o.takeFirst()) prepend(n);
 }
 
+template<class N, N *N::*nextMember, typename Tag>
+void QForwardFieldList<N, nextMember, Tag>::reverse()
+{
+    N *reversed = nullptr;
+    N *n = _first.data();
+    while (n) {
+        N *following = n->*nextMember;
+        n->*nextMember = reversed;
+        reversed = n;
+        n = following;
+    }
+    _first = reversed;
+}
+
 template<class N, N *N::*nextMember, typename Tag>
 bool QForwardFieldList<N, nextMember, Tag>::isEmpty() const
 {
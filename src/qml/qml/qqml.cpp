@@ -1360,7 +1360,7 @@ static ObjectLookupResult initObjectLookup(
 {
     QV4::Scope scope(aotContext->engine->handle());
     QV4::PropertyKey id = scope.engine->identifierTable->asPropertyKey(
-                aotContext->compilationUnit->runtimeStrings[l->nameIndex]);
+                aotContext->compilationUnit->runtimeString(l->nameIndex));
 
     Q_ASSERT(id.isString());
 
@@ -1425,7 +1425,7 @@ static bool initValueLookup(QV4::Lookup *l, QV4::ExecutableCompilationUnit *comp
                             const QMetaObject *metaObject, QMetaType type)
 {
     Q_ASSERT(metaObject);
-    const QByteArray name = compilationUnit->runtimeStrings[l->nameIndex]->toQString().toUtf8();
+    const QByteArray name = compilationUnit->runtimeString(l->nameIndex)->toQString().toUtf8();
     const int coreIndex = metaObject->indexOfProperty(name.constData());
     QMetaType lookupType = metaObject->property(coreIndex).metaType();
     if (!isTypeCompatible(type, lookupType))
@@ -1465,7 +1465,7 @@ bool AOTCompiledContext::captureLookup(uint index, QObject *object) const
     if (!object)
         return false;
 
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->getter == QV4::QQmlTypeWrapper::lookupSingletonProperty
             || l->getter == QV4::Lookup::getterQObject
             || l->getter == QV4::Lookup::getterQObjectAsVariant) {
@@ -1490,7 +1490,7 @@ bool AOTCompiledContext::captureLookup(uint index, QObject *object) const
 
 bool AOTCompiledContext::captureQmlContextPropertyLookup(uint index) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->qmlContextPropertyGetter == QV4::QQmlContextWrapper::lookupScopeObjectProperty
             && l->qmlContextPropertyGetter == QV4::QQmlContextWrapper::lookupContextObjectProperty) {
         const QQmlPropertyData *property = l->qobjectLookup.propertyData;
@@ -1527,7 +1527,7 @@ QString AOTCompiledContext::translationContext() const
 
 QMetaType AOTCompiledContext::lookupResultMetaType(uint index) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->qmlContextPropertyGetter == QV4::QQmlContextWrapper::lookupScopeObjectProperty
             || l->qmlContextPropertyGetter == QV4::QQmlContextWrapper::lookupContextObjectProperty
             || l->getter == QV4::QQmlTypeWrapper::lookupSingletonProperty
@@ -1640,7 +1640,7 @@ void AOTCompiledContext::storeNameSloppy(uint nameIndex, void *value, QMetaType
 QJSValue AOTCompiledContext::javaScriptGlobalProperty(uint nameIndex) const
 {
     QV4::Scope scope(engine->handle());
-    QV4::ScopedString name(scope, compilationUnit->runtimeStrings[nameIndex]);
+    QV4::ScopedString name(scope, compilationUnit->runtimeString(nameIndex));
     QV4::ScopedObject global(scope, scope.engine->globalObject);
     return QJSValuePrivate::fromReturnedValue(global->get(name->toPropertyKey()));
 }
@@ -1726,7 +1726,7 @@ QDateTime AOTCompiledContext::constructDateTime(
 bool AOTCompiledContext::callQmlContextPropertyLookup(
         uint index, void **args, const QMetaType *types, int argc) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     QV4::Scope scope(engine->handle());
     QV4::ScopedValue thisObject(scope);
     QV4::ScopedFunctionObject function(
@@ -1734,7 +1734,7 @@ bool AOTCompiledContext::callQmlContextPropertyLookup(
     if (!function) {
         scope.engine->throwTypeError(
                     QStringLiteral("Property '%1' of object [null] is not a function").arg(
-                        compilationUnit->runtimeStrings[l->nameIndex]->toQString()));
+                        compilationUnit->runtimeString(l->nameIndex)->toQString()));
         return false;
     }
 
@@ -1751,7 +1751,7 @@ void AOTCompiledContext::initCallQmlContextPropertyLookup(uint index) const
 
 bool AOTCompiledContext::loadContextIdLookup(uint index, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     int objectId = -1;
     QQmlContextData *context = nullptr;
     Q_ASSERT(qmlContext);
@@ -1762,7 +1762,7 @@ bool AOTCompiledContext::loadContextIdLookup(uint index, void *target) const
     } else if (l->qmlContextPropertyGetter
                == QV4::QQmlContextWrapper::lookupIdObjectInParentContext) {
         QV4::Scope scope(engine->handle());
-        QV4::ScopedString name(scope, compilationUnit->runtimeStrings[l->nameIndex]);
+        QV4::ScopedString name(scope, compilationUnit->runtimeString(l->nameIndex));
         for (context = qmlContext; context; context = context->parent().data()) {
             objectId = context->propertyIndex(name);
             if (objectId != -1 && objectId < context->numIdValues())
@@ -1784,9 +1784,9 @@ bool AOTCompiledContext::loadContextIdLookup(uint index, void *target) const
 void AOTCompiledContext::initLoadContextIdLookup(uint index) const
 {
     Q_ASSERT(!engine->hasError());
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     QV4::Scope scope(engine->handle());
-    QV4::ScopedString name(scope, compilationUnit->runtimeStrings[l->nameIndex]);
+    QV4::ScopedString name(scope, compilationUnit->runtimeString(l->nameIndex));
     const QQmlRefPointer<QQmlContextData> ownContext = qmlContext;
     for (auto context = ownContext; context; context = context->parent()) {
         const int propertyIdx = context->propertyIndex(name);
@@ -1806,17 +1806,81 @@ void AOTCompiledContext::initLoadContextIdLookup(uint index) const
     Q_UNREACHABLE();
 }
 
+bool AOTCompiledContext::loadEnclosingContextIdLookup(uint index, void *target) const
+{
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
+    if (l->qmlContextPropertyGetter != QV4::QQmlContextWrapper::lookupIdObjectInParentContext)
+        return false;
+
+    Q_ASSERT(qmlContext);
+
+    // The compiler has determined which enclosing component of this document the id belongs to.
+    // Find the context of that component without hashing the name on each access.
+    const int componentObjectIndex = l->qmlContextIdObjectLookup.componentObjectIndex;
+    QQmlContextData *context = qmlContext->parent().data();
+    while (context && !context->isComponentContext(compilationUnit, componentObjectIndex))
+        context = context->parent().data();
+
+    int objectId = l->qmlContextIdObjectLookup.objectId;
+    if (!context) {
+        // The component has been created in an unrelated context. Search by name then.
+        QV4::Scope scope(engine->handle());
+        QV4::ScopedString name(scope, compilationUnit->runtimeString(l->nameIndex));
+        for (context = qmlContext->parent().data(); context; context = context->parent().data()) {
+            objectId = context->propertyIndex(name);
+            if (objectId != -1 && objectId < context->numIdValues())
+                break;
+        }
+
+        // Let the initialization throw the reference error.
+        if (!context)
+            return false;
+    }
+
+    Q_ASSERT(objectId >= 0 && objectId < context->numIdValues());
+    QQmlEnginePrivate *engine = QQmlEnginePrivate::get(qmlEngine());
+    if (QQmlPropertyCapture *capture = engine->propertyCapture)
+        capture->captureProperty(context->idValueBindings(objectId));
+    *static_cast<QObject **>(target) = context->idValue(objectId);
+    return true;
+}
+
+void AOTCompiledContext::initLoadEnclosingContextIdLookup(uint index) const
+{
+    Q_ASSERT(!engine->hasError());
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
+    QV4::Scope scope(engine->handle());
+    QV4::ScopedString name(scope, compilationUnit->runtimeString(l->nameIndex));
+    for (QQmlContextData *context = qmlContext->parent().data(); context;
+         context = context->parent().data()) {
+        const int propertyIdx = context->propertyIndex(name);
+        if (propertyIdx == -1 || propertyIdx >= context->numIdValues())
+            continue;
+
+        l->qmlContextIdObjectLookup.objectId = propertyIdx;
+        l->qmlContextIdObjectLookup.componentObjectIndex
+                = context->typeCompilationUnit().data() == compilationUnit
+                    ? context->componentObjectIndex()
+                    : -1;
+        l->qmlContextPropertyGetter = QV4::QQmlContextWrapper::lookupIdObjectInParentContext;
+        return;
+    }
+
+    // The component is not instantiated inside the one declaring the id.
+    scope.engine->throwReferenceError(name->toQString());
+}
+
 bool AOTCompiledContext::callObjectPropertyLookup(
         uint index, QObject *object, void **args, const QMetaType *types, int argc) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     QV4::Scope scope(engine->handle());
     QV4::ScopedValue thisObject(scope, QV4::QObjectWrapper::wrap(scope.engine, object));
     QV4::ScopedFunctionObject function(scope, l->getter(l, engine->handle(), thisObject));
     if (!function) {
         scope.engine->throwTypeError(
                     QStringLiteral("Property '%1' of object [object Object] is not a function")
-                    .arg(compilationUnit->runtimeStrings[l->nameIndex]->toQString()));
+                    .arg(compilationUnit->runtimeString(l->nameIndex)->toQString()));
         return false;
     }
 
@@ -1834,13 +1898,13 @@ void AOTCompiledContext::initCallObjectPropertyLookup(uint index) const
 bool AOTCompiledContext::callGlobalLookup(
         uint index, void **args, const QMetaType *types, int argc) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     QV4::Scope scope(engine->handle());
     QV4::ScopedFunctionObject function(scope, l->globalGetter(l, scope.engine));
     if (!function) {
         scope.engine->throwTypeError(
                     QStringLiteral("Property '%1' of object [null] is not a function")
-                    .arg(compilationUnit->runtimeStrings[l->nameIndex]->toQString()));
+                    .arg(compilationUnit->runtimeString(l->nameIndex)->toQString()));
         return false;
     }
 
@@ -1857,7 +1921,7 @@ void AOTCompiledContext::initCallGlobalLookup(uint index) const
 
 bool AOTCompiledContext::loadGlobalLookup(uint index, void *target, QMetaType type) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (!QV4::ExecutionEngine::metaTypeFromJS(l->globalGetter(l, engine->handle()), type, target)) {
         engine->handle()->throwTypeError();
         return false;
@@ -1874,11 +1938,11 @@ void AOTCompiledContext::initLoadGlobalLookup(uint index) const
 
 bool AOTCompiledContext::loadScopeObjectPropertyLookup(uint index, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
 
     if (!qmlScopeObject) {
         engine->handle()->throwReferenceError(
-                compilationUnit->runtimeStrings[l->nameIndex]->toQString());
+                compilationUnit->runtimeString(l->nameIndex)->toQString());
         return false;
     }
 
@@ -1896,7 +1960,7 @@ bool AOTCompiledContext::loadScopeObjectPropertyLookup(uint index, void *target)
     case ObjectPropertyResult::Deleted:
         engine->handle()->throwTypeError(
                     QStringLiteral("Cannot read property '%1' of null")
-                    .arg(compilationUnit->runtimeStrings[l->nameIndex]->toQString()));
+                    .arg(compilationUnit->runtimeString(l->nameIndex)->toQString()));
         return false;
     case ObjectPropertyResult::OK:
         return true;
@@ -1907,7 +1971,7 @@ bool AOTCompiledContext::loadScopeObjectPropertyLookup(uint index, void *target)
 
 bool AOTCompiledContext::writeBackScopeObjectPropertyLookup(uint index, void *source) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
 
     ObjectPropertyResult result = ObjectPropertyResult::NeedsInit;
     if (l->qmlContextPropertyGetter == QV4::QQmlContextWrapper::lookupScopeObjectProperty)
@@ -1931,7 +1995,7 @@ bool AOTCompiledContext::writeBackScopeObjectPropertyLookup(uint index, void *so
 void AOTCompiledContext::initLoadScopeObjectPropertyLookup(uint index, QMetaType type) const
 {
     QV4::ExecutionEngine *v4 = engine->handle();
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
 
     if (v4->hasException) {
         amendException(v4);
@@ -1955,7 +2019,7 @@ void AOTCompiledContext::initLoadScopeObjectPropertyLookup(uint index, QMetaType
 
 bool AOTCompiledContext::loadSingletonLookup(uint index, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     QV4::Scope scope(engine->handle());
 
     if (l->qmlContextPropertyGetter == QV4::QQmlContextWrapper::lookupSingleton) {
@@ -1981,7 +2045,7 @@ static void initTypeWrapperLookup(
     Q_ASSERT(!context->engine->hasError());
     if (importNamespace != AOTCompiledContext::InvalidStringId) {
         QV4::Scope scope(context->engine->handle());
-        QV4::ScopedString import(scope, context->compilationUnit->runtimeStrings[importNamespace]);
+        QV4::ScopedString import(scope, context->compilationUnit->runtimeString(importNamespace));
         if (const QQmlImportRef *importRef
                 = context->qmlContext->imports()->query(import).importNamespace) {
             QV4::Scoped<QV4::QQmlTypeWrapper> wrapper(
@@ -2007,7 +2071,7 @@ static void initTypeWrapperLookup(
                           "but is not a singleton anymore."
                         : "%1 was not a singleton at compile time, "
                           "but is a singleton now.")
-                    .arg(context->compilationUnit->runtimeStrings[l->nameIndex]->toQString());
+                    .arg(context->compilationUnit->runtimeString(l->nameIndex)->toQString());
             v4->throwTypeError(error);
         }
     }
@@ -2015,13 +2079,13 @@ static void initTypeWrapperLookup(
 
 void AOTCompiledContext::initLoadSingletonLookup(uint index, uint importNamespace) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     initTypeWrapperLookup<QV4::QQmlContextWrapper::lookupSingleton>(this, l, importNamespace);
 }
 
 bool AOTCompiledContext::loadAttachedLookup(uint index, QObject *object, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->getter != QV4::QObjectWrapper::lookupAttached)
         return false;
 
@@ -2037,13 +2101,13 @@ bool AOTCompiledContext::loadAttachedLookup(uint index, QObject *object, void *t
 void AOTCompiledContext::initLoadAttachedLookup(
         uint index, uint importNamespace, QObject *object) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     QV4::Scope scope(engine->handle());
-    QV4::ScopedString name(scope, compilationUnit->runtimeStrings[l->nameIndex]);
+    QV4::ScopedString name(scope, compilationUnit->runtimeString(l->nameIndex));
 
     QQmlType type;
     if (importNamespace != InvalidStringId) {
-        QV4::ScopedString import(scope, compilationUnit->runtimeStrings[importNamespace]);
+        QV4::ScopedString import(scope, compilationUnit->runtimeString(importNamespace));
         if (const QQmlImportRef *importRef = qmlContext->imports()->query(import).importNamespace)
             type = qmlContext->imports()->query(name, importRef).type;
     } else {
@@ -2065,7 +2129,7 @@ void AOTCompiledContext::initLoadAttachedLookup(
 
 bool AOTCompiledContext::loadTypeLookup(uint index, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->qmlContextPropertyGetter != QV4::QQmlContextWrapper::lookupType)
         return false;
 
@@ -2080,17 +2144,17 @@ bool AOTCompiledContext::loadTypeLookup(uint index, void *target) const
 
 void AOTCompiledContext::initLoadTypeLookup(uint index, uint importNamespace) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     initTypeWrapperLookup<QV4::QQmlContextWrapper::lookupType>(this, l, importNamespace);
 }
 
 bool AOTCompiledContext::getObjectLookup(uint index, QObject *object, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     const auto doThrow = [&]() {
         engine->handle()->throwTypeError(
                     QStringLiteral("Cannot read property '%1' of null")
-                    .arg(compilationUnit->runtimeStrings[l->nameIndex]->toQString()));
+                    .arg(compilationUnit->runtimeString(l->nameIndex)->toQString()));
         return false;
     };
 
@@ -2123,7 +2187,7 @@ bool AOTCompiledContext::getObjectLookup(uint index, QObject *object, void *targ
 
 bool AOTCompiledContext::writeBackObjectLookup(uint index, QObject *object, void *source) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (!object)
         return true;
 
@@ -2156,7 +2220,7 @@ void AOTCompiledContext::initGetObjectLookup(uint index, QObject *object, QMetaT
     if (v4->hasException) {
         amendException(v4);
     } else {
-        QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+        QV4::Lookup *l = compilationUnit->runtimeLookup(index);
         switch (initObjectLookup(this, l, object, type)) {
         case ObjectLookupResult::Object:
             l->getter = QV4::Lookup::getterQObject;
@@ -2181,7 +2245,7 @@ bool AOTCompiledContext::getValueLookup(uint index, void *value, void *target) c
 {
     Q_ASSERT(value);
 
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->getter != QV4::QQmlValueTypeWrapper::lookupGetter)
         return false;
 
@@ -2200,7 +2264,7 @@ bool AOTCompiledContext::writeBackValueLookup(uint index, void *value, void *sou
 {
     Q_ASSERT(value);
 
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->getter != QV4::QQmlValueTypeWrapper::lookupGetter)
         return false;
 
@@ -2219,7 +2283,7 @@ void AOTCompiledContext::initGetValueLookup(
         uint index, const QMetaObject *metaObject, QMetaType type) const
 {
     Q_ASSERT(!engine->hasError());
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (initValueLookup(l, compilationUnit, metaObject, type))
         l->getter = QV4::QQmlValueTypeWrapper::lookupGetter;
     else
@@ -2228,7 +2292,7 @@ void AOTCompiledContext::initGetValueLookup(
 
 bool AOTCompiledContext::getEnumLookup(uint index, void *target) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->getter != QV4::QQmlTypeWrapper::lookupEnumValue)
         return false;
     const bool isUnsigned
@@ -2271,7 +2335,7 @@ void AOTCompiledContext::initGetEnumLookup(
         const char *enumerator, const char *enumValue) const
 {
     Q_ASSERT(!engine->hasError());
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (!metaObject) {
         engine->handle()->throwTypeError(
                     QStringLiteral("Cannot read property '%1' of undefined")
@@ -2296,7 +2360,7 @@ bool AOTCompiledContext::setObjectLookup(uint index, QObject *object, void *valu
     if (!object)
         return doThrow();
 
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     ObjectPropertyResult result = ObjectPropertyResult::NeedsInit;
     if (l->setter == QV4::Lookup::setterQObject)
         result = storeObjectProperty(l, object, value);
@@ -2327,7 +2391,7 @@ void AOTCompiledContext::initSetObjectLookup(uint index, QObject *object, QMetaT
     if (v4->hasException) {
         amendException(v4);
     } else {
-        QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+        QV4::Lookup *l = compilationUnit->runtimeLookup(index);
         switch (initObjectLookup(this, l, object, type)) {
         case ObjectLookupResult::Object:
             l->setter = QV4::Lookup::setterQObject;
@@ -2351,7 +2415,7 @@ void AOTCompiledContext::initSetObjectLookup(uint index, QObject *object, QMetaT
 bool AOTCompiledContext::setValueLookup(
         uint index, void *target, void *value) const
 {
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (l->setter != QV4::QQmlValueTypeWrapper::lookupSetter)
         return false;
 
@@ -2369,7 +2433,7 @@ void AOTCompiledContext::initSetValueLookup(uint index, const QMetaObject *metaO
                                             QMetaType type) const
 {
     Q_ASSERT(!engine->hasError());
-    QV4::Lookup *l = compilationUnit->runtimeLookups + index;
+    QV4::Lookup *l = compilationUnit->runtimeLookup(index);
     if (initValueLookup(l, compilationUnit, metaObject, type))
         l->setter = QV4::QQmlValueTypeWrapper::lookupSetter;
     else
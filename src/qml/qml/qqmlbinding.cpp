@@ -11,6 +11,7 @@
 
 #include <private/qqmlprofiler_p.h>
 #include <private/qqmlexpression_p.h>
+#include <private/qqmlbindingbatch_p.h>
 #include <private/qqmlscriptstring_p.h>
 #include <private/qqmlbuiltinfunctions_p.h>
 #include <private/qqmlvmemetaobject_p.h>
@@ -140,12 +141,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        const QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        reportBindingLoop();
         return;
     }
     setUpdatingFlag(true);
@@ -598,8 +594,24 @@ QVariant QQmlBinding::evaluate()
     return QV4::ExecutionEngine::toVariant(result, QMetaType::fromType<QList<QObject*> >());
 }
 
+void QQmlBinding::reportBindingLoop()
+{
+    const QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, nullptr);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 void QQmlBinding::expressionChanged()
 {
+    if (QQmlEngine *qmlEngine = engine()) {
+        if (QQmlBindingBatch *batch = QQmlEnginePrivate::get(qmlEngine)->bindingBatch) {
+            batch->schedule(this);
+            return;
+        }
+    }
     update();
 }
 
@@ -33,6 +33,7 @@ class Q_QML_PRIVATE_EXPORT QQmlBinding : public QQmlJavaScriptExpression,
                                          public QQmlAbstractBinding
 {
     friend class QQmlAbstractBinding;
+    friend class QQmlBindingBatch;
 public:
     typedef QExplicitlySharedDataPointer<QQmlBinding> Ptr;
 
@@ -127,7 +128,14 @@ private:
 
     QQmlSourceLocation *m_sourceLocation = nullptr; // used for Qt.binding() created functions
     QV4::PersistentValue m_boundFunction; // used for Qt.binding() that are created from a bound function object
+
+    // State of the binding in the engine's QQmlBindingBatch, if any
+    quint16 m_batchRank = 0;
+    quint8 m_batchEvaluations = 0;
+    bool m_batchPending = false;
+
     void handleWriteError(const void *result, QMetaType resultType, QMetaType metaType);
+    void reportBindingLoop();
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,235 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlbindingbatch_p.h"
+
+#include <private/qqmlengine_p.h>
+
+#include <QtCore/qscopedvaluerollback.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcBindingBatch, "qt.qml.binding.batch")
+
+/*!
+    \internal
+    \class QQmlBindingBatch
+
+    When binding batching is enabled for an engine, a change notification does not re-evaluate
+    the bindings depending on the changed property right away. The bindings are marked as
+    pending instead, and evaluated once when the batch is flushed. This happens from a queued
+    call at the end of the current event, or before a QQuickWindow synchronizes its items
+    with the scene graph, whichever comes first.
+
+    Pending bindings are evaluated in the order of their rank. The rank of a binding is
+    raised above the rank of any binding whose evaluation has made it pending. Once the ranks
+    have settled, a binding is only evaluated after all the pending bindings it depends on,
+    and therefore only once per batch. In particular, the bindings in a diamond shaped
+    dependency graph never see inconsistent intermediate values.
+
+    Objects that coalesce their own change notifications, like the data of delegates, can
+    schedule a Notifier with the batch. It emits the deferred change signals at the start of the
+    flush, before the bindings depending on them are evaluated.
+*/
+
+// Batches with pending bindings in the current thread
+Q_CONSTINIT static thread_local QQmlBindingBatch *batchesInThread = nullptr;
+
+QQmlBindingBatch::QQmlBindingBatch(QQmlEngine *engine)
+    : m_engine(engine)
+{
+}
+
+QQmlBindingBatch::~QQmlBindingBatch()
+{
+    clear();
+}
+
+QQmlBindingBatch::Notifier::~Notifier()
+{
+    if (m_batch)
+        m_batch->cancel(this);
+}
+
+void QQmlBindingBatch::schedule(QQmlBinding *binding)
+{
+    ++m_statistics.notifications;
+
+    bool rankRaised = false;
+    if (m_current) {
+        // The binding depends on the one being evaluated right now.
+        const quint16 rank = m_current->m_batchRank == std::numeric_limits<quint16>::max()
+                ? m_current->m_batchRank
+                : m_current->m_batchRank + 1;
+        if (rank > binding->m_batchRank) {
+            binding->m_batchRank = rank;
+            rankRaised = true;
+        }
+    }
+
+    if (binding->m_batchPending) {
+        ++m_statistics.avoided;
+        if (rankRaised)
+            push(binding); // The entry with the old rank is skipped when flushing
+        return;
+    }
+
+    if (binding->m_batchEvaluations >= MaxEvaluationsPerFlush) {
+        binding->reportBindingLoop();
+        return;
+    }
+
+    binding->m_batchPending = true;
+    push(binding);
+    if (!m_flushing)
+        postFlush();
+}
+
+void QQmlBindingBatch::schedule(Notifier *notifier)
+{
+    if (notifier->m_batch == this)
+        return;
+
+    Q_ASSERT(!notifier->m_batch);
+    notifier->m_batch = this;
+    m_notifiers.push_back(notifier);
+    if (!m_flushing)
+        postFlush();
+}
+
+void QQmlBindingBatch::cancel(Notifier *notifier)
+{
+    Q_ASSERT(notifier->m_batch == this);
+    notifier->m_batch = nullptr;
+    m_notifiers.erase(std::find(m_notifiers.begin(), m_notifiers.end(), notifier));
+}
+
+void QQmlBindingBatch::flush()
+{
+    if (m_flushing || isEmpty())
+        return;
+
+    QScopedValueRollback<bool> flushing(m_flushing, true);
+    ++m_statistics.batches;
+    const quint64 evaluationsBefore = m_statistics.evaluations;
+
+    while (!isEmpty()) {
+        if (!m_notifiers.empty()) {
+            // Emitting may schedule further notifiers, or destroy pending ones.
+            Notifier *notifier = m_notifiers.front();
+            m_notifiers.erase(m_notifiers.begin());
+            notifier->m_batch = nullptr;
+            notifier->emitDeferredNotifications();
+            continue;
+        }
+
+        std::pop_heap(m_pending.begin(), m_pending.end());
+        Entry entry = std::move(m_pending.back());
+        m_pending.pop_back();
+
+        QQmlBinding *binding = entry.binding.data();
+        if (!binding->m_batchPending || binding->m_batchRank != entry.rank)
+            continue;
+
+        binding->m_batchPending = false;
+
+        // The binding has been removed from its target since it was scheduled, or the target
+        // has been destroyed. Only the pending entry keeps it alive.
+        if (!binding->isAddedToObject())
+            continue;
+
+        ++binding->m_batchEvaluations;
+        ++m_statistics.evaluations;
+        m_evaluated.push_back(std::move(entry.binding));
+
+        m_current = binding;
+        binding->update();
+        m_current = nullptr;
+    }
+
+    for (const QQmlBinding::Ptr &binding : m_evaluated)
+        binding->m_batchEvaluations = 0;
+    m_evaluated.clear();
+    m_sequence = 0;
+    unlink();
+
+    qCDebug(lcBindingBatch) << "Evaluated" << (m_statistics.evaluations - evaluationsBefore)
+                            << "bindings," << m_statistics.avoided
+                            << "evaluations avoided in total";
+}
+
+void QQmlBindingBatch::clear()
+{
+    for (const Entry &entry : m_pending)
+        entry.binding->m_batchPending = false;
+    m_pending.clear();
+    for (Notifier *notifier : m_notifiers)
+        notifier->m_batch = nullptr;
+    m_notifiers.clear();
+    m_sequence = 0;
+    unlink();
+}
+
+void QQmlBindingBatch::flushAll()
+{
+    QQmlBindingBatch *batch = batchesInThread;
+    while (batch) {
+        if (batch->m_flushing) {
+            batch = batch->m_nextInThread;
+            continue;
+        }
+
+        // Flushing removes the batch from the list, and may change the other entries.
+        batch->flush();
+        batch = batchesInThread;
+    }
+}
+
+void QQmlBindingBatch::push(QQmlBinding *binding)
+{
+    m_pending.push_back({ binding->m_batchRank, m_sequence++, QQmlBinding::Ptr(binding) });
+    std::push_heap(m_pending.begin(), m_pending.end());
+}
+
+void QQmlBindingBatch::postFlush()
+{
+    link();
+    if (m_flushPosted)
+        return;
+
+    m_flushPosted = true;
+    QMetaObject::invokeMethod(m_engine, [engine = m_engine]() {
+        if (QQmlBindingBatch *batch = QQmlEnginePrivate::get(engine)->bindingBatch) {
+            batch->m_flushPosted = false;
+            batch->flush();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void QQmlBindingBatch::link()
+{
+    if (m_linked)
+        return;
+    m_nextInThread = batchesInThread;
+    batchesInThread = this;
+    m_linked = true;
+}
+
+void QQmlBindingBatch::unlink()
+{
+    if (!m_linked)
+        return;
+    for (QQmlBindingBatch **batch = &batchesInThread; *batch; batch = &(*batch)->m_nextInThread) {
+        if (*batch == this) {
+            *batch = m_nextInThread;
+            break;
+        }
+    }
+    m_nextInThread = nullptr;
+    m_linked = false;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,113 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLBINDINGBATCH_P_H
+#define QQMLBINDINGBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlbinding_p.h>
+
+#include <QtCore/qloggingcategory.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(lcBindingBatch)
+
+class QQmlEngine;
+
+// Collects the bindings whose dependencies have changed and evaluates each of them once per
+// batch, rather than once per change notification. See QQmlBindingBatch::flush() for the order.
+class Q_QML_PRIVATE_EXPORT QQmlBindingBatch
+{
+    Q_DISABLE_COPY_MOVE(QQmlBindingBatch)
+public:
+    struct Statistics
+    {
+        quint64 notifications = 0; // change notifications received for bindings
+        quint64 evaluations = 0;   // bindings evaluated when flushing
+        quint64 avoided = 0;       // notifications for bindings that were pending already
+        quint64 batches = 0;
+    };
+
+    // Emits change signals that have been deferred until the batch is flushed, so that the
+    // bindings depending on them are evaluated in the same batch.
+    class Q_QML_PRIVATE_EXPORT Notifier
+    {
+    public:
+        virtual ~Notifier();
+        virtual void emitDeferredNotifications() = 0;
+
+        bool isScheduled() const { return m_batch != nullptr; }
+
+    private:
+        friend class QQmlBindingBatch;
+        QQmlBindingBatch *m_batch = nullptr;
+    };
+
+    explicit QQmlBindingBatch(QQmlEngine *engine);
+    ~QQmlBindingBatch();
+
+    void schedule(QQmlBinding *binding);
+    void schedule(Notifier *notifier);
+    void cancel(Notifier *notifier);
+    void flush();
+    void clear();
+
+    bool isEmpty() const { return m_pending.empty() && m_notifiers.empty(); }
+    const Statistics &statistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = Statistics(); }
+
+    // Flushes the batches of all engines living in the current thread. Called before the
+    // scene graph synchronizes with the items.
+    static void flushAll();
+
+    // Evaluating a binding this many times in a single flush is taken as a binding loop.
+    enum { MaxEvaluationsPerFlush = 64 };
+
+private:
+    struct Entry
+    {
+        quint32 rank;
+        quint32 sequence;
+        QQmlBinding::Ptr binding;
+
+        // std::push_heap creates a max-heap
+        bool operator<(const Entry &other) const
+        {
+            return rank != other.rank ? rank > other.rank : sequence > other.sequence;
+        }
+    };
+
+    void push(QQmlBinding *binding);
+    void postFlush();
+    void link();
+    void unlink();
+
+    QQmlEngine *m_engine;
+    std::vector<Entry> m_pending;
+    std::vector<QQmlBinding::Ptr> m_evaluated;
+    std::vector<Notifier *> m_notifiers;
+    QQmlBinding *m_current = nullptr;
+    QQmlBindingBatch *m_nextInThread = nullptr;
+    quint32 m_sequence = 0;
+    bool m_flushing = false;
+    bool m_flushPosted = false;
+    bool m_linked = false;
+    Statistics m_statistics;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLBINDINGBATCH_P_H
@@ -0,0 +1,283 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlcompilationbundle_p.h"
+
+#include <private/qqmlmetatype_p.h>
+#include <private/qv4compileddata_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+
+#include <QtQml/qqmlfile.h>
+#include <QtQml/qqmlprivate.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QQmlCompilationBundle
+
+    Provides the compilation units of bundles written by \c{qmlcachegen --bundle}. A bundle is
+    mapped once and its units are used in place, without looking up and mapping a cache file or
+    resource per unit. The bundle also records which other units each unit depends on, so that
+    the type loader can start loading those before it has resolved the imports.
+
+    Bundles are never unloaded.
+*/
+
+namespace {
+struct LoadedBundle
+{
+    std::unique_ptr<QFile> file;
+    const QV4::CompiledData::Bundle *data = nullptr;
+    std::unique_ptr<QQmlPrivate::CachedQmlUnit[]> units;
+};
+
+struct BundledUnit
+{
+    const LoadedBundle *bundle = nullptr;
+    quint32 index = 0;
+};
+
+struct BundleRegistry
+{
+    QMutex mutex;
+    std::vector<std::unique_ptr<LoadedBundle>> bundles;
+    QHash<QUrl, BundledUnit> units;
+    QSet<QString> files;
+    QAtomicInteger<bool> hasBundles = false;
+    QAtomicInteger<bool> lookupRegistered = false;
+};
+}
+
+Q_GLOBAL_STATIC(BundleRegistry, bundleRegistry)
+
+static QUrl normalizedUrl(const QString &url)
+{
+    QUrl normalized(url);
+    if (normalized.scheme() == QLatin1String("qrc"))
+        normalized.setHost(QString()); // map qrc:///a.qml to qrc:/a.qml
+    return normalized;
+}
+
+static QUrl bundledUrl(const LoadedBundle *bundle, quint32 index)
+{
+    return normalizedUrl(bundle->data->stringAt(bundle->data->unitAt(index)->urlIndex));
+}
+
+static const QQmlPrivate::CachedQmlUnit *lookupCachedUnit(const QUrl &url)
+{
+    BundleRegistry *registry = bundleRegistry();
+    if (!registry)
+        return nullptr;
+
+    QMutexLocker lock(&registry->mutex);
+    const auto it = registry->units.constFind(url);
+    return it == registry->units.constEnd() ? nullptr : &it->bundle->units[it->index];
+}
+
+static bool verifyBundle(const uchar *data, qint64 size, QString *errorString)
+{
+    using namespace QV4::CompiledData;
+
+    if (size < qint64(sizeof(Bundle))) {
+        *errorString = QStringLiteral("File too small for the header fields");
+        return false;
+    }
+
+    const Bundle *bundle = reinterpret_cast<const Bundle *>(data);
+    if (strncmp(bundle->magic, bundle_magic_str, sizeof(bundle->magic))) {
+        *errorString = QStringLiteral("Magic bytes in the header do not match");
+        return false;
+    }
+
+    if (bundle->version != quint32(QV4_DATA_STRUCTURE_VERSION)) {
+        *errorString = QString::fromUtf8("V4 data structure version mismatch. Found %1 expected %2")
+                               .arg(bundle->version, 0, 16).arg(QV4_DATA_STRUCTURE_VERSION, 0, 16);
+        return false;
+    }
+
+    if (bundle->qtVersion != quint32(QT_VERSION)) {
+        *errorString = QString::fromUtf8("Qt version mismatch. Found %1 expected %2")
+                               .arg(bundle->qtVersion, 0, 16).arg(QT_VERSION, 0, 16);
+        return false;
+    }
+
+    if (bundle->bundleSize != quint64(size)) {
+        *errorString = QStringLiteral("Potential file corruption, bundle size mismatch");
+        return false;
+    }
+
+    const auto inBounds = [size](quint64 offset, quint64 length) {
+        return offset + length <= quint64(size);
+    };
+
+    if (!inBounds(bundle->offsetToStringTable, quint64(bundle->stringTableSize) * sizeof(quint32_le))
+            || !inBounds(bundle->offsetToUnitTable,
+                         quint64(bundle->unitTableSize) * sizeof(BundleUnit))) {
+        *errorString = QStringLiteral("Potential file corruption, tables out of bounds");
+        return false;
+    }
+
+    for (uint i = 0; i < bundle->unitTableSize; ++i) {
+        const BundleUnit *bundleUnit = bundle->unitAt(i);
+        if (bundleUnit->urlIndex >= bundle->stringTableSize
+                || bundleUnit->offsetToUnit % alignof(Unit) != 0
+                || !inBounds(bundleUnit->offsetToUnit, sizeof(Unit))
+                || !inBounds(bundleUnit->offsetToUnit, bundle->unitData(i)->unitSize)
+                || !inBounds(bundleUnit->offsetToDependencies,
+                             quint64(bundleUnit->nDependencies) * sizeof(quint32_le))) {
+            *errorString = QStringLiteral("Potential file corruption, unit %1 out of bounds").arg(i);
+            return false;
+        }
+
+        // The units are used in place, just like mapped cache files, and need the same checks.
+        const Unit *unit = bundle->unitData(i);
+        QString unitError;
+        if (!QV4::ExecutableCompilationUnit::verifyHeader(unit, QDateTime(), &unitError)) {
+            *errorString = QStringLiteral("Unit %1: %2").arg(i).arg(unitError);
+            return false;
+        }
+
+        if (!(unit->flags & Unit::StaticData)) {
+            *errorString = QStringLiteral("Unit %1 does not contain static data").arg(i);
+            return false;
+        }
+
+        const quint32_le *dependencies = bundle->dependencyTable(i);
+        for (uint j = 0; j < bundleUnit->nDependencies; ++j) {
+            if (dependencies[j] >= bundle->unitTableSize) {
+                *errorString = QStringLiteral("Potential file corruption, invalid dependency");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*!
+    \internal
+    Maps the bundle in \a fileName and makes its units available to the type loader. Returns
+    \c false and sets \a errorString if the file cannot be mapped or is not a valid bundle for
+    this version of Qt.
+*/
+bool QQmlCompilationBundle::load(const QString &fileName, QString *errorString)
+{
+    auto loaded = std::make_unique<LoadedBundle>();
+    loaded->file = std::make_unique<QFile>(fileName);
+    if (!loaded->file->open(QIODevice::ReadOnly)) {
+        *errorString = loaded->file->errorString();
+        return false;
+    }
+
+    const qint64 size = loaded->file->size();
+    const uchar *data = loaded->file->map(0, size);
+    if (!data) {
+        *errorString = loaded->file->errorString();
+        return false;
+    }
+
+    if (!verifyBundle(data, size, errorString)) {
+        loaded->file->unmap(const_cast<uchar *>(data));
+        return false;
+    }
+
+    loaded->data = reinterpret_cast<const QV4::CompiledData::Bundle *>(data);
+    const quint32 unitCount = loaded->data->unitTableSize;
+    loaded->units = std::make_unique<QQmlPrivate::CachedQmlUnit[]>(unitCount);
+    for (quint32 i = 0; i < unitCount; ++i)
+        loaded->units[i] = { loaded->data->unitData(i), nullptr, nullptr };
+
+    BundleRegistry *registry = bundleRegistry();
+    {
+        QMutexLocker lock(&registry->mutex);
+        for (quint32 i = 0; i < unitCount; ++i) {
+            const QUrl url = bundledUrl(loaded.get(), i);
+            registry->units.insert(url, { loaded.get(), i });
+            const QString file = QQmlFile::urlToLocalFileOrQrc(url);
+            if (!file.isEmpty())
+                registry->files.insert(file);
+        }
+        registry->bundles.push_back(std::move(loaded));
+        registry->hasBundles.storeRelease(true);
+    }
+
+    // The lookup is called with the meta type data locked. Register it without holding our own
+    // lock, to keep the locking order the same.
+    if (registry->lookupRegistered.testAndSetRelaxed(false, true))
+        QQmlMetaType::prependCachedUnitLookupFunction(&lookupCachedUnit);
+
+    return true;
+}
+
+/*!
+    \internal
+    Loads the bundles listed in the \c QML_COMPILATION_BUNDLE environment variable. Only the
+    first call has any effect.
+*/
+void QQmlCompilationBundle::loadFromEnvironment()
+{
+    static const bool loaded = []() {
+        const QString fileNames = qEnvironmentVariable("QML_COMPILATION_BUNDLE");
+        for (const QString &fileName : fileNames.split(QDir::listSeparator(), Qt::SkipEmptyParts)) {
+            QString error;
+            if (!load(fileName, &error))
+                qWarning().nospace() << "Cannot load compilation bundle " << fileName << ": " << error;
+        }
+        return true;
+    }();
+    Q_UNUSED(loaded);
+}
+
+/*!
+    \internal
+    Returns the URLs of the units that the bundled unit for \a url imports or instantiates.
+    Returns an empty list if \a url is not bundled.
+*/
+QList<QUrl> QQmlCompilationBundle::dependencies(const QUrl &url)
+{
+    if (!bundleRegistry.exists() || !bundleRegistry->hasBundles.loadAcquire())
+        return QList<QUrl>();
+
+    BundleRegistry *registry = bundleRegistry();
+    QMutexLocker lock(&registry->mutex);
+    const auto it = registry->units.constFind(url);
+    if (it == registry->units.constEnd())
+        return QList<QUrl>();
+
+    const QV4::CompiledData::Bundle *bundle = it->bundle->data;
+    const quint32 nDependencies = bundle->unitAt(it->index)->nDependencies;
+    const quint32_le *dependencies = bundle->dependencyTable(it->index);
+
+    QList<QUrl> result;
+    result.reserve(nDependencies);
+    for (quint32 i = 0; i < nDependencies; ++i)
+        result.append(bundledUrl(it->bundle, dependencies[i]));
+    return result;
+}
+
+/*!
+    \internal
+    Returns \c true if a loaded bundle contains the unit for the local file or resource path
+    \a localFileOrQrc. The type loader then does not need to check for the file itself.
+*/
+bool QQmlCompilationBundle::containsFile(const QString &localFileOrQrc)
+{
+    if (!bundleRegistry.exists() || !bundleRegistry->hasBundles.loadAcquire())
+        return false;
+
+    BundleRegistry *registry = bundleRegistry();
+    QMutexLocker lock(&registry->mutex);
+    return registry->files.contains(localFileOrQrc);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLCOMPILATIONBUNDLE_P_H
+#define QQMLCOMPILATIONBUNDLE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_QML_PRIVATE_EXPORT QQmlCompilationBundle
+{
+public:
+    static bool load(const QString &fileName, QString *errorString);
+    static void loadFromEnvironment();
+
+    static QList<QUrl> dependencies(const QUrl &url);
+    static bool containsFile(const QString &localFileOrQrc);
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLCOMPILATIONBUNDLE_P_H
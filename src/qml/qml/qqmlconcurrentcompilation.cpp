@@ -0,0 +1,104 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlconcurrentcompilation_p.h"
+
+#include <private/qqmlengine_p.h>
+#include <private/qqmlsourcecoordinate_p.h>
+#include <private/qv4codegen_p.h>
+#include <private/qv4script_p.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+
+QT_BEGIN_NAMESPACE
+
+QQmlConcurrentCompilation::QQmlConcurrentCompilation(
+        const QUrl &url, const QString &fileName, Kind kind, bool debugging,
+        const QSet<QString> &illegalNames)
+    : m_url(url)
+    , m_fileName(fileName)
+    , m_kind(kind)
+    , m_debugging(debugging)
+    , m_illegalNames(illegalNames)
+{
+    setAutoDelete(false);
+}
+
+void QQmlConcurrentCompilation::run()
+{
+    const QFileInfo fileInfo(m_fileName);
+    sourceTimeStamp = fileInfo.lastModified();
+
+    QFile f(m_fileName);
+    if (f.open(QIODevice::ReadOnly)) {
+        const QString source = QString::fromUtf8(f.readAll());
+        if (m_kind == QmlDocument)
+            compileDocument(source);
+        else
+            compileScript(source);
+    } else {
+        // Let the blob report the error, the same way as without concurrent compilation.
+        sourceTimeStamp = QDateTime();
+    }
+
+    m_finished.release();
+}
+
+void QQmlConcurrentCompilation::waitForFinished()
+{
+    m_finished.acquire();
+    m_finished.release();
+}
+
+void QQmlConcurrentCompilation::compileDocument(const QString &source)
+{
+    document = std::make_unique<QmlIR::Document>(m_debugging);
+    document->jsModule.sourceTimeStamp = sourceTimeStamp;
+
+    QmlIR::IRBuilder compiler(m_illegalNames);
+    if (compiler.generateFromQml(source, m_url.toString(), document.get()))
+        return;
+
+    errors.reserve(compiler.errors.size());
+    for (const QQmlJS::DiagnosticMessage &msg : std::as_const(compiler.errors)) {
+        QQmlError e;
+        e.setUrl(m_url);
+        e.setLine(qmlConvertSourceCoordinate<quint32, int>(msg.loc.startLine));
+        e.setColumn(qmlConvertSourceCoordinate<quint32, int>(msg.loc.startColumn));
+        e.setDescription(msg.message);
+        errors << e;
+    }
+    document.reset();
+}
+
+void QQmlConcurrentCompilation::compileScript(const QString &source)
+{
+    const QString urlString = m_url.toString();
+
+    if (m_kind == Module) {
+        QList<QQmlJS::DiagnosticMessage> diagnostics;
+        unit = QV4::Compiler::Codegen::compileModule(m_debugging, urlString, source,
+                                                     sourceTimeStamp, &diagnostics);
+        errors = QQmlEnginePrivate::qmlErrorFromDiagnostics(urlString, diagnostics);
+        return;
+    }
+
+    QmlIR::Document irUnit(m_debugging);
+    irUnit.jsModule.sourceTimeStamp = sourceTimeStamp;
+
+    QmlIR::ScriptDirectivesCollector collector(&irUnit);
+    irUnit.jsParserEngine.setDirectives(&collector);
+
+    irUnit.javaScriptCompilationUnit = QV4::Script::precompile(
+            &irUnit.jsModule, &irUnit.jsParserEngine, &irUnit.jsGenerator, urlString, urlString,
+            source, &errors, QV4::Compiler::ContextType::ScriptImportedByQML);
+    if (!errors.isEmpty())
+        return;
+
+    QmlIR::QmlUnitGenerator qmlGenerator;
+    qmlGenerator.generate(irUnit);
+    unit = std::move(irUnit.javaScriptCompilationUnit);
+}
+
+QT_END_NAMESPACE
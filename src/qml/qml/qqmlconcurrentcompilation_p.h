@@ -0,0 +1,71 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLCONCURRENTCOMPILATION_P_H
+#define QQMLCONCURRENTCOMPILATION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlirbuilder_p.h>
+#include <private/qv4compileddata_p.h>
+
+#include <QtQml/qqmlerror.h>
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qset.h>
+#include <QtCore/qurl.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+// Compiles a QML document or a script from source, without access to the engine or the type
+// loader. The type loader runs these on its compilation thread pool for the dependencies it is
+// about to load, and picks up the result when it reaches the respective blob.
+class QQmlConcurrentCompilation : public QRunnable
+{
+    Q_DISABLE_COPY_MOVE(QQmlConcurrentCompilation)
+public:
+    enum Kind { QmlDocument, Script, Module };
+
+    QQmlConcurrentCompilation(const QUrl &url, const QString &fileName, Kind kind, bool debugging,
+                              const QSet<QString> &illegalNames);
+
+    void run() override;
+    void waitForFinished();
+
+    QUrl url() const { return m_url; }
+    Kind kind() const { return m_kind; }
+    bool debugging() const { return m_debugging; }
+
+    QDateTime sourceTimeStamp;
+    std::unique_ptr<QmlIR::Document> document;
+    QV4::CompiledData::CompilationUnit unit;
+    QList<QQmlError> errors;
+
+private:
+    void compileDocument(const QString &source);
+    void compileScript(const QString &source);
+
+    const QUrl m_url;
+    const QString m_fileName;
+    const Kind m_kind;
+    const bool m_debugging;
+    const QSet<QString> m_illegalNames;
+    QSemaphore m_finished;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLCONCURRENTCOMPILATION_P_H
@@ -57,6 +57,11 @@ public:
     {
         return m_typeCompilationUnit;
     }
+    int componentObjectIndex() const { return m_componentObjectIndex; }
+    bool isComponentContext(const QV4::ExecutableCompilationUnit *unit, int objectIndex) const
+    {
+        return m_componentObjectIndex == objectIndex && m_typeCompilationUnit.data() == unit;
+    }
     void initFromTypeCompilationUnit(const QQmlRefPointer<QV4::ExecutableCompilationUnit> &unit,
                                      int subComponentIndex);
 
@@ -15,6 +15,7 @@
 
 #include <private/qqmldirparser_p.h>
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlbindingbatch_p.h>
 #include <private/qqmljsdiagnosticmessage_p.h>
 #include <private/qqmltype_p_p.h>
 #include <private/qqmlpluginimporter_p.h>
@@ -501,6 +502,23 @@ void QQmlEnginePrivate::init()
     q->handle()->setQmlEngine(q);
 
     rootContext = new QQmlContext(q,true);
+
+    if (!qEnvironmentVariableIsEmpty("QML_BATCHED_BINDINGS"))
+        setBindingBatchingEnabled(true);
+}
+
+void QQmlEnginePrivate::setBindingBatchingEnabled(bool enabled)
+{
+    Q_Q(QQmlEngine);
+    if (enabled) {
+        if (!bindingBatch)
+            bindingBatch = new QQmlBindingBatch(q);
+    } else if (bindingBatch) {
+        // Bring the pending bindings up to date before going back to immediate updates.
+        bindingBatch->flush();
+        delete bindingBatch;
+        bindingBatch = nullptr;
+    }
 }
 
 /*!
@@ -567,6 +585,10 @@ QQmlEngine::~QQmlEngine()
     // XXX TODO: performance -- store list of singleton types separately?
     d->singletonInstances.clear();
 
+    // The pending bindings are about to be destroyed along with their contexts.
+    delete d->bindingBatch;
+    d->bindingBatch = nullptr;
+
     delete d->rootContext;
     d->rootContext = nullptr;
 
@@ -50,6 +50,7 @@
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QQmlBindingBatch;
 class QQmlDelayedError;
 class QQmlIncubator;
 class QQmlMetaObject;
@@ -138,6 +139,10 @@ public:
     QUrl baseUrl;
 
     QQmlObjectCreator *activeObjectCreator = nullptr;
+
+    // Defers the re-evaluation of bindings until the end of the event, if enabled
+    QQmlBindingBatch *bindingBatch = nullptr;
+    void setBindingBatchingEnabled(bool enabled);
 #if QT_CONFIG(qml_network)
     QNetworkAccessManager *createNetworkAccessManager(QObject *parent) const;
     QNetworkAccessManager *getNetworkAccessManager() const;
@@ -35,6 +35,7 @@ void QQmlEnginePrivate::incubate(
         if (parentIncubator && parentIncubator->isAsynchronous) {
             mode = QQmlIncubator::Asynchronous;
             p->waitingOnMe = parentIncubator;
+            p->priority = parentIncubator->priority + 1;
             parentIncubator->waitingFor.insert(p.data());
         }
     }
@@ -413,6 +414,28 @@ void QQmlIncubatorPrivate::incubateCppBasedComponent(QQmlComponent *component, Q
 
 }
 
+/*
+    Returns the incubator to continue with. Nested incubators block the completion of the
+    incubators waiting for them, and so they go first. Incubators that are done and only wait
+    for their nested ones are skipped. Among the remaining ones, the most recently started
+    incubator is picked, as incubatorList prepends new entries.
+*/
+static QQmlIncubatorPrivate *nextIncubator(QQmlEnginePrivate *d)
+{
+    QQmlIncubatorPrivate *first = static_cast<QQmlIncubatorPrivate *>(d->incubatorList.first());
+    QQmlIncubatorPrivate *next = nullptr;
+    for (QQmlEnginePrivate::Incubator *it = first; it; it = d->incubatorList.next(it)) {
+        QQmlIncubatorPrivate *incubator = static_cast<QQmlIncubatorPrivate *>(it);
+        if (incubator->progress == QQmlIncubatorPrivate::Completed
+                && !incubator->waitingFor.isEmpty()) {
+            continue;
+        }
+        if (!next || incubator->priority > next->priority)
+            next = incubator;
+    }
+    return next ? next : first;
+}
+
 /*!
 Incubate objects for \a msecs, or until there are no more objects to incubate.
 */
@@ -424,7 +447,7 @@ void QQmlIncubationController::incubateFor(int msecs)
     QDeadlineTimer deadline(msecs);
     QQmlInstantiationInterrupt i(deadline);
     do {
-        static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
+        nextIncubator(d)->incubate(i);
     } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
 }
 
@@ -447,7 +470,7 @@ void QQmlIncubationController::incubateWhile(std::atomic<bool> *flag, int msecs)
 
     QQmlInstantiationInterrupt i(flag, msecs ? QDeadlineTimer(msecs) : QDeadlineTimer::Forever);
     do {
-        static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
+        nextIncubator(d)->incubate(i);
     } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
 }
 
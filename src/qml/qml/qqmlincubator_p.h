@@ -49,6 +49,8 @@ public:
     bool isAsynchronous;
     enum Progress : char { Execute, Completing, Completed };
     Progress progress;
+    // Incubators created while incubating another one take precedence over it
+    int priority = 0;
 
     QList<QQmlError> errors;
 
@@ -167,14 +167,26 @@ public:
         Q_ASSERT(expression->notifyOnValueChanged() || expression->activeGuards.isEmpty());
 
         lastPropertyCapture = ep->propertyCapture;
-        ep->propertyCapture = expression->notifyOnValueChanged() ? &capture : nullptr;
 
-        if (expression->notifyOnValueChanged())
+        // A nested evaluation of an expression whose guards are being verified doesn't
+        // capture anything. The outer evaluation takes care of the dependencies.
+        capturing = expression->notifyOnValueChanged() && !expression->m_verifyingGuards;
+        ep->propertyCapture = capturing ? &capture : nullptr;
+
+        if (!capturing)
+            return;
+
+        if (expression->m_guardsInCaptureOrder)
+            capture.startVerifying();
+        else
             capture.guards.copyAndClearPrepend(expression->activeGuards);
     }
 
     ~QQmlJavaScriptExpressionCapture()
     {
+        if (capturing && !watcher.wasDeleted())
+            capture.finish();
+
         if (capture.errorString) {
             for (int ii = 0; ii < capture.errorString->size(); ++ii)
                 qWarning("%s", qPrintable(capture.errorString->at(ii)));
@@ -208,6 +220,7 @@ private:
     QQmlPropertyCapture capture;
     QQmlEnginePrivate *ep;
     QQmlPropertyCapture *lastPropertyCapture;
+    bool capturing = false;
 };
 
 QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, bool *isUndefined)
@@ -280,20 +293,11 @@ void QQmlPropertyCapture::captureProperty(QQmlNotifier *n)
         return;
 
     Q_ASSERT(expression);
-    // Try and find a matching guard
-    while (!guards.isEmpty() && !guards.first()->isConnected(n))
-        guards.takeFirst()->Delete();
-
-    QQmlJavaScriptExpressionGuard *g = nullptr;
-    if (!guards.isEmpty()) {
-        g = guards.takeFirst();
-        g->cancelNotify();
-        Q_ASSERT(g->isConnected(n));
-    } else {
-        g = QQmlJavaScriptExpressionGuard::New(expression, engine);
-        g->connect(n);
-    }
+    if (reuseGuard([n](QQmlJavaScriptExpressionGuard *g) { return g->isConnected(n); }))
+        return;
 
+    QQmlJavaScriptExpressionGuard *g = QQmlJavaScriptExpressionGuard::New(expression, engine);
+    g->connect(n);
     expression->activeGuards.prepend(g);
 }
 
@@ -417,21 +421,135 @@ void QQmlPropertyCapture::captureNonBindableProperty(QObject *o, int n, int c, b
         errorString->append(error);
     } else {
 
-        // Try and find a matching guard
-        while (!guards.isEmpty() && !guards.first()->isConnected(o, n))
-            guards.takeFirst()->Delete();
+        if (reuseGuard([o, n](QQmlJavaScriptExpressionGuard *g) { return g->isConnected(o, n); }))
+            return;
 
-        QQmlJavaScriptExpressionGuard *g = nullptr;
-        if (!guards.isEmpty()) {
-            g = guards.takeFirst();
-            g->cancelNotify();
-            Q_ASSERT(g->isConnected(o, n));
-        } else {
-            g = QQmlJavaScriptExpressionGuard::New(expression, engine);
-            g->connect(o, n, engine, doNotify);
+        QQmlJavaScriptExpressionGuard *g = QQmlJavaScriptExpressionGuard::New(expression, engine);
+        g->connect(o, n, engine, doNotify);
+        expression->activeGuards.prepend(g);
+    }
+}
+
+/*! \internal
+
+    Returns \c true if the dependency matched by \a matches is guarded already. Otherwise the
+    caller has to create a new guard for it.
+
+    Guards are reused from the previous evaluation of the expression. Usually the dependencies
+    are captured in the same order as before, and the first remaining guard matches. Otherwise
+    the other remaining guards are searched, so that a dependency that has been skipped this
+    time does not cause the guards for all the following ones to be recreated. A dependency
+    captured twice gets two guards, as checking the guards of the current evaluation would make
+    capturing quadratic in the number of dependencies.
+
+    If the expression has captured the same dependencies several times in a row, its guards
+    are kept in capture order and merely verified one by one, without moving them between
+    lists. Verification stops at the first dependency that doesn't match, unless it is guarded
+    already by one of the guards verified before.
+*/
+template<typename Matches>
+bool QQmlPropertyCapture::reuseGuard(Matches matches)
+{
+    if (verifying) {
+        if (expression->m_verifyingGuards) {
+            if (expectedGuard && matches(expectedGuard)) {
+                expectedGuard->cancelNotify();
+                expectedGuard = expectedGuard->next;
+                return true;
+            }
+
+            for (QQmlJavaScriptExpressionGuard *g = expression->activeGuards.first();
+                 g != expectedGuard; g = g->next) {
+                if (matches(g))
+                    return true;
+            }
+        }
+        stopVerifying();
+    }
+
+    QQmlJavaScriptExpressionGuard *g = guards.first();
+    if (g && matches(g)) {
+        guards.takeFirst();
+    } else {
+        g = nullptr;
+        for (QQmlJavaScriptExpressionGuard *prev = guards.first(); prev && prev->next;
+             prev = prev->next) {
+            if (matches(prev->next)) {
+                g = prev->next;
+                prev->next = g->next;
+                g->next = nullptr;
+                break;
+            }
         }
 
-        expression->activeGuards.prepend(g);
+        if (!g) {
+            dependenciesChanged = true;
+            return false;
+        }
+
+        dependenciesChanged = true;
+    }
+
+    g->cancelNotify();
+    expression->activeGuards.prepend(g);
+    return true;
+}
+
+void QQmlPropertyCapture::startVerifying()
+{
+    verifying = true;
+    expression->m_verifyingGuards = true;
+    expectedGuard = expression->activeGuards.first();
+}
+
+void QQmlPropertyCapture::stopVerifying()
+{
+    verifying = false;
+    dependenciesChanged = true;
+
+    // The guards may have been cleared during the evaluation.
+    if (!expression->m_verifyingGuards)
+        return;
+
+    expression->m_verifyingGuards = false;
+    expression->m_guardsInCaptureOrder = false;
+
+    // Keep the verified guards as active ones, in reverse capture order as usual, and hand
+    // the rest back for regular matching, in capture order.
+    expression->activeGuards.reverse();
+    if (expectedGuard) {
+        while (QQmlJavaScriptExpressionGuard *g = expression->activeGuards.takeFirst()) {
+            guards.prepend(g);
+            if (g == expectedGuard)
+                break;
+        }
+        expectedGuard = nullptr;
+    }
+}
+
+void QQmlPropertyCapture::finish()
+{
+    if (verifying) {
+        if (!expectedGuard && expression->m_verifyingGuards) {
+            // All dependencies were the same as before.
+            expression->m_verifyingGuards = false;
+            verifying = false;
+            return;
+        }
+        stopVerifying();
+    }
+
+    if (dependenciesChanged || !guards.isEmpty()) {
+        expression->m_unchangedGuardEvaluations = 0;
+        return;
+    }
+
+    if (expression->m_unchangedGuardEvaluations < QQmlJavaScriptExpression::StableGuardThreshold
+            && ++expression->m_unchangedGuardEvaluations
+                    == QQmlJavaScriptExpression::StableGuardThreshold
+            && !expression->activeGuards.isEmpty()) {
+        expression->activeGuards.reverse();
+        expression->m_guardsInCaptureOrder = true;
     }
 }
 
@@ -552,6 +670,9 @@ void QQmlJavaScriptExpression::clearActiveGuards()
 {
     while (QQmlJavaScriptExpressionGuard *g = activeGuards.takeFirst())
         g->Delete();
+    m_unchangedGuardEvaluations = 0;
+    m_guardsInCaptureOrder = false;
+    m_verifyingGuards = false;
 }
 
 void QQmlJavaScriptExpressionGuard_callback(QQmlNotifierEndpoint *e, void **)
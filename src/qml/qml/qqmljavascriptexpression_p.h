@@ -181,6 +181,13 @@ private:
 
     QV4::Function *m_v4Function;
 
+    // After this many evaluations that captured the same dependencies, the guards are kept in
+    // capture order and the next evaluations merely verify them.
+    enum { StableGuardThreshold = 3 };
+    quint8 m_unchangedGuardEvaluations = 0;
+    bool m_guardsInCaptureOrder = false;
+    bool m_verifyingGuards = false;
+
 protected:
     TriggerList *qpropertyChangeTriggers = nullptr;
 };
@@ -201,13 +208,24 @@ public:
     void captureProperty(QObject *, const QQmlPropertyCache *, const QQmlPropertyData *, bool doNotify = true);
     void captureTranslation();
 
+    void startVerifying();
+    void stopVerifying();
+    void finish();
+
     QQmlEngine *engine;
     QQmlJavaScriptExpression *expression;
     QQmlJavaScriptExpression::DeleteWatcher *watcher;
     QForwardFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next> guards;
     QStringList *errorString;
 
+    // The next guard expected in expression->activeGuards while verifying stable dependencies
+    QQmlJavaScriptExpressionGuard *expectedGuard = nullptr;
+    bool verifying = false;
+    bool dependenciesChanged = false;
+
 private:
+    template<typename Matches>
+    bool reuseGuard(Matches matches);
     void captureBindableProperty(QObject *o, const QMetaObject *metaObjectForBindable, int c);
     void captureNonBindableProperty(QObject *o, int n, int c, bool doNotify);
 };
@@ -305,6 +305,206 @@ void QQmlObjectCreator::finalizePopulateDeferred()
     phase = ObjectsCreated;
 }
 
+// Converts a string literal to the given property type, the same way setPropertyValue() does.
+// Returns an invalid QVariant if the literal cannot be converted up front. This does not use
+// the engine and can be called from the type loader thread.
+static QVariant decodeLiteral(const QV4::ExecutableCompilationUnit *compilationUnit,
+                              QMetaType propertyType, const QV4::CompiledData::Binding *binding)
+{
+    if (binding->type() != QV4::CompiledData::Binding::Type_String)
+        return QVariant();
+
+    const QString string = compilationUnit->bindingValueAsString(binding);
+    bool ok = false;
+
+    switch (propertyType.id()) {
+    case QMetaType::QByteArray:
+        return QVariant(string.toUtf8());
+    case QMetaType::QUrl:
+        return QVariant((!string.isEmpty() && QQmlPropertyPrivate::resolveUrlsOnAssignment())
+                                ? compilationUnit->finalUrl().resolved(QUrl(string))
+                                : QUrl(string));
+    case QMetaType::QColor:
+    case QMetaType::QVector2D:
+    case QMetaType::QVector3D:
+    case QMetaType::QVector4D:
+    case QMetaType::QQuaternion:
+        return QQmlValueTypeProvider::createValueType(string, propertyType);
+#if QT_CONFIG(datestring)
+    case QMetaType::QDate: {
+        const QDate value = QQmlStringConverters::dateFromString(string, &ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QTime: {
+        const QTime value = QQmlStringConverters::timeFromString(string, &ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QDateTime: {
+        const QDateTime value = QQmlStringConverters::dateTimeFromString(string, &ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+#endif // datestring
+    case QMetaType::QPoint: {
+        const QPoint value = QQmlStringConverters::pointFFromString(string, &ok).toPoint();
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QPointF: {
+        const QPointF value = QQmlStringConverters::pointFFromString(string, &ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QSize: {
+        const QSize value = QQmlStringConverters::sizeFFromString(string, &ok).toSize();
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QSizeF: {
+        const QSizeF value = QQmlStringConverters::sizeFFromString(string, &ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QRect: {
+        const QRect value = QQmlStringConverters::rectFFromString(string, &ok).toRect();
+        return ok ? QVariant(value) : QVariant();
+    }
+    case QMetaType::QRectF: {
+        const QRectF value = QQmlStringConverters::rectFFromString(string, &ok);
+        return ok ? QVariant(value) : QVariant();
+    }
+    default:
+        break;
+    }
+
+    if (propertyType == QMetaType::fromType<QList<QUrl>>()) {
+        const QUrl url(string);
+        return QVariant::fromValue(QList<QUrl> {
+            QQmlPropertyPrivate::resolveUrlsOnAssignment()
+                    ? compilationUnit->finalUrl().resolved(url)
+                    : url
+        });
+    }
+
+    return QVariant();
+}
+
+static QVariant propertyLiteralDefault(const QV4::ExecutableCompilationUnit *compilationUnit,
+                                       const QV4::CompiledData::Property *property,
+                                       const QV4::CompiledData::Binding *binding)
+{
+    if (property->isList())
+        return QVariant();
+
+    switch (property->commonType()) {
+    case QV4::CompiledData::CommonType::Int:
+        if (binding->type() == QV4::CompiledData::Binding::Type_Number)
+            return QVariant(int(compilationUnit->bindingValueAsNumber(binding)));
+        break;
+    case QV4::CompiledData::CommonType::Real:
+        if (binding->type() == QV4::CompiledData::Binding::Type_Number)
+            return QVariant(compilationUnit->bindingValueAsNumber(binding));
+        break;
+    case QV4::CompiledData::CommonType::Bool:
+        if (binding->type() == QV4::CompiledData::Binding::Type_Boolean)
+            return QVariant(binding->valueAsBoolean());
+        break;
+    case QV4::CompiledData::CommonType::String:
+        if (binding->type() == QV4::CompiledData::Binding::Type_String)
+            return QVariant(compilationUnit->bindingValueAsString(binding));
+        break;
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+/*!
+    \internal
+
+    Decodes the literal bindings of all objects in \a compilationUnit that need to be converted
+    to the type of their property. The type loader calls this once it has validated the
+    bindings, on its own thread when loading asynchronously, so that the object creator only
+    has to copy the values into each object it creates.
+
+    The literal values of the int, bool, real and string properties an object declares itself
+    are recorded as their defaults, and not written at all. QQmlVMEMetaObject serves them until
+    the object needs storage for its properties. This is only done as long as no signal handler
+    of the object could observe the initial change signals.
+*/
+void QQmlObjectCreator::decodeLiteralBindings(QV4::ExecutableCompilationUnit *compilationUnit)
+{
+    const int objectCount = compilationUnit->objectCount();
+    QVector<QV4::BindingLiteralValues> valuesPerObject(objectCount);
+    QVector<QV4::PropertyLiteralDefaults> defaultsPerObject(objectCount);
+
+    for (int objectIndex = 0; objectIndex < objectCount; ++objectIndex) {
+        const QV4::CompiledData::Object *object = compilationUnit->objectAt(objectIndex);
+        const QV4::BindingPropertyData &propertyData
+                = compilationUnit->bindingPropertyDataPerObject.at(objectIndex);
+        QV4::BindingLiteralValues &values = valuesPerObject[objectIndex];
+        QV4::PropertyLiteralDefaults &defaults = defaultsPerObject[objectIndex];
+        const int propertyOffset = object->nProperties
+                ? compilationUnit->propertyCaches.at(objectIndex)->propertyOffset()
+                : 0;
+        bool signalHandlerSeen = false;
+
+        const QV4::CompiledData::Binding *binding = object->bindingTable();
+        for (quint32 i = 0; i < object->nBindings; ++i, ++binding) {
+            if (binding->hasSignalHandlerBindingFlag())
+                signalHandlerSeen = true;
+
+            const QQmlPropertyData *property = propertyData.value(i);
+            if (property && !signalHandlerSeen && !property->isAlias()) {
+                const int id = property->coreIndex() - propertyOffset;
+                if (id >= 0 && id < int(object->nProperties)) {
+                    QVariant value = propertyLiteralDefault(
+                            compilationUnit, object->propertyTable() + id, binding);
+                    if (value.isValid()) {
+                        if (defaults.isEmpty())
+                            defaults.resize(object->nProperties);
+                        defaults[id] = std::move(value);
+                        continue;
+                    }
+                }
+            }
+
+            if (!property || property->isEnum() || property->isQObject()
+                    || property->isVarProperty()
+                    || binding->hasFlag(QV4::CompiledData::Binding::IsCustomParserBinding)) {
+                continue;
+            }
+
+            QVariant value = decodeLiteral(compilationUnit, property->propType(), binding);
+            if (!value.isValid() || value.metaType() != property->propType())
+                continue;
+
+            if (values.isEmpty())
+                values.resize(object->nBindings);
+            values[i] = std::move(value);
+        }
+    }
+
+    compilationUnit->bindingLiteralValuesPerObject = std::move(valuesPerObject);
+    compilationUnit->propertyLiteralDefaultsPerObject = std::move(defaultsPerObject);
+}
+
+const QVariant *QQmlObjectCreator::decodedLiteral(const QV4::CompiledData::Binding *binding) const
+{
+    if (compilationUnit->bindingLiteralValuesPerObject.isEmpty())
+        return nullptr;
+
+    const QV4::BindingLiteralValues &values
+            = compilationUnit->bindingLiteralValuesPerObject.at(_compiledObjectIndex);
+    if (values.isEmpty())
+        return nullptr;
+
+    // The binding may also be a temporary one, like the one for the id.
+    const quintptr first = quintptr(_compiledObject->bindingTable());
+    const quintptr offset = quintptr(binding) - first;
+    if (quintptr(binding) < first || offset >= quintptr(values.size()) * sizeof(QV4::CompiledData::Binding))
+        return nullptr;
+
+    const QVariant &value = values.at(offset / sizeof(QV4::CompiledData::Binding));
+    return value.isValid() ? &value : nullptr;
+}
+
 void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding)
 {
     QQmlPropertyData::WriteFlags propertyWriteFlags = QQmlPropertyData::BypassInterceptor | QQmlPropertyData::RemoveBindingOnAliasWrite;
@@ -325,6 +525,17 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
         }
     }
 
+    // Literal values of the object's own properties are served by its QQmlVMEMetaObject
+    if (_vmeMetaObject && _vmeMetaObject->hasLiteralDefault(_compiledObject, property->coreIndex()))
+        return;
+
+    const QVariant *literal = decodedLiteral(binding);
+    if (literal && literal->metaType() == propertyType) {
+        property->writeProperty(_qobject, const_cast<void *>(literal->constData()),
+                                propertyWriteFlags);
+        return;
+    }
+
     auto assertOrNull = [&](bool ok)
     {
         Q_ASSERT(ok || binding->type() == QV4::CompiledData::Binding::Type_Null);
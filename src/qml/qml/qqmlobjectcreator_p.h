@@ -148,6 +148,8 @@ public:
                                           int index, QObject *parent,
                                           const QQmlRefPointer<QQmlContextData> &context);
 
+    static void decodeLiteralBindings(QV4::ExecutableCompilationUnit *compilationUnit);
+
     void removePendingBinding(QObject *target, int propertyIndex)
     {
         QList<DeferredQPropertyBinding> &pendingBindings = sharedState.data()->allQPropertyBindings;
@@ -189,6 +191,7 @@ private:
     void setupBindings(BindingSetupFlags mode = BindingMode::ApplyImmediate);
     bool setPropertyBinding(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
     void setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
+    const QVariant *decodedLiteral(const QV4::CompiledData::Binding *binding) const;
     void setupFunctions();
 
     QString stringAt(int idx) const { return compilationUnit->stringAt(idx); }
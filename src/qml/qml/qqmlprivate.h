@@ -690,6 +690,10 @@ namespace QQmlPrivate
         bool loadContextIdLookup(uint index, void *target) const;
         void initLoadContextIdLookup(uint index) const;
 
+        // Only for ids the compiler has resolved to a component enclosing the current one.
+        bool loadEnclosingContextIdLookup(uint index, void *target) const;
+        void initLoadEnclosingContextIdLookup(uint index) const;
+
         bool callObjectPropertyLookup(uint index, QObject *object,
                                       void **args, const QMetaType *types, int argc) const;
         void initCallObjectPropertyLookup(uint index) const;
@@ -7,6 +7,7 @@
 #include <private/qqmlscriptdata_p.h>
 #include <private/qqmlsourcecoordinate_p.h>
 #include <private/qqmlcontextdata_p.h>
+#include <private/qqmlconcurrentcompilation_p.h>
 #include <private/qv4runtimecodegen_p.h>
 #include <private/qv4script_p.h>
 
@@ -54,46 +55,57 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         return;
     }
 
-    QString error;
-    QString source = data.readAll(&error);
-    if (!error.isEmpty()) {
-        setError(error);
-        return;
-    }
-
     QV4::CompiledData::CompilationUnit unit;
 
-    if (m_isModule) {
-        QList<QQmlJS::DiagnosticMessage> diagnostics;
-        unit = QV4::Compiler::Codegen::compileModule(isDebugging(), urlString(), source,
-                                                     data.sourceTimeStamp(), &diagnostics);
-        QList<QQmlError> errors = QQmlEnginePrivate::qmlErrorFromDiagnostics(urlString(), diagnostics);
-        if (!errors.isEmpty()) {
-            setError(errors);
+    const auto compilation = typeLoader()->takeConcurrentCompilation(url());
+    if (compilation && compilation->debugging() == isDebugging()
+            && compilation->url().toString() == finalUrlString()
+            && compilation->sourceTimeStamp == data.sourceTimeStamp()) {
+        if (!compilation->errors.isEmpty()) {
+            setError(compilation->errors);
             return;
         }
+        unit = std::move(compilation->unit);
     } else {
-        QmlIR::Document irUnit(isDebugging());
+        QString error;
+        QString source = data.readAll(&error);
+        if (!error.isEmpty()) {
+            setError(error);
+            return;
+        }
+
+        if (m_isModule) {
+            QList<QQmlJS::DiagnosticMessage> diagnostics;
+            unit = QV4::Compiler::Codegen::compileModule(isDebugging(), urlString(), source,
+                                                         data.sourceTimeStamp(), &diagnostics);
+            QList<QQmlError> errors = QQmlEnginePrivate::qmlErrorFromDiagnostics(urlString(), diagnostics);
+            if (!errors.isEmpty()) {
+                setError(errors);
+                return;
+            }
+        } else {
+            QmlIR::Document irUnit(isDebugging());
 
-        irUnit.jsModule.sourceTimeStamp = data.sourceTimeStamp();
+            irUnit.jsModule.sourceTimeStamp = data.sourceTimeStamp();
 
-        QmlIR::ScriptDirectivesCollector collector(&irUnit);
-        irUnit.jsParserEngine.setDirectives(&collector);
+            QmlIR::ScriptDirectivesCollector collector(&irUnit);
+            irUnit.jsParserEngine.setDirectives(&collector);
 
-        QList<QQmlError> errors;
-        irUnit.javaScriptCompilationUnit = QV4::Script::precompile(
-                     &irUnit.jsModule, &irUnit.jsParserEngine, &irUnit.jsGenerator, urlString(), finalUrlString(),
-                     source, &errors, QV4::Compiler::ContextType::ScriptImportedByQML);
+            QList<QQmlError> errors;
+            irUnit.javaScriptCompilationUnit = QV4::Script::precompile(
+                         &irUnit.jsModule, &irUnit.jsParserEngine, &irUnit.jsGenerator, urlString(), finalUrlString(),
+                         source, &errors, QV4::Compiler::ContextType::ScriptImportedByQML);
 
-        source.clear();
-        if (!errors.isEmpty()) {
-            setError(errors);
-            return;
-        }
+            source.clear();
+            if (!errors.isEmpty()) {
+                setError(errors);
+                return;
+            }
 
-        QmlIR::QmlUnitGenerator qmlGenerator;
-        qmlGenerator.generate(irUnit);
-        unit = std::move(irUnit.javaScriptCompilationUnit);
+            QmlIR::QmlUnitGenerator qmlGenerator;
+            qmlGenerator.generate(irUnit);
+            unit = std::move(irUnit.javaScriptCompilationUnit);
+        }
     }
 
     auto executableUnit = QV4::ExecutableCompilationUnit::create(std::move(unit));
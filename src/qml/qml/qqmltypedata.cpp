@@ -2,9 +2,11 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include <private/qqmlcomponentandaliasresolver_p.h>
+#include <private/qqmlconcurrentcompilation_p.h>
 #include <private/qqmlengine_p.h>
 #include <private/qqmlirbuilder_p.h>
 #include <private/qqmlirloader_p.h>
+#include <private/qqmlobjectcreator_p.h>
 #include <private/qqmlpropertycachecreator_p.h>
 #include <private/qqmlpropertyvalidator_p.h>
 #include <private/qqmlscriptblob_p.h>
@@ -17,6 +19,7 @@
 #include <QtCore/qcryptographichash.h>
 
 #include <memory>
+#include <vector>
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(lcCycle, "qt.qml.typeresolution.cycle", QtWarningMsg)
@@ -524,6 +527,9 @@ void QQmlTypeData::done()
         }
 
         m_compiledData->finalizeCompositeType(qmlType());
+
+        // Decode literals here rather than each time an object is created
+        QQmlObjectCreator::decodeLiteralBindings(m_compiledData.data());
     }
 
     {
@@ -657,6 +663,19 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
 
 bool QQmlTypeData::loadFromSource()
 {
+    if (const auto compilation = typeLoader()->takeConcurrentCompilation(url())) {
+        if (compilation->debugging() == isDebugging()
+                && compilation->url().toString() == finalUrlString()
+                && compilation->sourceTimeStamp == m_backupSourceCode.sourceTimeStamp()) {
+            if (!compilation->errors.isEmpty()) {
+                setError(compilation->errors);
+                return false;
+            }
+            m_document.reset(compilation->document.release());
+            return true;
+        }
+    }
+
     m_document.reset(new QmlIR::Document(isDebugging()));
     m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
     QQmlEngine *qmlEngine = typeLoader()->engine();
@@ -842,8 +861,52 @@ void QQmlTypeData::resolveTypes()
     if (!m_implicitImportLoaded && !loadImplicitImport())
         return;
 
-    // Add any imported scripts to our resolved set
     const auto resolvedScripts = m_importCache->resolvedScripts();
+    QList<QUrl> dependencyUrls;
+    dependencyUrls.reserve(resolvedScripts.size() + m_typeReferences.size());
+    for (const QQmlImports::ScriptReference &script : resolvedScripts)
+        dependencyUrls.append(script.location);
+
+    // Resolve the type references before loading any of them, so that the sources of all the
+    // composite types can be compiled concurrently.
+    std::vector<std::pair<int, TypeReference>> resolvedTypeReferences;
+    resolvedTypeReferences.reserve(m_typeReferences.size());
+    for (QV4::CompiledData::TypeReferenceMap::ConstIterator unresolvedRef = m_typeReferences.constBegin(), end = m_typeReferences.constEnd();
+         unresolvedRef != end; ++unresolvedRef) {
+
+        TypeReference ref; // resolved reference
+
+        const bool reportErrors = unresolvedRef->errorWhenNotFound;
+
+        QTypeRevision version;
+
+        const QString name = stringAt(unresolvedRef.key());
+
+        bool *selfReferenceDetection = unresolvedRef->needsCreation ? nullptr : &ref.selfReference;
+
+        if (!resolveType(name, version, ref, unresolvedRef->location.line(),
+                         unresolvedRef->location.column(), reportErrors,
+                         QQmlType::AnyRegistrationType, selfReferenceDetection) && reportErrors)
+            return;
+
+        if (ref.type.isComposite() && !ref.selfReference) {
+            dependencyUrls.append(ref.type.sourceUrl());
+        } else if (ref.type.isInlineComponentType()) {
+            QUrl containingTypeUrl = ref.type.sourceUrl();
+            containingTypeUrl.setFragment(QString());
+            if (!containingTypeUrl.isEmpty())
+                dependencyUrls.append(containingTypeUrl);
+        }
+
+        ref.version = version;
+        ref.location = unresolvedRef->location;
+        ref.needsCreation = unresolvedRef->needsCreation;
+        resolvedTypeReferences.emplace_back(unresolvedRef.key(), std::move(ref));
+    }
+
+    typeLoader()->compileConcurrently(dependencyUrls);
+
+    // Add any imported scripts to our resolved set
     for (const QQmlImports::ScriptReference &script : resolvedScripts) {
         QQmlRefPointer<QQmlScriptBlob> blob = typeLoader()->getScript(script.location);
         addDependency(blob.data());
@@ -894,24 +957,7 @@ void QQmlTypeData::resolveTypes()
         }
     }
 
-    for (QV4::CompiledData::TypeReferenceMap::ConstIterator unresolvedRef = m_typeReferences.constBegin(), end = m_typeReferences.constEnd();
-         unresolvedRef != end; ++unresolvedRef) {
-
-        TypeReference ref; // resolved reference
-
-        const bool reportErrors = unresolvedRef->errorWhenNotFound;
-
-        QTypeRevision version;
-
-        const QString name = stringAt(unresolvedRef.key());
-
-        bool *selfReferenceDetection = unresolvedRef->needsCreation ? nullptr : &ref.selfReference;
-
-        if (!resolveType(name, version, ref, unresolvedRef->location.line(),
-                         unresolvedRef->location.column(), reportErrors,
-                         QQmlType::AnyRegistrationType, selfReferenceDetection) && reportErrors)
-            return;
-
+    for (auto &[key, ref] : resolvedTypeReferences) {
         if (ref.type.isComposite() && !ref.selfReference) {
             ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
             addDependency(ref.typeData.data());
@@ -928,10 +974,7 @@ void QQmlTypeData::resolveTypes()
             }
         }
 
-        ref.version = version;
-        ref.location = unresolvedRef->location;
-        ref.needsCreation = unresolvedRef->needsCreation;
-        m_resolvedTypes.insert(unresolvedRef.key(), ref);
+        m_resolvedTypes.insert(key, ref);
     }
 
     // ### this allows enums to work without explicit import or instantiation of the type
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include <private/qqmltypeloader_p.h>
+#include <private/qqmlcompilationbundle_p.h>
+#include <private/qqmlconcurrentcompilation_p.h>
 
 #include <private/qqmldirdata_p.h>
 #include <private/qqmlprofiler_p.h>
@@ -10,6 +12,7 @@
 #include <private/qqmltypeloaderqmldircontent_p.h>
 #include <private/qqmltypeloaderthread_p.h>
 #include <private/qqmlsourcecoordinate_p.h>
+#include <private/qv4executablecompilationunit_p.h>
 
 #include <QtQml/qqmlabstracturlinterceptor.h>
 #include <QtQml/qqmlengine.h>
@@ -22,6 +25,7 @@
 #include <QtCore/qdiriterator.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
 
 #include <functional>
 
@@ -904,6 +908,19 @@ QQmlTypeLoader::QQmlTypeLoader(QQmlEngine *engine)
     , m_mutex(m_thread->mutex())
     , m_typeCacheTrimThreshold(TYPELOADER_MINIMUM_TRIM_THRESHOLD)
 {
+    QQmlCompilationBundle::loadFromEnvironment();
+
+#if QT_CONFIG(thread)
+    bool ok = false;
+    int threadCount = qEnvironmentVariableIntValue("QML_COMPILATION_THREADS", &ok);
+    if (!ok)
+        threadCount = QThread::idealThreadCount();
+    if (threadCount > 0) {
+        m_compilationPool = std::make_unique<QThreadPool>();
+        m_compilationPool->setObjectName(QStringLiteral("QQmlTypeLoader compilation"));
+        m_compilationPool->setMaxThreadCount(threadCount);
+    }
+#endif
 }
 
 /*!
@@ -917,6 +934,10 @@ QQmlTypeLoader::~QQmlTypeLoader()
 
     clearCache();
 
+#if QT_CONFIG(thread)
+    m_compilationPool.reset();
+#endif
+
     invalidate();
 }
 
@@ -944,43 +965,52 @@ QQmlRefPointer<QQmlTypeData> QQmlTypeLoader::getType(const QUrl &unNormalizedUrl
 
     const QUrl url = normalize(unNormalizedUrl);
 
-    LockHolder<QQmlTypeLoader> holder(this);
-
-    QQmlTypeData *typeData = m_typeCache.value(url);
+    QQmlRefPointer<QQmlTypeData> typeData;
+    bool loadedCachedUnit = false;
 
-    if (!typeData) {
-        // Trim before adding the new type, so that we don't immediately trim it away
-        if (m_typeCache.size() >= m_typeCacheTrimThreshold)
-            trimCache();
-
-        typeData = new QQmlTypeData(url, this);
-        // TODO: if (compiledData == 0), is it safe to omit this insertion?
-        m_typeCache.insert(url, typeData);
-        QQmlMetaType::CachedUnitLookupError error = QQmlMetaType::CachedUnitLookupError::NoError;
-
-        const QQmlMetaType::CacheMode cacheMode = typeData->aotCacheMode();
-        if (const QQmlPrivate::CachedQmlUnit *cachedUnit = (cacheMode != QQmlMetaType::RejectAll)
-                ? QQmlMetaType::findCachedCompilationUnit(typeData->url(), cacheMode, &error)
-                : nullptr) {
-            QQmlTypeLoader::loadWithCachedUnit(typeData, cachedUnit, mode);
-        } else {
-            typeData->setCachedUnitStatus(error);
-            QQmlTypeLoader::load(typeData, mode);
-        }
-    } else if ((mode == PreferSynchronous || mode == Synchronous) && QQmlFile::isSynchronous(url)) {
-        // this was started Asynchronous, but we need to force Synchronous
-        // completion now (if at all possible with this type of URL).
+    {
+        LockHolder<QQmlTypeLoader> holder(this);
+
+        typeData = m_typeCache.value(url);
+
+        if (!typeData) {
+            // Trim before adding the new type, so that we don't immediately trim it away
+            if (m_typeCache.size() >= m_typeCacheTrimThreshold)
+                trimCache();
+
+            typeData = new QQmlTypeData(url, this);
+            // TODO: if (compiledData == 0), is it safe to omit this insertion?
+            m_typeCache.insert(url, typeData.data());
+            QQmlMetaType::CachedUnitLookupError error = QQmlMetaType::CachedUnitLookupError::NoError;
+
+            const QQmlMetaType::CacheMode cacheMode = typeData->aotCacheMode();
+            if (const QQmlPrivate::CachedQmlUnit *cachedUnit = (cacheMode != QQmlMetaType::RejectAll)
+                    ? QQmlMetaType::findCachedCompilationUnit(typeData->url(), cacheMode, &error)
+                    : nullptr) {
+                QQmlTypeLoader::loadWithCachedUnit(typeData.data(), cachedUnit, mode);
+                loadedCachedUnit = true;
+            } else {
+                typeData->setCachedUnitStatus(error);
+                QQmlTypeLoader::load(typeData.data(), mode);
+            }
+        } else if ((mode == PreferSynchronous || mode == Synchronous) && QQmlFile::isSynchronous(url)) {
+            // this was started Asynchronous, but we need to force Synchronous
+            // completion now (if at all possible with this type of URL).
 
-        if (!m_thread->isThisThread()) {
-            // this only works when called directly from the UI thread, but not
-            // when recursively called on the QML thread via resolveTypes()
+            if (!m_thread->isThisThread()) {
+                // this only works when called directly from the UI thread, but not
+                // when recursively called on the QML thread via resolveTypes()
 
-            while (!typeData->isCompleteOrError()) {
-                m_thread->waitForNextMessage();
+                while (!typeData->isCompleteOrError()) {
+                    m_thread->waitForNextMessage();
+                }
             }
         }
     }
 
+    if (loadedCachedUnit)
+        loadBundledDependencies(url);
+
     return typeData;
 }
 
@@ -1009,29 +1039,54 @@ QQmlRefPointer<QQmlScriptBlob> QQmlTypeLoader::getScript(const QUrl &unNormalize
 
     const QUrl url = normalize(unNormalizedUrl);
 
-    LockHolder<QQmlTypeLoader> holder(this);
+    QQmlRefPointer<QQmlScriptBlob> scriptBlob;
+    bool loadedCachedUnit = false;
 
-    QQmlScriptBlob *scriptBlob = m_scriptCache.value(url);
+    {
+        LockHolder<QQmlTypeLoader> holder(this);
 
-    if (!scriptBlob) {
-        scriptBlob = new QQmlScriptBlob(url, this);
-        m_scriptCache.insert(url, scriptBlob);
+        scriptBlob = m_scriptCache.value(url);
 
-        QQmlMetaType::CachedUnitLookupError error = QQmlMetaType::CachedUnitLookupError::NoError;
-        const QQmlMetaType::CacheMode cacheMode = scriptBlob->aotCacheMode();
-        if (const QQmlPrivate::CachedQmlUnit *cachedUnit = (cacheMode != QQmlMetaType::RejectAll)
-                ? QQmlMetaType::findCachedCompilationUnit(scriptBlob->url(), cacheMode, &error)
-                : nullptr) {
-            QQmlTypeLoader::loadWithCachedUnit(scriptBlob, cachedUnit);
-        } else {
-            scriptBlob->setCachedUnitStatus(error);
-            QQmlTypeLoader::load(scriptBlob);
+        if (!scriptBlob) {
+            scriptBlob = new QQmlScriptBlob(url, this);
+            m_scriptCache.insert(url, scriptBlob.data());
+
+            QQmlMetaType::CachedUnitLookupError error = QQmlMetaType::CachedUnitLookupError::NoError;
+            const QQmlMetaType::CacheMode cacheMode = scriptBlob->aotCacheMode();
+            if (const QQmlPrivate::CachedQmlUnit *cachedUnit = (cacheMode != QQmlMetaType::RejectAll)
+                    ? QQmlMetaType::findCachedCompilationUnit(scriptBlob->url(), cacheMode, &error)
+                    : nullptr) {
+                QQmlTypeLoader::loadWithCachedUnit(scriptBlob.data(), cachedUnit);
+                loadedCachedUnit = true;
+            } else {
+                scriptBlob->setCachedUnitStatus(error);
+                QQmlTypeLoader::load(scriptBlob.data());
+            }
         }
     }
 
+    if (loadedCachedUnit)
+        loadBundledDependencies(url);
+
     return scriptBlob;
 }
 
+/*!
+\internal
+Starts loading the units that the bundled unit for \a url depends on. The type loader would
+only find out about them after resolving the imports and types of \a url. Does nothing if
+\a url is not part of a compilation bundle.
+*/
+void QQmlTypeLoader::loadBundledDependencies(const QUrl &url)
+{
+    for (const QUrl &dependency : QQmlCompilationBundle::dependencies(url)) {
+        if (dependency.path().endsWith(QLatin1String(".qml")))
+            getType(dependency, Asynchronous);
+        else
+            getScript(dependency);
+    }
+}
+
 /*!
 Returns a QQmlQmldirData for \a url.  The QQmlQmldirData may be cached.
 */
@@ -1066,6 +1121,8 @@ QString QQmlTypeLoader::absoluteFilePath(const QString &path)
 {
     if (path.isEmpty())
         return QString();
+    if (QQmlCompilationBundle::containsFile(path))
+        return path;
     if (path.at(0) == QLatin1Char(':')) {
         // qrc resource
         QFileInfo fileInfo(path);
@@ -1142,14 +1199,16 @@ bool QQmlTypeLoader::fileExists(const QString &path, const QString &file)
     }
 
     auto addToCache = [&](const QFileInfo &fileInfo) {
+        // Files in a compilation bundle don't have to exist on their own.
+        const bool bundled = QQmlCompilationBundle::containsFile(fileInfo.filePath());
         if (!fileSet) {
-            fileSet = fileInfo.dir().exists() ? new QCache<QString, bool> : nullptr;
+            fileSet = (bundled || fileInfo.dir().exists()) ? new QCache<QString, bool> : nullptr;
             m_importDirCache.insert(path, fileSet);
             if (!fileSet)
                 return false;
         }
 
-        const bool exists = fileInfo.exists();
+        const bool exists = bundled || fileInfo.exists();
         fileSet->insert(file, new bool(exists));
         return exists;
     };
@@ -1300,6 +1359,8 @@ and qmldir information.
 */
 void QQmlTypeLoader::clearCache()
 {
+    clearConcurrentCompilations();
+
     for (TypeCache::Iterator iter = m_typeCache.begin(), end = m_typeCache.end(); iter != end; ++iter)
         (*iter)->release();
     for (ScriptCache::Iterator iter = m_scriptCache.begin(), end = m_scriptCache.end(); iter != end; ++iter)
@@ -1319,6 +1380,146 @@ void QQmlTypeLoader::clearCache()
     QQmlMetaType::freeUnusedTypesAndCaches();
 }
 
+/*!
+\internal
+Starts compiling the sources of \a urls on the compilation thread pool. The loader thread
+calls this with the dependencies of a blob, before it requests them one after another. Only
+local files and resources are considered, and only if they are not loaded yet and have no
+cached compilation unit that could be used instead.
+
+Compiling a QML document here only covers parsing and building the IR, and compiling a script
+only covers generating its byte code. Everything that needs the engine or other types stays on
+the loader thread, which picks up the results with takeConcurrentCompilation().
+*/
+void QQmlTypeLoader::compileConcurrently(const QList<QUrl> &urls)
+{
+#if QT_CONFIG(thread)
+    if (!m_compilationPool)
+        return;
+
+    ASSERT_LOADTHREAD();
+
+    QV4::ExecutionEngine *v4 = engine()->handle();
+    const QV4::ExecutionEngine::DiskCacheOptions options = v4->diskCacheOptions();
+    const bool debugging = v4->debugger() != nullptr;
+    QQmlMetaType::CacheMode cacheMode = QQmlMetaType::RejectAll;
+    if (options & QV4::ExecutionEngine::DiskCache::Aot) {
+        cacheMode = (options & QV4::ExecutionEngine::DiskCache::AotByteCode)
+                ? QQmlMetaType::AcceptUntyped
+                : QQmlMetaType::RequireFullyTyped;
+    }
+
+    for (const QUrl &unNormalizedUrl : urls) {
+        const QUrl url = normalize(unNormalizedUrl);
+        if (!QQmlFile::isSynchronous(url))
+            continue;
+
+        const QString path = url.path();
+        const QQmlConcurrentCompilation::Kind kind
+                = path.endsWith(QLatin1String(".qml"))
+                    ? QQmlConcurrentCompilation::QmlDocument
+                    : path.endsWith(QLatin1String(".mjs"))
+                      ? QQmlConcurrentCompilation::Module
+                      : QQmlConcurrentCompilation::Script;
+
+        {
+            LockHolder<QQmlTypeLoader> holder(this);
+            if (kind == QQmlConcurrentCompilation::QmlDocument
+                    ? m_typeCache.contains(url)
+                    : m_scriptCache.contains(url)) {
+                continue;
+            }
+        }
+
+        {
+            QMutexLocker lock(&m_compilationMutex);
+            if (m_concurrentCompilations.contains(url))
+                continue;
+        }
+
+        if (cacheMode != QQmlMetaType::RejectAll
+                && QQmlMetaType::findCachedCompilationUnit(url, cacheMode, nullptr)) {
+            continue;
+        }
+
+        const QString fileName = QQmlFile::urlToLocalFileOrQrc(url);
+        if (fileName.isEmpty())
+            continue;
+
+        // A cache file is much cheaper to load than the source is to compile.
+        if ((options & QV4::ExecutionEngine::DiskCache::QmlcRead)
+                && (QFile::exists(fileName + QLatin1Char('c'))
+                    || QFile::exists(QV4::ExecutableCompilationUnit::localCacheFilePath(url)))) {
+            continue;
+        }
+
+        auto *compilation = new QQmlConcurrentCompilation(
+                url, fileName, kind, debugging, v4->illegalNames());
+        {
+            QMutexLocker lock(&m_compilationMutex);
+            m_concurrentCompilations.insert(url, compilation);
+        }
+        m_compilationPool->start(compilation);
+    }
+#else
+    Q_UNUSED(urls);
+#endif
+}
+
+/*!
+\internal
+Returns the result of compiling \a url on the compilation thread pool, waiting for it if
+necessary. Returns \c nullptr if \a url was not scheduled for concurrent compilation, or if
+the compilation had not started yet. In that case the caller compiles the source itself.
+*/
+std::unique_ptr<QQmlConcurrentCompilation> QQmlTypeLoader::takeConcurrentCompilation(const QUrl &url)
+{
+#if QT_CONFIG(thread)
+    if (!m_compilationPool)
+        return nullptr;
+
+    QQmlConcurrentCompilation *compilation = nullptr;
+    {
+        QMutexLocker lock(&m_compilationMutex);
+        compilation = m_concurrentCompilations.take(url);
+    }
+
+    if (!compilation)
+        return nullptr;
+
+    std::unique_ptr<QQmlConcurrentCompilation> result(compilation);
+    if (m_compilationPool->tryTake(compilation))
+        return nullptr;
+
+    result->waitForFinished();
+    return result;
+#else
+    Q_UNUSED(url);
+    return nullptr;
+#endif
+}
+
+void QQmlTypeLoader::clearConcurrentCompilations()
+{
+#if QT_CONFIG(thread)
+    if (!m_compilationPool)
+        return;
+
+    // Compilations the loader thread has taken already are not ours to wait for or delete.
+    QHash<QUrl, QQmlConcurrentCompilation *> compilations;
+    {
+        QMutexLocker lock(&m_compilationMutex);
+        compilations.swap(m_concurrentCompilations);
+    }
+
+    for (QQmlConcurrentCompilation *compilation : std::as_const(compilations)) {
+        if (!m_compilationPool->tryTake(compilation))
+            compilation->waitForFinished();
+        delete compilation;
+    }
+#endif
+}
+
 void QQmlTypeLoader::updateTypeCacheTrimThreshold()
 {
     int size = m_typeCache.size();
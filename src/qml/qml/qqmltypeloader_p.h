@@ -37,6 +37,8 @@ class QQmlExtensionInterface;
 class QQmlProfiler;
 class QQmlTypeLoaderThread;
 class QQmlEngine;
+class QQmlConcurrentCompilation;
+class QThreadPool;
 
 class Q_QML_PRIVATE_EXPORT QQmlTypeLoader
 {
@@ -144,6 +146,9 @@ public:
     void clearCache();
     void trimCache();
 
+    void compileConcurrently(const QList<QUrl> &urls);
+    std::unique_ptr<QQmlConcurrentCompilation> takeConcurrentCompilation(const QUrl &url);
+
     bool isTypeLoaded(const QUrl &url) const;
     bool isScriptLoaded(const QUrl &url) const;
 
@@ -180,6 +185,7 @@ private:
     void loadThread(const QQmlDataBlob::Ptr &);
     void loadWithStaticDataThread(const QQmlDataBlob::Ptr &, const QByteArray &);
     void loadWithCachedUnitThread(const QQmlDataBlob::Ptr &blob, const QQmlPrivate::CachedQmlUnit *unit);
+    void loadBundledDependencies(const QUrl &url);
 #if QT_CONFIG(qml_network)
     void networkReplyFinished(QNetworkReply *);
     void networkReplyProgress(QNetworkReply *, qint64, qint64);
@@ -217,9 +223,16 @@ private:
     ImportQmlDirCache m_importQmlDirCache;
     ChecksumCache m_checksumCache;
 
+#if QT_CONFIG(thread)
+    std::unique_ptr<QThreadPool> m_compilationPool;
+    QMutex m_compilationMutex;
+    QHash<QUrl, QQmlConcurrentCompilation *> m_concurrentCompilations;
+#endif
+
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
     void updateTypeCacheTrimThreshold();
+    void clearConcurrentCompilations();
 
     friend struct PlainLoader;
     friend struct CachedLoader;
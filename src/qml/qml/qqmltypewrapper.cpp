@@ -448,7 +448,7 @@ ReturnedValue QQmlTypeWrapper::virtualInstanceOf(const Object *typeObject, const
 ReturnedValue QQmlTypeWrapper::virtualResolveLookupGetter(const Object *object, ExecutionEngine *engine, Lookup *lookup)
 {
     // Keep this code in sync with ::virtualGet
-    PropertyKey id = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->runtimeStrings[lookup->nameIndex]);
+    PropertyKey id = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->runtimeString(lookup->nameIndex));
     if (!id.isString())
         return Object::virtualResolveLookupGetter(object, engine, lookup);
     Scope scope(engine);
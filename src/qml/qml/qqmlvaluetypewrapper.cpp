@@ -635,8 +635,8 @@ ReturnedValue QQmlValueTypeWrapper::method_toString(const FunctionObject *b, con
 ReturnedValue QQmlValueTypeWrapper::virtualResolveLookupGetter(const Object *object, ExecutionEngine *engine,
                                                                Lookup *lookup)
 {
-    PropertyKey id = engine->identifierTable->asPropertyKey(engine->currentStackFrame->v4Function->compilationUnit->
-                                                            runtimeStrings[lookup->nameIndex]);
+    PropertyKey id = engine->identifierTable->asPropertyKey(
+            engine->currentStackFrame->v4Function->runtimeString(lookup->nameIndex));
     if (!id.isString())
         return Object::virtualResolveLookupGetter(object, engine, lookup);
 
@@ -426,16 +426,12 @@ QQmlVMEMetaObject::QQmlVMEMetaObject(QV4::ExecutionEngine *engine,
     if (compilationUnit && qmlObjectId >= 0) {
         compiledObject = compilationUnit->objectAt(qmlObjectId);
 
-        if (compiledObject->nProperties || compiledObject->nFunctions) {
-            uint size = compiledObject->nProperties + compiledObject->nFunctions;
-            if (size) {
-                QV4::Heap::MemberData *data = QV4::MemberData::allocate(engine, size);
-                propertyAndMethodStorage.set(engine, data);
-                std::fill(data->values.values, data->values.values + data->values.size, QV4::Encode::undefined());
-            }
-
-            // Need JS wrapper to ensure properties/methods are marked.
-            ensureQObjectWrapper();
+        // The storage for properties and methods is only allocated once they are written.
+        if (!compilationUnit->propertyLiteralDefaultsPerObject.isEmpty()) {
+            const QV4::PropertyLiteralDefaults &defaults
+                    = compilationUnit->propertyLiteralDefaultsPerObject.at(qmlObjectId);
+            if (!defaults.isEmpty())
+                literalDefaults = &defaults;
         }
     }
 }
@@ -462,30 +458,83 @@ QV4::MemberData *QQmlVMEMetaObject::propertyAndMethodStorageAsMemberData() const
     return static_cast<QV4::MemberData*>(propertyAndMethodStorage.asManaged());
 }
 
+/*!
+    \internal
+
+    Returns the storage for the properties and methods declared in QML, and allocates it if
+    nothing has been written to them so far. Until then, reading a property yields the value of
+    its literal binding, if any, or the default value of its type. Returns \c nullptr if the
+    storage has been released together with the JavaScript wrapper of the object.
+*/
+QV4::MemberData *QQmlVMEMetaObject::ensurePropertyAndMethodStorage()
+{
+    if (propertyAndMethodStorage.valueRef())
+        return propertyAndMethodStorageAsMemberData();
+
+    const uint size = compiledObject
+            ? compiledObject->nProperties + compiledObject->nFunctions
+            : 0;
+    if (!size)
+        return nullptr;
+
+    QV4::Scope scope(engine);
+    QV4::Scoped<QV4::MemberData> data(scope, QV4::MemberData::allocate(engine, size));
+    QV4::Heap::MemberData *d = data->d();
+    std::fill(d->values.values, d->values.values + d->values.size, QV4::Encode::undefined());
+
+    if (literalDefaults) {
+        for (int id = 0, end = literalDefaults->size(); id < end; ++id) {
+            const QVariant &value = literalDefaults->at(id);
+            switch (value.metaType().id()) {
+            case QMetaType::Int:
+                data->set(engine, id, QV4::Value::fromInt32(*static_cast<const int *>(value.constData())));
+                break;
+            case QMetaType::Bool:
+                data->set(engine, id, QV4::Value::fromBoolean(*static_cast<const bool *>(value.constData())));
+                break;
+            case QMetaType::Double:
+                data->set(engine, id, QV4::Value::fromDouble(*static_cast<const double *>(value.constData())));
+                break;
+            case QMetaType::QString:
+                data->set(engine, id, engine->newString(*static_cast<const QString *>(value.constData())));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    propertyAndMethodStorage.set(engine, d);
+
+    // Need JS wrapper to ensure properties/methods are marked.
+    ensureQObjectWrapper();
+    return data.getPointer();
+}
+
 void QQmlVMEMetaObject::writeProperty(int id, int v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (md)
         md->set(engine, id, QV4::Value::fromInt32(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, bool v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (md)
         md->set(engine, id, QV4::Value::fromBoolean(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, double v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (md)
         md->set(engine, id, QV4::Value::fromDouble(v));
 }
 
 void QQmlVMEMetaObject::writeProperty(int id, const QString& v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (md) {
         QV4::Scope scope(engine);
         QV4::Scoped<QV4::MemberData>(scope, md)->set(engine, id, engine->newString(v));
@@ -494,7 +543,7 @@ void QQmlVMEMetaObject::writeProperty(int id, const QString& v)
 
 void QQmlVMEMetaObject::writeProperty(int id, QObject* v)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (md) {
         QV4::Scope scope(engine);
         QV4::Scoped<QV4::MemberData>(scope, md)->set(engine, id, QV4::Value::fromReturnedValue(
@@ -514,7 +563,7 @@ int QQmlVMEMetaObject::readPropertyAsInt(int id) const
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (!md)
-        return 0;
+        return literalDefault<int>(id);
 
     QV4::Scope scope(engine);
     QV4::ScopedValue sv(scope, *(md->data() + id));
@@ -527,7 +576,7 @@ bool QQmlVMEMetaObject::readPropertyAsBool(int id) const
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (!md)
-        return false;
+        return literalDefault<bool>(id);
 
     QV4::Scope scope(engine);
     QV4::ScopedValue sv(scope, *(md->data() + id));
@@ -540,7 +589,7 @@ double QQmlVMEMetaObject::readPropertyAsDouble(int id) const
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (!md)
-        return 0.0;
+        return literalDefault<double>(id);
 
     QV4::Scope scope(engine);
     QV4::ScopedValue sv(scope, *(md->data() + id));
@@ -553,7 +602,7 @@ QString QQmlVMEMetaObject::readPropertyAsString(int id) const
 {
     QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
     if (!md)
-        return QString();
+        return literalDefault<QString>(id);
 
     QV4::Scope scope(engine);
     QV4::ScopedValue sv(scope, *(md->data() + id));
@@ -676,9 +725,9 @@ QObject* QQmlVMEMetaObject::readPropertyAsQObject(int id) const
     return wrapper->object();
 }
 
-void QQmlVMEMetaObject::initPropertyAsList(int id) const
+void QQmlVMEMetaObject::initPropertyAsList(int id)
 {
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (!md)
         return;
 
@@ -784,8 +833,11 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                                     : nullptr;
                             propType.destruct(a[0]);
                             propType.construct(a[0], data);
-                        } else {
+                        } else if (propertyAndMethodStorage.valueRef()) {
                             qmlWarning(object) << "Cannot find member data";
+                        } else {
+                            propType.destruct(a[0]);
+                            propType.construct(a[0], nullptr);
                         }
                     } else {
                         switch (t) {
@@ -863,8 +915,18 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                                     propType.destruct(a[0]);
                                     propType.construct(a[0], data);
                                 }
-                            } else {
+                            } else if (propertyAndMethodStorage.valueRef()) {
                                 qmlWarning(object) << "Cannot find member data";
+                            } else {
+                                // _id because this is an absolute property ID.
+                                const QQmlPropertyData *propertyData = cache->property(_id);
+                                if (propertyData->isQObject()) {
+                                    *reinterpret_cast<QObject **>(a[0]) = nullptr;
+                                } else {
+                                    const QMetaType propType = propertyData->propType();
+                                    propType.destruct(a[0]);
+                                    propType.construct(a[0], nullptr);
+                                }
                             }
                         }
                     }
@@ -879,7 +941,7 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                         if (propType.flags().testFlag(QMetaType::IsQmlList)) {
                             // Writing such a property is not supported. Content is added through
                             // the list property methods.
-                        } else if (QV4::MemberData *md = propertyAndMethodStorageAsMemberData()) {
+                        } else if (QV4::MemberData *md = ensurePropertyAndMethodStorage()) {
                             // Value type list
                             QV4::Scope scope(engine);
                             QV4::Scoped<QV4::Sequence> sequence(scope, *(md->data() + id));
@@ -978,7 +1040,7 @@ int QQmlVMEMetaObject::metaCall(QObject *o, QMetaObject::Call c, int _id, void *
                                 writeProperty(id, *reinterpret_cast<QVariant *>(a[0]));
                             break;
                         case QV4::CompiledData::CommonType::Invalid:
-                            if (QV4::MemberData *md = propertyAndMethodStorageAsMemberData()) {
+                            if (QV4::MemberData *md = ensurePropertyAndMethodStorage()) {
                                 QV4::Scope scope(engine);
                                 QV4::ScopedValue sv(scope, *(md->data() + id));
 
@@ -1225,7 +1287,7 @@ void QQmlVMEMetaObject::writeVarProperty(int id, const QV4::Value &value)
 {
     Q_ASSERT(compiledObject && compiledObject->propertyTable()[id].commonType() == QV4::CompiledData::CommonType::Var);
 
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (!md)
         return;
 
@@ -1285,7 +1347,7 @@ void QQmlVMEMetaObject::writeVarProperty(int id, const QV4::Value &value)
 void QQmlVMEMetaObject::writeProperty(int id, const QVariant &value)
 {
     if (compiledObject && compiledObject->propertyTable()[id].commonType() == QV4::CompiledData::CommonType::Var) {
-        QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+        QV4::MemberData *md = ensurePropertyAndMethodStorage();
         if (!md)
             return;
 
@@ -1315,7 +1377,7 @@ void QQmlVMEMetaObject::writeProperty(int id, const QVariant &value)
             needActivate = readPropertyAsQObject(id) != o;  // TODO: still correct?
             writeProperty(id, o);
         } else {
-            QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+            QV4::MemberData *md = ensurePropertyAndMethodStorage();
             if (md) {
                 const QV4::VariantObject *v = (md->data() + id)->as<QV4::VariantObject>();
                 needActivate = (!v ||
@@ -1360,7 +1422,7 @@ void QQmlVMEMetaObject::setVmeMethod(int index, const QV4::Value &function)
     Q_ASSERT(index >= (methodOffset() + plainSignals) && index < (methodOffset() + plainSignals + int(compiledObject->nFunctions)));
 
     int methodIndex = index - methodOffset() - plainSignals;
-    QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+    QV4::MemberData *md = ensurePropertyAndMethodStorage();
     if (!md)
         return;
     md->set(engine, methodIndex + compiledObject->nProperties, function);
@@ -216,6 +216,9 @@ public:
 
     QV4::WeakValue propertyAndMethodStorage;
     QV4::MemberData *propertyAndMethodStorageAsMemberData() const;
+    QV4::MemberData *ensurePropertyAndMethodStorage();
+
+    inline bool hasLiteralDefault(const QV4::CompiledData::Object *object, int coreIndex) const;
 
     int readPropertyAsInt(int id) const;
     bool readPropertyAsBool(int id) const;
@@ -234,7 +237,7 @@ public:
 
     QRectF readPropertyAsRectF(int id) const;
     QObject *readPropertyAsQObject(int id) const;
-    void initPropertyAsList(int id) const;
+    void initPropertyAsList(int id);
 
     void writeProperty(int id, int v);
     void writeProperty(int id, bool v);
@@ -244,7 +247,7 @@ public:
     template<typename VariantCompatible>
     void writeProperty(int id, const VariantCompatible &v)
     {
-        QV4::MemberData *md = propertyAndMethodStorageAsMemberData();
+        QV4::MemberData *md = ensurePropertyAndMethodStorage();
         if (md) {
             QV4::Scope scope(engine);
             QV4::Scoped<QV4::MemberData>(scope, md)->set(
@@ -281,6 +284,21 @@ public:
     // do property access when the context has been invalidated.
     QQmlRefPointer<QV4::ExecutableCompilationUnit> compilationUnit;
     const QV4::CompiledData::Object *compiledObject;
+
+private:
+    template<typename T>
+    T literalDefault(int id) const
+    {
+        if (!literalDefaults)
+            return T();
+        const QVariant &value = literalDefaults->at(id);
+        return value.metaType() == QMetaType::fromType<T>()
+                ? *static_cast<const T *>(value.constData())
+                : T();
+    }
+
+    // The literal values of the properties, until propertyAndMethodStorage is allocated.
+    const QV4::PropertyLiteralDefaults *literalDefaults = nullptr;
 };
 
 QQmlVMEMetaObject *QQmlVMEMetaObject::get(QObject *obj)
@@ -295,6 +313,15 @@ QQmlVMEMetaObject *QQmlVMEMetaObject::get(QObject *obj)
     return nullptr;
 }
 
+bool QQmlVMEMetaObject::hasLiteralDefault(
+        const QV4::CompiledData::Object *object, int coreIndex) const
+{
+    if (!literalDefaults || object != compiledObject)
+        return false;
+    const int id = coreIndex - propOffset();
+    return id >= 0 && id < literalDefaults->size() && literalDefaults->at(id).isValid();
+}
+
 int QQmlVMEMetaObject::propOffset() const
 {
     return cache->propertyOffset();
@@ -0,0 +1,281 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qqmljsbundlegenerator_p.h"
+
+#include <private/qv4compileddata_p.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qtendian.h>
+#include <QtCore/qurl.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+struct BundleEntry
+{
+    QString url;
+    QByteArray data;
+    QList<quint32> dependencies;
+
+    const QV4::CompiledData::Unit *unit() const
+    {
+        return reinterpret_cast<const QV4::CompiledData::Unit *>(data.constData());
+    }
+};
+}
+
+static constexpr qsizetype UnitAlignment = 16;
+
+static qsizetype alignedSize(qsizetype size, qsizetype alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static QString normalizedUrl(const QString &url)
+{
+    if (url.startsWith(QLatin1Char(':')))
+        return QLatin1String("qrc") + url;
+    if (QDir::isAbsolutePath(url))
+        return QUrl::fromLocalFile(url).toString();
+    return QUrl(url).toString();
+}
+
+static bool readCompiledFile(const QString &compiledFile, BundleEntry *entry, QString *errorString)
+{
+    QString fileName = compiledFile;
+    const qsizetype urlSplit = fileName.indexOf(QLatin1Char('='));
+    if (urlSplit != -1) {
+        entry->url = fileName.mid(urlSplit + 1);
+        fileName.truncate(urlSplit);
+    }
+
+    QFile f(fileName);
+    if (!f.open(QIODevice::ReadOnly)) {
+        *errorString = fileName + QLatin1String(": ") + f.errorString();
+        return false;
+    }
+
+    entry->data = f.readAll();
+    if (entry->data.size() < qsizetype(sizeof(QV4::CompiledData::Unit))) {
+        *errorString = fileName + QLatin1String(": File too small for the header fields");
+        return false;
+    }
+
+    const QV4::CompiledData::Unit *unit = entry->unit();
+    if (strncmp(unit->magic, QV4::CompiledData::magic_str, sizeof(unit->magic))) {
+        *errorString = fileName + QLatin1String(": Magic bytes in the header do not match");
+        return false;
+    }
+
+    if (unit->version != quint32(QV4_DATA_STRUCTURE_VERSION)) {
+        *errorString = fileName + QLatin1String(": Version mismatch");
+        return false;
+    }
+
+    if (unit->unitSize != quint32(entry->data.size())) {
+        *errorString = fileName + QLatin1String(": Potential file corruption, unit size mismatch");
+        return false;
+    }
+
+    if (!(unit->flags & QV4::CompiledData::Unit::StaticData)) {
+        *errorString = fileName + QLatin1String(": Unit cannot be used in place");
+        return false;
+    }
+
+    if (entry->url.isEmpty()) {
+        if (unit->sourceFileIndex == 0) {
+            *errorString = fileName + QLatin1String(": No URL given for the compilation unit");
+            return false;
+        }
+        entry->url = unit->stringAtInternal(unit->sourceFileIndex);
+    }
+
+    entry->url = normalizedUrl(entry->url);
+    return true;
+}
+
+// Resolves everything a unit loads by URL: script imports, ES module requests, and the QML
+// components it instantiates from its own directory or from directory imports. Module imports
+// are left to the type loader.
+static void resolveDependencies(
+        BundleEntry *entry, quint32 index, const QHash<QString, quint32> &urlToIndex)
+{
+    const QV4::CompiledData::Unit *unit = entry->unit();
+    const QUrl baseUrl(entry->url);
+
+    auto addDependency = [&](const QUrl &url) {
+        const auto it = urlToIndex.constFind(url.toString());
+        if (it != urlToIndex.constEnd() && *it != index && !entry->dependencies.contains(*it))
+            entry->dependencies.append(*it);
+    };
+
+    for (uint i = 0; i < unit->moduleRequestTableSize; ++i)
+        addDependency(baseUrl.resolved(QUrl(unit->stringAtInternal(unit->moduleRequestTable()[i]))));
+
+    if (!unit->offsetToQmlUnit)
+        return;
+
+    const QV4::CompiledData::QmlUnit *qmlUnit = unit->qmlUnit();
+
+    // Directories, by qualifier, that component names can be resolved in.
+    QMultiHash<QString, QUrl> directories;
+    directories.insert(QString(), baseUrl.resolved(QUrl(QLatin1String("."))));
+
+    for (uint i = 0; i < qmlUnit->nImports; ++i) {
+        const QV4::CompiledData::Import *import = qmlUnit->importAt(i);
+        const QUrl importUrl = baseUrl.resolved(QUrl(unit->stringAtInternal(import->uriIndex)));
+        switch (import->type) {
+        case QV4::CompiledData::Import::ImportScript:
+            addDependency(importUrl);
+            break;
+        case QV4::CompiledData::Import::ImportFile: {
+            QString directory = importUrl.toString();
+            if (!directory.endsWith(QLatin1Char('/')))
+                directory += QLatin1Char('/');
+            directories.insert(unit->stringAtInternal(import->qualifierIndex), QUrl(directory));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    for (uint i = 0; i < qmlUnit->nObjects; ++i) {
+        const QV4::CompiledData::Object *object = qmlUnit->objectAt(i);
+        if (object->inheritedTypeNameIndex == 0)
+            continue;
+
+        QString qualifier;
+        QString typeName = unit->stringAtInternal(object->inheritedTypeNameIndex);
+        const qsizetype dot = typeName.indexOf(QLatin1Char('.'));
+        if (dot != -1 && directories.contains(typeName.left(dot))) {
+            qualifier = typeName.left(dot);
+            typeName = typeName.mid(dot + 1);
+        }
+
+        // Inline components are part of the unit that declares them.
+        const qsizetype inlineComponent = typeName.indexOf(QLatin1Char('.'));
+        if (inlineComponent != -1)
+            typeName.truncate(inlineComponent);
+
+        const QUrl fileName(typeName + QLatin1String(".qml"));
+        for (const QUrl &directory : directories.values(qualifier))
+            addDependency(directory.resolved(fileName));
+    }
+}
+
+static void writeString(QByteArray *out, const QString &string)
+{
+    const qsizetype start = out->size();
+    out->resize(start + QV4::CompiledData::String::calculateSize(string), '\0');
+    char *data = out->data() + start;
+
+    const qint32_le size(string.size());
+    memcpy(data, &size, sizeof(size));
+    quint16_le *characters = reinterpret_cast<quint16_le *>(data + sizeof(QV4::CompiledData::String));
+    for (qsizetype i = 0; i < string.size(); ++i)
+        characters[i] = string.at(i).unicode();
+}
+
+static void writeWord(QByteArray *out, qsizetype offset, quint32 value)
+{
+    qToLittleEndian<quint32>(value, out->data() + offset);
+}
+
+bool qQmlJSGenerateBundle(const QStringList &compiledFiles, const QString &outputFileName,
+                          QString *errorString)
+{
+    QList<BundleEntry> entries(compiledFiles.size());
+    QHash<QString, quint32> urlToIndex;
+    for (qsizetype i = 0; i < compiledFiles.size(); ++i) {
+        BundleEntry &entry = entries[i];
+        if (!readCompiledFile(compiledFiles.at(i), &entry, errorString))
+            return false;
+        if (urlToIndex.contains(entry.url)) {
+            *errorString = QLatin1String("Duplicate compilation unit for ") + entry.url;
+            return false;
+        }
+        urlToIndex.insert(entry.url, quint32(i));
+    }
+
+    for (qsizetype i = 0; i < entries.size(); ++i)
+        resolveDependencies(&entries[i], quint32(i), urlToIndex);
+
+    QByteArray out(sizeof(QV4::CompiledData::Bundle), '\0');
+
+    // The only strings the bundle needs on its own are the unit URLs, which are unique.
+    const qsizetype offsetToStringTable = out.size();
+    out.resize(alignedSize(out.size() + entries.size() * sizeof(quint32_le), 8), '\0');
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        writeWord(&out, offsetToStringTable + i * sizeof(quint32_le), quint32(out.size()));
+        writeString(&out, entries.at(i).url);
+    }
+
+    const qsizetype offsetToUnitTable = out.size();
+    out.resize(out.size() + entries.size() * sizeof(QV4::CompiledData::BundleUnit), '\0');
+
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        const qsizetype bundleUnit = offsetToUnitTable + i * sizeof(QV4::CompiledData::BundleUnit);
+        const QList<quint32> &dependencies = entries.at(i).dependencies;
+        writeWord(&out, bundleUnit + offsetof(QV4::CompiledData::BundleUnit, urlIndex), quint32(i));
+        writeWord(&out, bundleUnit + offsetof(QV4::CompiledData::BundleUnit, nDependencies),
+                  quint32(dependencies.size()));
+        writeWord(&out, bundleUnit + offsetof(QV4::CompiledData::BundleUnit, offsetToDependencies),
+                  quint32(out.size()));
+        for (quint32 dependency : dependencies) {
+            const qsizetype offset = out.size();
+            out.resize(offset + sizeof(quint32_le));
+            writeWord(&out, offset, dependency);
+        }
+    }
+
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        const qsizetype bundleUnit = offsetToUnitTable + i * sizeof(QV4::CompiledData::BundleUnit);
+        out.resize(alignedSize(out.size(), UnitAlignment), '\0');
+        writeWord(&out, bundleUnit + offsetof(QV4::CompiledData::BundleUnit, offsetToUnit),
+                  quint32(out.size()));
+        out.append(entries.at(i).data);
+    }
+
+    QV4::CompiledData::Bundle header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, QV4::CompiledData::bundle_magic_str, sizeof(header.magic));
+    header.version = QV4_DATA_STRUCTURE_VERSION;
+    header.qtVersion = QT_VERSION;
+    header.bundleSize = quint32(out.size());
+    header.stringTableSize = quint32(entries.size());
+    header.offsetToStringTable = quint32(offsetToStringTable);
+    header.unitTableSize = quint32(entries.size());
+    header.offsetToUnitTable = quint32(offsetToUnitTable);
+    memcpy(out.data(), &header, sizeof(header));
+
+#if QT_CONFIG(temporaryfile)
+    QSaveFile f(outputFileName);
+#else
+    QFile f(outputFileName);
+#endif
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = f.errorString();
+        return false;
+    }
+
+    if (f.write(out) != out.size()) {
+        *errorString = f.errorString();
+        return false;
+    }
+
+#if QT_CONFIG(temporaryfile)
+    if (!f.commit()) {
+        *errorString = f.errorString();
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+QT_END_NAMESPACE
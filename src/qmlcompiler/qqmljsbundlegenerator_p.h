@@ -0,0 +1,31 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QQMLJSBUNDLEGENERATOR_P_H
+#define QQMLJSBUNDLEGENERATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#include <private/qtqmlcompilerexports_p.h>
+
+#include <QtCore/qstring.h>
+#include <QtCore/qlist.h>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+bool Q_QMLCOMPILER_PRIVATE_EXPORT qQmlJSGenerateBundle(const QStringList &compiledFiles,
+                                                       const QString &outputFileName,
+                                                       QString *errorString);
+
+QT_END_NAMESPACE
+
+#endif // QQMLJSBUNDLEGENERATOR_P_H
@@ -601,10 +601,16 @@ void QQmlJSCodeGenerator::generate_LoadQmlContextPropertyLookup(int index)
 
     const QString indexString = QString::number(index);
     if (m_state.accumulatorOut().variant() == QQmlJSRegisterContent::ObjectById) {
-        const QString lookup = u"aotContext->loadContextIdLookup("_s
+        // If the id belongs to an enclosing component we know which one at compile time. The
+        // runtime can then find its context without looking up the name on each access.
+        const QString kind
+                = m_typeResolver->objectsById().isInEnclosingComponent(name, m_function->qmlScope)
+                ? u"EnclosingContextIdLookup"_s
+                : u"ContextIdLookup"_s;
+        const QString lookup = u"aotContext->load"_s + kind + u'('
                 + indexString + u", "_s
                 + contentPointer(m_state.accumulatorOut(), m_state.accumulatorVariableOut) + u')';
-        const QString initialization = u"aotContext->initLoadContextIdLookup("_s
+        const QString initialization = u"aotContext->initLoad"_s + kind + u'('
                 + indexString + u')';
         generateLookup(lookup, initialization);
         return;
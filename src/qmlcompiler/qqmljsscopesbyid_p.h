@@ -65,6 +65,18 @@ public:
         return QQmlJSScope::ConstPtr();
     }
 
+    /*!
+        \internal
+        Returns \c true if the scope with id \a id, as seen from \a referrer, belongs to a
+        component enclosing the one \a referrer belongs to. This is only possible if the
+        components are bound.
+     */
+    bool isInEnclosingComponent(const QString &id, const QQmlJSScope::ConstPtr &referrer) const
+    {
+        const QQmlJSScope::ConstPtr identified = scope(id, referrer);
+        return identified && componentRoot(identified) != componentRoot(referrer);
+    }
+
     void insert(const QString &id, const QQmlJSScope::ConstPtr &scope)
     {
         Q_ASSERT(!id.isEmpty());
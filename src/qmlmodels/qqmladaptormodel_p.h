@@ -37,6 +37,12 @@ class QQmlDelegateModelItemMetaType;
 class Q_QMLMODELS_PRIVATE_EXPORT QQmlAdaptorModel : public QQmlGuard<QObject>
 {
 public:
+    enum NotifyMode {
+        NotifyImmediately,
+        // The change signals may be deferred until the engine's binding batch is flushed
+        NotifyDeferrable
+    };
+
     class Accessors
     {
     public:
@@ -59,7 +65,8 @@ public:
                 const QList<QQmlDelegateModelItem *> &,
                 int,
                 int,
-                const QVector<int> &) const { return false; }
+                const QVector<int> &,
+                NotifyMode) const { return false; }
         virtual void replaceWatchedRoles(
                 QQmlAdaptorModel &,
                 const QList<QByteArray> &,
@@ -123,8 +130,9 @@ public:
             const QList<QQmlDelegateModelItem *> &items,
             int index,
             int count,
-            const QVector<int> &roles) const {
-        return accessors->notify(*this, items, index, count, roles); }
+            const QVector<int> &roles,
+            NotifyMode mode = NotifyImmediately) const {
+        return accessors->notify(*this, items, index, count, roles, mode); }
     inline void replaceWatchedRoles(
             const QList<QByteArray> &oldRoles, const QList<QByteArray> &newRoles) {
         accessors->replaceWatchedRoles(*this, oldRoles, newRoles); }
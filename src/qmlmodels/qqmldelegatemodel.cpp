@@ -1453,20 +1453,26 @@ void QQmlDelegateModelPrivate::itemsChanged(const QVector<Compositor::Change> &c
         QQmlDelegateModelGroupPrivate::get(m_groups[i])->changeSet.change(translatedChanges.at(i));
 }
 
-void QQmlDelegateModel::_q_itemsChanged(int index, int count, const QVector<int> &roles)
+void QQmlDelegateModelPrivate::itemsChanged(
+        int index, int count, const QVector<int> &roles, QQmlAdaptorModel::NotifyMode mode)
 {
-    Q_D(QQmlDelegateModel);
-    if (count <= 0 || !d->m_complete)
+    if (count <= 0 || !m_complete)
         return;
 
-    if (d->m_adaptorModel.notify(d->m_cache, index, count, roles)) {
+    if (m_adaptorModel.notify(m_cache, index, count, roles, mode)) {
         QVector<Compositor::Change> changes;
-        d->m_compositor.listItemsChanged(&d->m_adaptorModel, index, count, &changes);
-        d->itemsChanged(changes);
-        d->emitChanges();
+        m_compositor.listItemsChanged(&m_adaptorModel, index, count, &changes);
+        itemsChanged(changes);
+        emitChanges();
     }
 }
 
+void QQmlDelegateModel::_q_itemsChanged(int index, int count, const QVector<int> &roles)
+{
+    Q_D(QQmlDelegateModel);
+    d->itemsChanged(index, count, roles, QQmlAdaptorModel::NotifyImmediately);
+}
+
 static void incrementIndexes(QQmlDelegateModelItem *cacheItem, int count, const int *deltas)
 {
     if (QQDMIncubationTask *incubationTask = cacheItem->incubationTask) {
@@ -2013,8 +2019,10 @@ void QQmlDelegateModel::_q_columnsMoved(const QModelIndex &parent, int start, in
 void QQmlDelegateModel::_q_dataChanged(const QModelIndex &begin, const QModelIndex &end, const QVector<int> &roles)
 {
     Q_D(QQmlDelegateModel);
-    if (begin.parent() == d->m_adaptorModel.rootIndex)
-        _q_itemsChanged(begin.row(), end.row() - begin.row() + 1, roles);
+    if (begin.parent() == d->m_adaptorModel.rootIndex) {
+        d->itemsChanged(begin.row(), end.row() - begin.row() + 1, roles,
+                        QQmlAdaptorModel::NotifyDeferrable);
+    }
 }
 
 bool QQmlDelegateModel::isDescendantOf(const QPersistentModelIndex& desc, const QList< QPersistentModelIndex >& parents) const
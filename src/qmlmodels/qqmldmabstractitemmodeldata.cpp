@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include <private/qqmldmabstractitemmodeldata_p.h>
+#include <private/qqmlengine_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,6 +57,39 @@ int QQmlDMAbstractItemModelData::metaCall(QMetaObject::Call call, int id, void *
     }
 }
 
+/*!
+    \internal
+
+    Marks the properties with the given \a propertyIds as changed, without emitting their change
+    signals yet. Returns \c true if no change signals were deferred for this item before.
+*/
+bool QQmlDMAbstractItemModelData::deferNotifications(const QVector<int> &propertyIds)
+{
+    const bool wasClean = m_dirtyProperties.isEmpty();
+    if (wasClean)
+        m_dirtyProperties.resize(m_type->propertyRoles.size());
+    for (int propertyId : propertyIds)
+        m_dirtyProperties.setBit(propertyId);
+    return wasClean;
+}
+
+void QQmlDMAbstractItemModelData::emitDeferredNotifications()
+{
+    const QBitArray dirtyProperties = std::exchange(m_dirtyProperties, QBitArray());
+    if (dirtyProperties.isEmpty())
+        return;
+
+    QQmlGuard<QQmlDMAbstractItemModelData> guard(this);
+    for (qsizetype propertyId = 0, end = dirtyProperties.size(); propertyId < end; ++propertyId) {
+        if (!dirtyProperties.testBit(propertyId))
+            continue;
+        QMetaObject::activate(this, propertyId + m_type->signalOffset, nullptr);
+        if (guard.isNull())
+            return;
+    }
+    emit modelDataChanged();
+}
+
 void QQmlDMAbstractItemModelData::setValue(const QString &role, const QVariant &value)
 {
     // Used only for initialization of the cached data. Does not have to emit change signals.
@@ -250,4 +284,56 @@ QV4::ReturnedValue QQmlDMAbstractItemModelData::get()
     return o.asReturnedValue();
 }
 
+/*!
+    \internal
+
+    Defers the change signals with the given \a signalIndexes of the \a items in the range
+    given by \a index and \a count until the binding batch of the engine is flushed. Several
+    changes of the same item are coalesced into one signal per property this way, emitted right
+    before the bindings depending on them are evaluated. Returns \c false if the engine does
+    not batch binding updates, in which case the signals have to be emitted right away.
+*/
+bool VDMAbstractItemModelDataType::deferNotifications(
+        const QList<QQmlDelegateModelItem *> &items, int index, int count,
+        const QVector<int> &signalIndexes) const
+{
+    QQmlBindingBatch *batch = nullptr;
+    QVector<int> propertyIds;
+
+    for (QQmlDelegateModelItem *item : items) {
+        const int idx = item->modelIndex();
+        if (idx < index || idx >= index + count)
+            continue;
+
+        if (!batch) {
+            if (QQmlEnginePrivate *ep = QQmlEnginePrivate::get(item->metaType->v4Engine))
+                batch = ep->bindingBatch;
+            if (!batch)
+                return false;
+            propertyIds.reserve(signalIndexes.size());
+            for (int signalIndex : signalIndexes)
+                propertyIds.append(signalIndex - signalOffset);
+        }
+
+        Q_ASSERT(qobject_cast<QQmlDMAbstractItemModelData *>(item) == item);
+        auto data = static_cast<QQmlDMAbstractItemModelData *>(item);
+        if (data->deferNotifications(propertyIds))
+            dirtyItems.append(data);
+    }
+
+    if (batch && !dirtyItems.isEmpty())
+        batch->schedule(const_cast<VDMAbstractItemModelDataType *>(this));
+    return true;
+}
+
+void VDMAbstractItemModelDataType::emitDeferredNotifications()
+{
+    // Emitting may defer further changes, which are then emitted in the same flush.
+    const QList<QQmlGuard<QQmlDMAbstractItemModelData>> items = std::exchange(dirtyItems, {});
+    for (const QQmlGuard<QQmlDMAbstractItemModelData> &item : items) {
+        if (!item.isNull())
+            item->emitDeferredNotifications();
+    }
+}
+
 QT_END_NAMESPACE
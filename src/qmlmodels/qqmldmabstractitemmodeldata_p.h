@@ -17,8 +17,11 @@
 
 #include <private/qqmladaptormodelenginedata_p.h>
 #include <private/qqmldelegatemodel_p_p.h>
+#include <private/qqmlbindingbatch_p.h>
 #include <private/qobject_p.h>
 
+#include <QtCore/qbitarray.h>
+
 QT_BEGIN_NAMESPACE
 
 class VDMAbstractItemModelDataType;
@@ -61,6 +64,9 @@ public:
 
     const VDMAbstractItemModelDataType *type() const { return m_type; }
 
+    bool deferNotifications(const QVector<int> &propertyIds);
+    void emitDeferredNotifications();
+
 Q_SIGNALS:
     void modelDataChanged();
 
@@ -70,12 +76,16 @@ private:
 
     VDMAbstractItemModelDataType *m_type;
     QVector<QVariant> m_cachedData;
+
+    // The properties whose change signals are deferred until the binding batch is flushed
+    QBitArray m_dirtyProperties;
 };
 
 class VDMAbstractItemModelDataType final
         : public QQmlRefCounted<VDMAbstractItemModelDataType>
         , public QQmlAdaptorModel::Accessors
         , public QAbstractDynamicMetaObject
+        , public QQmlBindingBatch::Notifier
 {
 public:
     VDMAbstractItemModelDataType(QQmlAdaptorModel *model)
@@ -90,7 +100,8 @@ public:
             const QList<QQmlDelegateModelItem *> &items,
             int index,
             int count,
-            const QVector<int> &roles) const override
+            const QVector<int> &roles,
+            QQmlAdaptorModel::NotifyMode mode) const override
     {
         bool changed = roles.isEmpty() && !watchedRoles.isEmpty();
         if (!changed && !watchedRoles.isEmpty() && watchedRoleIds.isEmpty()) {
@@ -120,6 +131,11 @@ public:
                 signalIndexes.append(propertyId + signalOffset);
         }
 
+        if (mode == QQmlAdaptorModel::NotifyDeferrable && !signalIndexes.isEmpty()
+                && deferNotifications(items, index, count, signalIndexes)) {
+            return changed;
+        }
+
         QVarLengthArray<QQmlGuard<QQmlDMAbstractItemModelData>> guardedItems;
         for (const auto item : items) {
             Q_ASSERT(qobject_cast<QQmlDMAbstractItemModelData *>(item) == item);
@@ -140,6 +156,13 @@ public:
         return changed;
     }
 
+    bool deferNotifications(
+            const QList<QQmlDelegateModelItem *> &items,
+            int index,
+            int count,
+            const QVector<int> &signalIndexes) const;
+    void emitDeferredNotifications() override;
+
     void replaceWatchedRoles(
             QQmlAdaptorModel &,
             const QList<QByteArray> &oldRoles,
@@ -323,6 +346,8 @@ public:
     QList<int> propertyRoles;
     QList<int> watchedRoleIds;
     QList<QByteArray> watchedRoles;
+    // Items with deferred change signals, see deferNotifications()
+    mutable QList<QQmlGuard<QQmlDMAbstractItemModelData>> dirtyItems;
     QHash<QByteArray, int> roleNames;
     QQmlAdaptorModel *model;
     int propertyOffset;
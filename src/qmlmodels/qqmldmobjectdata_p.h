@@ -132,7 +132,7 @@ public:
         release();
     }
 
-    bool notify(const QQmlAdaptorModel &model, const QList<QQmlDelegateModelItem *> &items, int index, int count, const QVector<int> &) const override
+    bool notify(const QQmlAdaptorModel &model, const QList<QQmlDelegateModelItem *> &items, int index, int count, const QVector<int> &, QQmlAdaptorModel::NotifyMode) const override
     {
         for (auto modelItem : items) {
             const int modelItemIndex = modelItem->index;
@@ -458,7 +458,8 @@ void QQmlTableInstanceModel::dataChangedCallback(const QModelIndex &begin, const
     for (int column = 0; column < numberOfColumnsChanged; ++column) {
         const int columnIndex = begin.column() + column;
         const int rowIndex = begin.row() + (columnIndex * rows());
-        m_adaptorModel.notify(m_modelItems.values(), rowIndex, numberOfRowsChanged, roles);
+        m_adaptorModel.notify(m_modelItems.values(), rowIndex, numberOfRowsChanged, roles,
+                              QQmlAdaptorModel::NotifyDeferrable);
     }
 }
 
@@ -2075,6 +2075,10 @@ bool QQuickItemPrivate::setFocusIfNeeded(QEvent::Type eventType)
     \value ItemIsViewport Indicates that the item defines a viewport for its children.
     \value ItemObservesViewport Indicates that the item wishes to know the
     viewport bounds when any ancestor has the ItemIsViewport flag set.
+    \value ItemHasThreadSafeUpdatePaintNode (since Qt 6.8) Indicates that the
+    item's updatePaintNode() only accesses the item itself and the nodes it
+    returns, so that it may be called concurrently with updatePaintNode() of
+    other items. See \l {Concurrent Synchronization} for the details.
 
     \sa setFlag(), setFlags(), flags()
 */
@@ -140,6 +140,7 @@ public:
         ItemAcceptsDrops          = 0x10,
         ItemIsViewport            = 0x20,
         ItemObservesViewport      = 0x40,
+        ItemHasThreadSafeUpdatePaintNode = 0x80,
         // Remember to increment the size of QQuickItemPrivate::flags
     };
     Q_DECLARE_FLAGS(Flags, Flag)
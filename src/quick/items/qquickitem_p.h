@@ -442,7 +442,7 @@ public:
     inline QQuickItem::TransformOrigin origin() const;
 
     // Bit 0
-    quint32 flags:7;
+    quint32 flags:8;
     quint32 widthValidFlag:1;
     quint32 heightValidFlag:1;
     quint32 componentComplete:1;
@@ -452,7 +452,7 @@ public:
     quint32 smooth:1;
     quint32 antialiasing:1;
     quint32 focus:1;
-    // Bit 16
+    // Bit 17
     quint32 activeFocus:1;
     quint32 notifiedFocus:1;
     quint32 notifiedActiveFocus:1;
@@ -469,7 +469,7 @@ public:
     quint32 inheritMirrorFromItem:1;
     quint32 isAccessible:1;
     quint32 culled:1;
-    // Bit 32
+    // Bit 33
     quint32 hasCursor:1;
     quint32 subtreeCursorEnabled:1;
     quint32 subtreeHoverEnabled:1;
@@ -483,7 +483,7 @@ public:
     // focus chain and prevents tabbing outside.
     quint32 isTabFence:1;
     quint32 replayingPressEvent:1;
-    // Bit 40
+    // Bit 41
     quint32 touchEnabled:1;
     quint32 hasCursorHandler:1;
     // set true when this item does not expect events via a subscene delivery agent; false otherwise
@@ -494,7 +494,7 @@ public:
     quint32 inDestructor:1; // has entered ~QQuickItem
     quint32 focusReason:4;
     quint32 focusPolicy:4;
-    // Bit 53
+    // Bit 54
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
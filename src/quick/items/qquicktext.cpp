@@ -440,6 +440,7 @@ void QQuickTextPrivate::updateSize()
         // There may be subtle differences in the height and baseline calculations between
         // QTextLayout and QFontMetrics and the number of variables that can affect the size
         // and position of a line is increasing.
+        sharedLayout.reset();
         QFontMetricsF fm(font);
         qreal fontHeight = qCeil(fm.height());  // QScriptLine and therefore QTextLine rounds up
         if (!richText) {                        // line height, so we will as well.
@@ -473,6 +474,7 @@ void QQuickTextPrivate::updateSize()
         size = textRect.size();
         updateBaseline(baseline, q->height() - size.height() - vPadding);
     } else {
+        sharedLayout.reset();
         widthExceeded = true; // always relayout rich text on width changes..
         heightExceeded = false; // rich text layout isn't affected by height changes.
         ensureDoc();
@@ -693,11 +695,11 @@ void QQuickTextPrivate::setupCustomLineGeometry(QTextLine &line, qreal &height,
     height += textLine->height();
 }
 
-void QQuickTextPrivate::elideFormats(
-        const int start, const int length, int offset, QVector<QTextLayout::FormatRange> *elidedFormats)
+void QQuickTextPrivate::elideFormats(const QTextLayout &textLayout, const int start, const int length,
+                                     int offset, QVector<QTextLayout::FormatRange> *elidedFormats)
 {
     const int end = start + length;
-    const QVector<QTextLayout::FormatRange> formats = layout.formats();
+    const QVector<QTextLayout::FormatRange> formats = textLayout.formats();
     for (int i = 0; i < formats.size(); ++i) {
         QTextLayout::FormatRange format = formats.at(i);
         const int formatLength = qMin(format.start + format.length, end) - qMax(format.start, start);
@@ -709,23 +711,24 @@ void QQuickTextPrivate::elideFormats(
     }
 }
 
-QString QQuickTextPrivate::elidedText(qreal lineWidth, const QTextLine &line, const QTextLine *nextLine) const
+QString QQuickTextPrivate::elidedText(const QTextLayout &textLayout, qreal lineWidth,
+                                     const QTextLine &line, const QTextLine *nextLine) const
 {
     if (nextLine) {
-        return layout.engine()->elidedText(
+        return textLayout.engine()->elidedText(
                 Qt::TextElideMode(elideMode),
                 QFixed::fromReal(lineWidth),
                 0,
                 line.textStart(),
                 line.textLength() + nextLine->textLength());
     } else {
-        QString elideText = layout.text().mid(line.textStart(), line.textLength());
+        QString elideText = textLayout.text().mid(line.textStart(), line.textLength());
         if (!styledText) {
             // QFontMetrics won't help eliding styled text.
             elideText[elideText.size() - 1] = elideChar;
             // Appending the elide character may push the line over the maximum width
             // in which case the elided text will need to be elided.
-            QFontMetricsF metrics(layout.font());
+            QFontMetricsF metrics(textLayout.font());
             if (metrics.horizontalAdvance(elideChar) + line.naturalTextWidth() >= lineWidth)
                 elideText = metrics.elidedText(elideText, Qt::TextElideMode(elideMode), lineWidth);
         }
@@ -743,14 +746,175 @@ void QQuickTextPrivate::clearFormats()
 /*!
     Lays out the QQuickTextPrivate::layout QTextLayout in the constraints of the QQuickText.
 
+    Plain text is laid out in a layout shared through the QQuickTextLayoutCache of the window
+    instead, and if another item has laid out the same text with the same parameters before,
+    its layout is used as it is. QQuickTextPrivate::sharedLayout then holds the layouts to paint.
+
     Returns the size of the final text.  This can be used to position the text vertically (the text is
     already absolutely positioned horizontally).
 */
-
 QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
 {
     Q_Q(QQuickText);
 
+    QQuickTextLayoutCache *cache = isLayoutCacheable()
+            ? QQuickTextLayoutCache::forWindow(q->window())
+            : nullptr;
+    if (!cache) {
+        sharedLayout.reset();
+        return setupTextLayout(layout, elideLayout, baseline);
+    }
+
+    // Laying out the text makes the implicit size valid, the key depends on what it was before.
+    const bool widthWasValid = implicitWidthValid;
+    const bool heightWasValid = implicitHeightValid;
+    QQuickTextLayoutCache::Key key = layoutCacheKey(widthWasValid, heightWasValid);
+    if (QSharedPointer<QQuickTextLayoutCache::Entry> entry = cache->find(key)) {
+        if (useSharedLayout(entry, key, baseline))
+            return entry->boundingRect;
+        // The new implicit size has changed the size of the item
+        key = layoutCacheKey(widthWasValid, heightWasValid);
+    }
+
+    auto entry = QSharedPointer<QQuickTextLayoutCache::Entry>::create();
+    entry->layout.setText(layout.text());
+    const QRectF br = setupTextLayout(entry->layout, entry->elideLayout, baseline);
+
+    entry->boundingRect = br;
+    entry->advance = advance;
+    entry->implicitSize = QSizeF(implicitWidth, implicitHeight);
+    entry->baseline = *baseline;
+    entry->lineWidth = lineWidth;
+    entry->lineCount = lineCount;
+    entry->truncated = truncated;
+    entry->widthExceeded = widthExceeded;
+    entry->heightExceeded = heightExceeded;
+
+    // Only share the layout if it did not change the size of the item, and if there is text
+    // left to show.
+    if (lineCount > 0 && layoutCacheKey(widthWasValid, heightWasValid) == key)
+        cache->insert(key, entry);
+
+    delete elideLayout;
+    elideLayout = nullptr;
+    sharedLayout = std::move(entry);
+    return br;
+}
+
+bool QQuickTextPrivate::isLayoutCacheable()
+{
+    return !richText && !styledText && multilengthEos == -1
+            && fontSizeMode() == QQuickText::FixedSize
+            && layout.text().size() <= QQuickTextLayoutCache::MaximumTextLength
+            && layout.formats().isEmpty()
+            && !isLineLaidOutConnected();
+}
+
+/*!
+    Returns the parameters of the layout of the text, given whether the implicit width and
+    height of the item were valid before the text is laid out. The size of the item is left out when the
+    layout does not depend on it, so that items which are sized to their text can share it.
+*/
+QQuickTextLayoutCache::Key QQuickTextPrivate::layoutCacheKey(bool implicitWidthKnown,
+                                                             bool implicitHeightKnown) const
+{
+    Q_Q(const QQuickText);
+
+    const bool widthMatters = q->widthValid() || implicitWidthKnown;
+    const bool heightMatters = q->heightValid()
+            || (elideMode == QQuickText::ElideRight && maximumLineCountValid);
+
+    QQuickTextLayoutCache::Key key;
+    key.text = layout.text();
+    key.font = font;
+    key.width = widthMatters ? q->width() : 0;
+    key.height = heightMatters ? q->height() : 0;
+    key.padding = QMarginsF(q->leftPadding(), q->topPadding(), q->rightPadding(), q->bottomPadding());
+    key.lineHeight = lineHeight();
+    key.maximumLineCount = maximumLineCount();
+    key.options = quint32(q->effectiveHAlign())
+            | quint32(wrapMode) << 4
+            | quint32(elideMode) << 7
+            | quint32(renderType) << 9
+            | quint32(lineHeightMode()) << 11
+            | quint32(q->widthValid()) << 12
+            | quint32(q->heightValid()) << 13
+            | quint32(maximumLineCountValid) << 14
+            | quint32(requireImplicitSize) << 15
+            | quint32(implicitWidthKnown) << 16
+            | quint32(implicitHeightKnown) << 17;
+    return key;
+}
+
+/*!
+    Takes over the results of laying out the text from  entry, as if setupTextLayout() had
+    computed them. Returns \c false, without changing anything but the implicit size, if the
+    new implicit size causes the size of the item to change, so that  key no longer applies.
+*/
+bool QQuickTextPrivate::useSharedLayout(const QSharedPointer<QQuickTextLayoutCache::Entry> &entry,
+                                        const QQuickTextLayoutCache::Key &key, qreal *const baseline)
+{
+    Q_Q(QQuickText);
+
+    bool wasInLayout = internalWidthUpdate;
+    internalWidthUpdate = true;
+    q->setImplicitSize(entry->implicitSize.width(), entry->implicitSize.height());
+    internalWidthUpdate = wasInLayout;
+    if (layoutCacheKey(implicitWidthValid, implicitHeightValid) != key)
+        return false;
+
+    const bool wasTruncated = truncated;
+
+    if (extra.isAllocated())
+        extra->visibleImgTags.clear();
+    delete elideLayout;
+    elideLayout = nullptr;
+    sharedLayout = entry;
+
+    lineWidth = entry->lineWidth;
+    advance = entry->advance;
+    truncated = entry->truncated;
+    widthExceeded = entry->widthExceeded;
+    heightExceeded = entry->heightExceeded;
+    implicitWidthValid = true;
+    implicitHeightValid = true;
+    *baseline = entry->baseline;
+
+    updateFontInfo(font);
+    assignedFont = QFontInfo(font).family();
+
+    if (lineCount != entry->lineCount) {
+        lineCount = entry->lineCount;
+        emit q->lineCountChanged();
+    }
+
+    if (truncated != wasTruncated)
+        emit q->truncatedChanged();
+
+    return true;
+}
+
+void QQuickTextPrivate::updateFontInfo(const QFont &layoutFont)
+{
+    Q_Q(QQuickText);
+
+    QFontInfo layoutFontInfo(layoutFont);
+    if (fontInfo.weight() != layoutFontInfo.weight()
+            || fontInfo.pixelSize() != layoutFontInfo.pixelSize()
+            || fontInfo.italic() != layoutFontInfo.italic()
+            || !qFuzzyCompare(fontInfo.pointSizeF(), layoutFontInfo.pointSizeF())
+            || fontInfo.family() != layoutFontInfo.family()
+            || fontInfo.styleName() != layoutFontInfo.styleName()) {
+        fontInfo = layoutFontInfo;
+        emit q->fontInfoChanged();
+    }
+}
+
+QRectF QQuickTextPrivate::setupTextLayout(QTextLayout &textLayout, QTextLayout *&textElideLayout,
+                                          qreal *const baseline)
+{
+    Q_Q(QQuickText);
+
     bool singlelineElide = elideMode != QQuickText::ElideNone && q->widthValid();
     bool multilineElide = elideMode == QQuickText::ElideRight
             && q->widthValid()
@@ -774,7 +938,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         }
 
         if (qFuzzyIsNull(q->width())) {
-            layout.setText(QString());
+            textLayout.setText(QString());
             textHasChanged = true;
         }
 
@@ -787,18 +951,18 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     bool shouldUseDesignMetrics = renderType != QQuickText::NativeRendering;
     if (extra.isAllocated())
         extra->visibleImgTags.clear();
-    layout.setCacheEnabled(true);
-    QTextOption textOption = layout.textOption();
+    textLayout.setCacheEnabled(true);
+    QTextOption textOption = textLayout.textOption();
     if (textOption.alignment() != q->effectiveHAlign()
             || textOption.wrapMode() != QTextOption::WrapMode(wrapMode)
             || textOption.useDesignMetrics() != shouldUseDesignMetrics) {
         textOption.setAlignment(Qt::Alignment(q->effectiveHAlign()));
         textOption.setWrapMode(QTextOption::WrapMode(wrapMode));
         textOption.setUseDesignMetrics(shouldUseDesignMetrics);
-        layout.setTextOption(textOption);
+        textLayout.setTextOption(textOption);
     }
-    if (layout.font() != font)
-        layout.setFont(font);
+    if (textLayout.font() != font)
+        textLayout.setFont(font);
 
     lineWidth = (q->widthValid() || implicitWidthValid) && q->width() > 0
             ? q->width()
@@ -815,7 +979,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             && (q->heightValid() || (maximumLineCountValid && canWrap));
 
     const bool pixelSize = font.pixelSize() != -1;
-    QString layoutText = layout.text();
+    QString layoutText = textLayout.text();
 
     const qreal minimumSize = pixelSize
                             ? static_cast<qreal>(minimumPixelSize())
@@ -855,11 +1019,11 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                 scaledFont.setPixelSize(scaledFontSize);
             else
                 scaledFont.setPointSizeF(scaledFontSize);
-            if (layout.font() != scaledFont)
-                layout.setFont(scaledFont);
+            if (textLayout.font() != scaledFont)
+                textLayout.setFont(scaledFont);
         }
 
-        layout.beginLayout();
+        textLayout.beginLayout();
 
         bool wrapped = false;
         bool truncateHeight = false;
@@ -875,17 +1039,17 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         QRectF unelidedRect;
         QTextLine line;
         for (visibleCount = 1; ; ++visibleCount) {
-            line = layout.createLine();
+            line = textLayout.createLine();
 
             if (noBreakLastLine && visibleCount == maxLineCount)
-                layout.engine()->option.setWrapMode(QTextOption::WrapAnywhere);
+                textLayout.engine()->option.setWrapMode(QTextOption::WrapAnywhere);
             if (customLayout) {
                 setupCustomLineGeometry(line, naturalHeight, layoutText.size());
             } else {
                 setLineGeometry(line, lineWidth, naturalHeight);
             }
             if (noBreakLastLine && visibleCount == maxLineCount)
-                layout.engine()->option.setWrapMode(QTextOption::WrapMode(wrapMode));
+                textLayout.engine()->option.setWrapMode(QTextOption::WrapMode(wrapMode));
 
             unelidedRect = br.united(line.naturalTextRect());
 
@@ -902,10 +1066,10 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
 
                 visibleCount -= 1;
 
-                const QTextLine previousLine = layout.lineAt(visibleCount - 1);
+                const QTextLine previousLine = textLayout.lineAt(visibleCount - 1);
                 elideText = layoutText.at(line.textStart() - 1) != QChar::LineSeparator
-                        ? elidedText(line.width(), previousLine, &line)
-                        : elidedText(line.width(), previousLine);
+                        ? elidedText(textLayout, line.width(), previousLine, &line)
+                        : elidedText(textLayout, line.width(), previousLine);
                 elideStart = previousLine.textStart();
                 // elideEnd isn't required for right eliding.
 
@@ -923,7 +1087,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                         break;
 
                     truncated = true;
-                    elideText = layout.engine()->elidedText(
+                    elideText = textLayout.engine()->elidedText(
                             Qt::TextElideMode(elideMode),
                             QFixed::fromReal(line.width()),
                             0,
@@ -953,10 +1117,10 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                         if (eos != -1)  // There's an abbreviated string available
                             break;
 
-                        const QTextLine nextLine = layout.createLine();
+                        const QTextLine nextLine = textLayout.createLine();
                         elideText = wrappedLine
-                                ? elidedText(line.width(), line, &nextLine)
-                                : elidedText(line.width(), line);
+                                ? elidedText(textLayout, line.width(), line, &nextLine)
+                                : elidedText(textLayout, line.width(), line);
                         elideStart = line.textStart();
                         // elideEnd isn't required for right eliding.
                     } else {
@@ -981,8 +1145,8 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             if ((requireImplicitSize) && line.isValid() && unwrappedLineCount < maxLineCount) {
                 // Layout the remainder of the wrapped lines up to maxLineCount to get the implicit
                 // height.
-                for (int lineCount = layout.lineCount(); lineCount < maxLineCount; ++lineCount) {
-                    line = layout.createLine();
+                for (int lineCount = textLayout.lineCount(); lineCount < maxLineCount; ++lineCount) {
+                    line = textLayout.createLine();
                     if (!line.isValid())
                         break;
                     if (layoutText.at(line.textStart() - 1) == QChar::LineSeparator)
@@ -996,13 +1160,13 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                         ? line.textStart() + line.textLength()
                         : layoutText.size();
                 if (eol < layoutText.size() && layoutText.at(eol) != QChar::LineSeparator)
-                    line = layout.createLine();
+                    line = textLayout.createLine();
                 for (; line.isValid() && unwrappedLineCount <= maxLineCount; ++unwrappedLineCount)
-                    line = layout.createLine();
+                    line = textLayout.createLine();
             }
-            layout.endLayout();
+            textLayout.endLayout();
 
-            const qreal naturalWidth = layout.maximumWidth();
+            const qreal naturalWidth = textLayout.maximumWidth();
 
             bool wasInLayout = internalWidthUpdate;
             internalWidthUpdate = true;
@@ -1059,14 +1223,14 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         } else if (widthChanged) {
             widthChanged = false;
             if (line.isValid()) {
-                for (int lineCount = layout.lineCount(); lineCount < maxLineCount; ++lineCount) {
-                    line = layout.createLine();
+                for (int lineCount = textLayout.lineCount(); lineCount < maxLineCount; ++lineCount) {
+                    line = textLayout.createLine();
                     if (!line.isValid())
                         break;
                     setLineGeometry(line, lineWidth, naturalHeight);
                 }
             }
-            layout.endLayout();
+            textLayout.endLayout();
 
             bool wasInLayout = internalWidthUpdate;
             internalWidthUpdate = true;
@@ -1090,7 +1254,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                 continue;
             }
         } else {
-            layout.endLayout();
+            textLayout.endLayout();
         }
 
         // If the next needs to be elided and there's an abbreviated string available
@@ -1100,7 +1264,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             eos = text.indexOf(QLatin1Char('\x9c'),  start);
             layoutText = text.mid(start, eos != -1 ? eos - start : -1);
             layoutText.replace(QLatin1Char('\n'), QChar::LineSeparator);
-            layout.setText(layoutText);
+            textLayout.setText(layoutText);
             textHasChanged = true;
             continue;
         }
@@ -1108,9 +1272,9 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         br.moveTop(0);
 
         // Find the advance of the text layout
-        if (layout.lineCount() > 0) {
-            QTextLine firstLine = layout.lineAt(0);
-            QTextLine lastLine = layout.lineAt(layout.lineCount() - 1);
+        if (textLayout.lineCount() > 0) {
+            QTextLine firstLine = textLayout.lineAt(0);
+            QTextLine lastLine = textLayout.lineAt(textLayout.lineCount() - 1);
             advance = QSizeF(lastLine.horizontalAdvance(),
                              lastLine.y() - firstLine.y());
         } else {
@@ -1166,16 +1330,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     implicitWidthValid = true;
     implicitHeightValid = true;
 
-    QFontInfo scaledFontInfo(scaledFont);
-    if (fontInfo.weight() != scaledFontInfo.weight()
-            || fontInfo.pixelSize() != scaledFontInfo.pixelSize()
-            || fontInfo.italic() != scaledFontInfo.italic()
-            || !qFuzzyCompare(fontInfo.pointSizeF(), scaledFontInfo.pointSizeF())
-            || fontInfo.family() != scaledFontInfo.family()
-            || fontInfo.styleName() != scaledFontInfo.styleName()) {
-        fontInfo = scaledFontInfo;
-        emit q->fontInfoChanged();
-    }
+    updateFontInfo(scaledFont);
 
     if (eos != multilengthEos)
         truncated = true;
@@ -1183,25 +1338,26 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     assignedFont = QFontInfo(font).family();
 
     if (elide) {
-        if (!elideLayout) {
-            elideLayout = new QTextLayout;
-            elideLayout->setCacheEnabled(true);
+        if (!textElideLayout) {
+            textElideLayout = new QTextLayout;
+            textElideLayout->setCacheEnabled(true);
         }
-        QTextEngine *engine = layout.engine();
+        QTextEngine *engine = textLayout.engine();
         if (engine && engine->hasFormats()) {
             QVector<QTextLayout::FormatRange> formats;
             switch (elideMode) {
             case QQuickText::ElideRight:
-                elideFormats(elideStart, elideText.size() - 1, 0, &formats);
+                elideFormats(textLayout, elideStart, elideText.size() - 1, 0, &formats);
                 break;
             case QQuickText::ElideLeft:
-                elideFormats(elideEnd - elideText.size() + 1, elideText.size() - 1, 1, &formats);
+                elideFormats(textLayout, elideEnd - elideText.size() + 1, elideText.size() - 1, 1, &formats);
                 break;
             case QQuickText::ElideMiddle: {
                 const int index = elideText.indexOf(elideChar);
                 if (index != -1) {
-                    elideFormats(elideStart, index, 0, &formats);
+                    elideFormats(textLayout, elideStart, index, 0, &formats);
                     elideFormats(
+                            textLayout,
                             elideEnd - elideText.size() + index + 1,
                             elideText.size() - index - 1,
                             index + 1,
@@ -1212,35 +1368,35 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             default:
                 break;
             }
-            elideLayout->setFormats(formats);
+            textElideLayout->setFormats(formats);
         }
 
-        elideLayout->setFont(layout.font());
-        elideLayout->setTextOption(layout.textOption());
-        elideLayout->setText(elideText);
-        elideLayout->beginLayout();
+        textElideLayout->setFont(textLayout.font());
+        textElideLayout->setTextOption(textLayout.textOption());
+        textElideLayout->setText(elideText);
+        textElideLayout->beginLayout();
 
-        QTextLine elidedLine = elideLayout->createLine();
+        QTextLine elidedLine = textElideLayout->createLine();
         elidedLine.setPosition(QPointF(0, height));
         if (customLayout) {
             setupCustomLineGeometry(elidedLine, height, elideText.size(), visibleCount - 1);
         } else {
             setLineGeometry(elidedLine, lineWidth, height);
         }
-        elideLayout->endLayout();
+        textElideLayout->endLayout();
 
         br = br.united(elidedLine.naturalTextRect());
 
         if (visibleCount == 1)
-            layout.clearLayout();
+            textLayout.clearLayout();
     } else {
-        delete elideLayout;
-        elideLayout = nullptr;
+        delete textElideLayout;
+        textElideLayout = nullptr;
     }
 
-    QTextLine firstLine = visibleCount == 1 && elideLayout
-            ? elideLayout->lineAt(0)
-            : layout.lineAt(0);
+    QTextLine firstLine = visibleCount == 1 && textElideLayout
+            ? textElideLayout->lineAt(0)
+            : textLayout.lineAt(0);
     if (firstLine.isValid())
         *baseline = firstLine.y() + firstLine.ascent();
 
@@ -1885,7 +2041,6 @@ void QQuickText::setFont(const QFont &font)
 void QQuickText::itemChange(ItemChange change, const ItemChangeData &value)
 {
     Q_D(QQuickText);
-    Q_UNUSED(value);
     switch (change) {
     case ItemAntialiasingHasChanged:
         if (!antialiasing())
@@ -1897,6 +2052,15 @@ void QQuickText::itemChange(ItemChange change, const ItemChangeData &value)
         d->updateLayout();
         break;
 
+    case ItemSceneChange:
+        // A shared layout must only be painted on the render thread of the window it has been
+        // shared in.
+        if (d->sharedLayout && value.window) {
+            d->sharedLayout.reset();
+            d->updateLayout();
+        }
+        break;
+
     case ItemDevicePixelRatioHasChanged:
         if (d->renderType == NativeRendering) {
             // Native rendering optimizes for a given pixel grid, so its results must not be scaled.
@@ -2738,14 +2902,15 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         else
             node->setViewport(QRectF{});
         const qreal dx = QQuickTextUtil::alignedX(d->lineWidth, d->availableWidth(), effectiveHAlign()) + leftPadding();
+        QTextLayout *elideLayout = d->paintedElideLayout();
         int unelidedLineCount = d->lineCount;
-        if (d->elideLayout)
+        if (elideLayout)
             unelidedLineCount -= 1;
         if (unelidedLineCount > 0)
-            node->addTextLayout(QPointF(dx, dy), &d->layout, -1, -1,0, unelidedLineCount);
+            node->addTextLayout(QPointF(dx, dy), d->paintedLayout(), -1, -1,0, unelidedLineCount);
 
-        if (d->elideLayout)
-            node->addTextLayout(QPointF(dx, dy), d->elideLayout);
+        if (elideLayout)
+            node->addTextLayout(QPointF(dx, dy), elideLayout);
 
         if (d->extra.isAllocated()) {
             for (QQuickStyledTextImgTag *img : std::as_const(d->extra->visibleImgTags)) {
@@ -3371,8 +3536,9 @@ void QQuickText::invalidateFontCaches()
                 block.layout()->engine()->resetFontEngineCache();
         }
     } else {
-        if (d->layout.engine() != nullptr)
-            d->layout.engine()->resetFontEngineCache();
+        QTextLayout *layout = d->paintedLayout();
+        if (layout->engine() != nullptr)
+            layout->engine()->resetFontEngineCache();
     }
 }
 
@@ -24,6 +24,7 @@
 #include <private/qquickstyledtext_p.h>
 #include <private/qlazilyallocated_p.h>
 #include <private/qquicktextdocument_p.h>
+#include <private/qquicktextlayoutcache_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -48,8 +49,10 @@ public:
     void setLineGeometry(QTextLine &line, qreal lineWidth, qreal &height);
 
     int lineHeightOffset() const;
-    QString elidedText(qreal lineWidth, const QTextLine &line, const QTextLine *nextLine = nullptr) const;
-    void elideFormats(int start, int length, int offset, QVector<QTextLayout::FormatRange> *elidedFormats);
+    QString elidedText(const QTextLayout &textLayout, qreal lineWidth, const QTextLine &line,
+                       const QTextLine *nextLine = nullptr) const;
+    void elideFormats(const QTextLayout &textLayout, int start, int length, int offset,
+                      QVector<QTextLayout::FormatRange> *elidedFormats);
     void clearFormats();
 
     void processHoverEvent(QHoverEvent *event);
@@ -98,6 +101,8 @@ public:
     QTextLayout layout;
     QTextLayout *elideLayout;
     QQuickTextLine *textLine;
+    // Used instead of layout and elideLayout if set, see setupTextLayout()
+    QSharedPointer<QQuickTextLayoutCache::Entry> sharedLayout;
 
     qreal lineWidth;
 
@@ -165,6 +170,14 @@ public:
     void updateDocumentText();
 
     QRectF setupTextLayout(qreal * const baseline);
+    QRectF setupTextLayout(QTextLayout &textLayout, QTextLayout *&textElideLayout, qreal * const baseline);
+    bool isLayoutCacheable();
+    QQuickTextLayoutCache::Key layoutCacheKey(bool implicitWidthKnown, bool implicitHeightKnown) const;
+    bool useSharedLayout(const QSharedPointer<QQuickTextLayoutCache::Entry> &entry,
+                         const QQuickTextLayoutCache::Key &key, qreal * const baseline);
+    void updateFontInfo(const QFont &layoutFont);
+    QTextLayout *paintedLayout() { return sharedLayout ? &sharedLayout->layout : &layout; }
+    QTextLayout *paintedElideLayout() { return sharedLayout ? sharedLayout->elideLayout : elideLayout; }
     void setupCustomLineGeometry(QTextLine &line, qreal &height, int fullLayoutTextLength, int lineOffset = 0);
     bool isLinkActivatedConnected();
     bool isLinkHoveredConnected();
@@ -0,0 +1,95 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qquicktextlayoutcache_p.h"
+
+#include <QtCore/qloggingcategory.h>
+#include <QtQuick/private/qquickwindow_p.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcTextLayoutCache, "qt.quick.text.layoutcache")
+
+/*!
+    \internal
+    \class QQuickTextLayoutCache
+
+    Delegates of views and tables often show the same short strings, like units, status labels
+    or column headers, in the same font and size. Instead of shaping the text and breaking it
+    into lines in each QQuickText, the items look up the layout in this cache, and only lay out
+    the text themselves if no other item has done so with the same parameters before. The
+    QQuickText then paints the shared layout, so the scene graph reuses the shaped glyphs as
+    well.
+
+    A QTextLayout caches the font engines of the thread that last used it, so a layout must not
+    be painted on two render threads at the same time. There is therefore one cache per window.
+    The GUI thread only lays out the entries before they are inserted, and the render thread of
+    the window only paints them while the GUI thread is blocked. An item that moves to another
+    window lays out its text again.
+
+    The cache is disabled by default. It holds the most recently used layouts, up to the number
+    of entries given by the \c QT_QUICK_TEXT_LAYOUT_CACHE_SIZE environment variable. Entries
+    that are evicted stay alive as long as items refer to them.
+*/
+
+Q_CONSTINIT static QBasicAtomicInt maximumCacheSize = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+QQuickTextLayoutCache::QQuickTextLayoutCache(int maximumSize)
+    : m_entries(maximumSize)
+{
+}
+
+QQuickTextLayoutCache *QQuickTextLayoutCache::forWindow(QQuickWindow *window)
+{
+    if (!window)
+        return nullptr;
+
+    QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(window);
+    if (!windowPrivate->textLayoutCache) {
+        const int size = maximumSize();
+        if (size == 0)
+            return nullptr;
+        windowPrivate->textLayoutCache.reset(new QQuickTextLayoutCache(size));
+    }
+    return windowPrivate->textLayoutCache.data();
+}
+
+int QQuickTextLayoutCache::maximumSize()
+{
+    int size = maximumCacheSize.loadRelaxed();
+    if (size < 0) {
+        size = qMax(0, qEnvironmentVariableIntValue("QT_QUICK_TEXT_LAYOUT_CACHE_SIZE"));
+        maximumCacheSize.storeRelaxed(size);
+    }
+    return size;
+}
+
+/*!
+    Sets the maximum number of entries of the caches that are created from now on. 0 disables
+    the cache for the windows that don't have one yet.
+*/
+void QQuickTextLayoutCache::setMaximumSize(int size)
+{
+    maximumCacheSize.storeRelaxed(qMax(0, size));
+}
+
+QSharedPointer<QQuickTextLayoutCache::Entry> QQuickTextLayoutCache::find(const Key &key)
+{
+    if (QSharedPointer<Entry> *entry = m_entries.object(key))
+        return *entry;
+    return {};
+}
+
+void QQuickTextLayoutCache::insert(const Key &key, const QSharedPointer<Entry> &entry)
+{
+    m_entries.insert(key, new QSharedPointer<Entry>(entry));
+    qCDebug(lcTextLayoutCache) << "Cached the layout of" << key.text << "," << m_entries.size()
+                               << "layouts in the cache";
+}
+
+void QQuickTextLayoutCache::clear()
+{
+    m_entries.clear();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKTEXTLAYOUTCACHE_P_H
+#define QQUICKTEXTLAYOUTCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+
+#include <QtCore/qcache.h>
+#include <QtCore/qmargins.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtGui/qfont.h>
+#include <QtGui/qtextlayout.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickWindow;
+
+// Shares the layouts of plain Text items that show the same string in the same font and
+// geometry, so that the text is shaped and broken into lines only once. There is one cache per
+// QQuickWindow, as the layouts are painted on the render thread of the window.
+class Q_QUICK_PRIVATE_EXPORT QQuickTextLayoutCache
+{
+public:
+    // Everything the layout of a plain text depends on
+    struct Key
+    {
+        QString text;
+        QFont font;
+        qreal width = 0;
+        qreal height = 0;
+        QMarginsF padding;
+        qreal lineHeight = 1.0;
+        int maximumLineCount = INT_MAX;
+        quint32 options = 0; // alignment, wrap and elide modes, validity of the size, ...
+
+        friend bool operator==(const Key &a, const Key &b) noexcept
+        {
+            return a.options == b.options && a.width == b.width && a.height == b.height
+                    && a.lineHeight == b.lineHeight && a.maximumLineCount == b.maximumLineCount
+                    && a.padding == b.padding && a.text == b.text && a.font == b.font;
+        }
+        friend bool operator!=(const Key &a, const Key &b) noexcept { return !(a == b); }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.text, key.font, key.width, key.height, key.options);
+        }
+    };
+
+    // The laid out text, and what QQuickTextPrivate::setupTextLayout() computed along with it
+    struct Entry
+    {
+        Entry() = default;
+        ~Entry() { delete elideLayout; }
+        Q_DISABLE_COPY_MOVE(Entry)
+
+        QTextLayout layout;
+        QTextLayout *elideLayout = nullptr;
+        QRectF boundingRect;
+        QSizeF advance;
+        QSizeF implicitSize;
+        qreal baseline = 0;
+        qreal lineWidth = 0;
+        int lineCount = 0;
+        bool truncated = false;
+        bool widthExceeded = false;
+        bool heightExceeded = false;
+    };
+
+    // Longer texts are unlikely to be repeated, and are laid out by each item
+    enum { MaximumTextLength = 256 };
+
+    explicit QQuickTextLayoutCache(int maximumSize);
+    Q_DISABLE_COPY_MOVE(QQuickTextLayoutCache)
+
+    // Returns nullptr if there is no window or the cache is disabled
+    static QQuickTextLayoutCache *forWindow(QQuickWindow *window);
+
+    static int maximumSize();
+    static void setMaximumSize(int size);
+
+    QSharedPointer<Entry> find(const Key &key);
+    void insert(const Key &key, const QSharedPointer<Entry> &entry);
+    void clear();
+
+    qsizetype size() const { return m_entries.size(); }
+
+private:
+    QCache<Key, QSharedPointer<Entry>> m_entries;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKTEXTLAYOUTCACHE_P_H
@@ -10,6 +10,7 @@
 #include "qquickgraphicsdevice_p.h"
 #include "qquickwindowcontainer_p.h"
 
+#include <QtQuick/private/qsgnode_p.h>
 #include <QtQuick/private/qsgrenderer_p.h>
 #include <QtQuick/private/qsgplaintexture_p.h>
 #include <QtQuick/private/qquickpointerhandler_p.h>
@@ -20,6 +21,7 @@
 #include <private/qquickanimatorcontroller_p.h>
 #include <private/qquickprofiler_p.h>
 #include <private/qquicktextinterface_p.h>
+#include <private/qquicktextlayoutcache_p.h>
 
 #include <private/qguiapplication_p.h>
 
@@ -30,13 +32,20 @@
 #include <QtGui/qmatrix4x4.h>
 #include <QtGui/private/qevent_p.h>
 #include <QtGui/private/qpointingdevice_p.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRunnable>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qset.h>
+#include <QtCore/qthreadpool.h>
 #include <QtQml/qqmlincubator.h>
 #include <QtQml/qqmlinfo.h>
+#include <QtQml/private/qqmlbindingbatch_p.h>
 #include <QtQml/private/qqmlmetatype_p.h>
+#include <QtQml/private/qv4engine_p.h>
+#include <QtQml/private/qv4mm_p.h>
 
 #include <QtQuick/private/qquickpixmap_p.h>
 
@@ -54,6 +63,7 @@
 
 #include <rhi/qrhi.h>
 
+#include <algorithm>
 #include <utility>
 #include <mutex>
 
@@ -109,17 +119,43 @@ protected:
         }
     }
 
+    // Spend the remainder of the incubation time on an ongoing incremental garbage collection.
+    void collectGarbage(const QElapsedTimer &timer, int budget)
+    {
+        QQmlEngine *qmlEngine = engine();
+        if (!qmlEngine)
+            return;
+        QV4::MemoryManager *mm = qmlEngine->handle()->memoryManager;
+        if (!mm->isGCInProgress())
+            return;
+        const qint64 remaining = qint64(budget) * 1000 - timer.nsecsElapsed() / 1000;
+        if (remaining > 0)
+            mm->runGCSlice(std::chrono::microseconds(remaining));
+    }
+
 public slots:
     void incubate() {
-        if (m_renderLoop && incubatingObjectCount()) {
+        if (!m_renderLoop)
+            return;
+        QElapsedTimer timer;
+        timer.start();
+        int budget = m_incubation_time;
+        if (m_renderLoop->interleaveIncubation()) {
+            // Use whatever is left of the current frame, if the render loop can tell.
+            const int remaining = m_renderLoop->remainingFrameTime();
+            if (remaining > 0)
+                budget = remaining;
+        }
+        if (incubatingObjectCount()) {
             if (m_renderLoop->interleaveIncubation()) {
-                incubateFor(m_incubation_time);
+                incubateFor(budget);
             } else {
                 incubateFor(m_incubation_time * 2);
                 if (incubatingObjectCount())
                     incubateAgain();
             }
         }
+        collectGarbage(timer, budget);
     }
 
     void animationStopped() { incubate(); }
@@ -359,6 +395,10 @@ void QQuickWindowPrivate::polishItems()
     // or indirectly, we use a PolishLoopDetector to determine if a warning should
     // be printed to the user.
 
+    // Bring deferred bindings up to date first. They may change the geometry
+    // of items and schedule more of them for polishing.
+    QQmlBindingBatch::flushAll();
+
     PolishLoopDetector polishLoopDetector(itemsToPolish);
     while (!itemsToPolish.isEmpty()) {
         QQuickItem *item = itemsToPolish.takeLast();
@@ -1954,6 +1994,8 @@ void QQuickWindowPrivate::updateDirtyNodes()
     dirtyItemList = nullptr;
     if (updateList) QQuickItemPrivate::get(updateList)->prevDirtyItem = &updateList;
 
+    deferThreadSafePaintNodes = syncThreadCount() > 1;
+
     while (updateList) {
         QQuickItem *item = updateList;
         QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
@@ -1962,6 +2004,50 @@ void QQuickWindowPrivate::updateDirtyNodes()
         qCDebug(lcDirty) << "   QSGNode:" << item << qPrintable(itemPriv->dirtyToString());
         updateDirtyNode(item);
     }
+
+    deferThreadSafePaintNodes = false;
+    if (!threadSafePaintNodeItems.isEmpty())
+        updateThreadSafePaintNodes();
+}
+
+#if QT_CONFIG(thread)
+namespace {
+class SyncThreadPool : public QThreadPool
+{
+public:
+    SyncThreadPool() { setObjectName(QStringLiteral("QQuickWindow sync")); }
+};
+}
+
+Q_GLOBAL_STATIC(SyncThreadPool, syncThreadPool)
+#endif
+
+static int initialSyncThreadCount()
+{
+#if QT_CONFIG(thread)
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QSG_SYNC_THREADS", &ok);
+    if (ok)
+        return count > 0 ? count : QThread::idealThreadCount();
+#endif
+    return 1;
+}
+
+Q_CONSTINIT static QBasicAtomicInt syncThreads = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+int QQuickWindowPrivate::syncThreadCount()
+{
+    int count = syncThreads.loadRelaxed();
+    if (count < 0) {
+        count = initialSyncThreadCount();
+        syncThreads.storeRelaxed(count);
+    }
+    return count;
+}
+
+void QQuickWindowPrivate::setSyncThreadCount(int count)
+{
+    syncThreads.storeRelaxed(qMax(1, count));
 }
 
 static inline QSGNode *qquickitem_before_paintNode(QQuickItemPrivate *d)
@@ -1979,6 +2065,23 @@ static inline QSGNode *qquickitem_before_paintNode(QQuickItemPrivate *d)
     return Q_UNLIKELY(before) ? QQuickItemPrivate::get(before)->itemNode() : nullptr;
 }
 
+static void qquickitem_insert_paintNode(QQuickItemPrivate *d)
+{
+    Q_ASSERT(d->paintNode == nullptr ||
+             d->paintNode->parent() == nullptr ||
+             d->paintNode->parent() == d->childContainerNode());
+
+    if (d->paintNode && d->paintNode->parent() == nullptr) {
+        QSGNode *before = qquickitem_before_paintNode(d);
+        if (before && before->parent()) {
+            Q_ASSERT(before->parent() == d->childContainerNode());
+            d->childContainerNode()->insertChildNodeAfter(d->paintNode, before);
+        } else {
+            d->childContainerNode()->prependChildNode(d->paintNode);
+        }
+    }
+}
+
 static QSGNode *fetchNextNode(QQuickItemPrivate *itemPriv, int &ii, bool &returnedPaintNode)
 {
     QList<QQuickItem *> orderedChildren = itemPriv->paintOrderChildItems();
@@ -2218,20 +2321,12 @@ void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
 
         if (itemPriv->flags & QQuickItem::ItemHasContents) {
             updatePaintNodeData.transformNode = itemPriv->itemNode();
-            itemPriv->paintNode = item->updatePaintNode(itemPriv->paintNode, &updatePaintNodeData);
-
-            Q_ASSERT(itemPriv->paintNode == nullptr ||
-                     itemPriv->paintNode->parent() == nullptr ||
-                     itemPriv->paintNode->parent() == itemPriv->childContainerNode());
-
-            if (itemPriv->paintNode && itemPriv->paintNode->parent() == nullptr) {
-                QSGNode *before = qquickitem_before_paintNode(itemPriv);
-                if (before && before->parent()) {
-                    Q_ASSERT(before->parent() == itemPriv->childContainerNode());
-                    itemPriv->childContainerNode()->insertChildNodeAfter(itemPriv->paintNode, before);
-                } else {
-                    itemPriv->childContainerNode()->prependChildNode(itemPriv->paintNode);
-                }
+            if (deferThreadSafePaintNodes
+                    && (itemPriv->flags & QQuickItem::ItemHasThreadSafeUpdatePaintNode)) {
+                threadSafePaintNodeItems.append(item);
+            } else {
+                itemPriv->paintNode = item->updatePaintNode(itemPriv->paintNode, &updatePaintNodeData);
+                qquickitem_insert_paintNode(itemPriv);
             }
         } else if (itemPriv->paintNode) {
             delete itemPriv->paintNode;
@@ -2262,6 +2357,123 @@ void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
 
 }
 
+/*
+    Calls updatePaintNode() of the items collected by updateDirtyNode() on several threads, and
+    then inserts the new paint nodes in the order in which the items were collected. The items
+    are divided between the threads by subtree, using the ancestors at the shallowest depth that
+    yields enough subtrees to balance the work. The items in a subtree are usually updated
+    together, so this keeps the nodes touched by one thread close to each other. Changes of the
+    nodes shared by several subtrees are serialized by QSGNode::markDirty().
+*/
+void QQuickWindowPrivate::updateThreadSafePaintNodes()
+{
+    // Not worth waking up the threads for a handful of items
+    constexpr qsizetype MinimumItemsPerThread = 32;
+    constexpr int MaximumSubtreeDepth = 8;
+
+#if QT_CONFIG(thread)
+    const int threadCount = int(qMin<qsizetype>(syncThreadCount(),
+                                                threadSafePaintNodeItems.size() / MinimumItemsPerThread));
+#else
+    const int threadCount = 1;
+#endif
+    if (threadCount < 2) {
+        for (QQuickItem *item : std::as_const(threadSafePaintNodeItems)) {
+            QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
+            updatePaintNodeData.transformNode = itemPriv->itemNode();
+            itemPriv->paintNode = item->updatePaintNode(itemPriv->paintNode, &updatePaintNodeData);
+            qquickitem_insert_paintNode(itemPriv);
+        }
+        threadSafePaintNodeItems.clear();
+        return;
+    }
+
+#if QT_CONFIG(thread)
+    const qsizetype itemCount = threadSafePaintNodeItems.size();
+
+    // ancestors[i * MaximumSubtreeDepth + d] is the ancestor of item i at depth d below the
+    // content item, or the item itself if it is not nested that deep.
+    QVarLengthArray<QQuickItem *, 1024> ancestors(itemCount * MaximumSubtreeDepth);
+    QVarLengthArray<QQuickItem *, 32> path;
+    for (qsizetype i = 0; i < itemCount; ++i) {
+        QQuickItem *item = threadSafePaintNodeItems.at(i);
+        path.clear();
+        for (QQuickItem *p = item; p && p != contentItem; p = p->parentItem())
+            path.append(p);
+        for (int d = 0; d < MaximumSubtreeDepth; ++d)
+            ancestors[i * MaximumSubtreeDepth + d] = d < path.size() ? path[path.size() - 1 - d] : item;
+    }
+
+    const qsizetype wantedSubtrees = qsizetype(threadCount) * 4;
+    int depth = 0;
+    for (; depth < MaximumSubtreeDepth - 1; ++depth) {
+        QSet<QQuickItem *> subtrees;
+        for (qsizetype i = 0; i < itemCount && subtrees.size() < wantedSubtrees; ++i)
+            subtrees.insert(ancestors[i * MaximumSubtreeDepth + depth]);
+        if (subtrees.size() >= wantedSubtrees)
+            break;
+    }
+
+    QHash<QQuickItem *, qsizetype> subtreeIndex;
+    QList<QList<QQuickItem *>> subtrees;
+    for (qsizetype i = 0; i < itemCount; ++i) {
+        QQuickItem *subtree = ancestors[i * MaximumSubtreeDepth + depth];
+        auto it = subtreeIndex.find(subtree);
+        if (it == subtreeIndex.end()) {
+            it = subtreeIndex.insert(subtree, subtrees.size());
+            subtrees.emplaceBack();
+        }
+        subtrees[*it].append(threadSafePaintNodeItems.at(i));
+    }
+
+    // Largest subtrees first, each to the thread with the fewest items so far
+    std::sort(subtrees.begin(), subtrees.end(), [](const auto &a, const auto &b) {
+        return a.size() > b.size();
+    });
+    QVarLengthArray<QList<QQuickItem *>, 16> partitions(threadCount);
+    for (const QList<QQuickItem *> &subtree : std::as_const(subtrees)) {
+        auto partition = std::min_element(partitions.begin(), partitions.end(), [](const auto &a, const auto &b) {
+            return a.size() < b.size();
+        });
+        partition->append(subtree);
+    }
+
+    QMutex nodeChangeMutex;
+    auto updatePartition = [&partitions, &nodeChangeMutex](int index) {
+        QSGNodePrivate::setChangeMutex(&nodeChangeMutex);
+        QQuickItem::UpdatePaintNodeData data;
+        for (QQuickItem *item : std::as_const(partitions[index])) {
+            QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
+            data.transformNode = itemPriv->itemNodeInstance;
+            itemPriv->paintNode = item->updatePaintNode(itemPriv->paintNode, &data);
+        }
+        QSGNodePrivate::setChangeMutex(nullptr);
+    };
+
+    QSemaphore finished;
+    QThreadPool *pool = syncThreadPool();
+    if (pool->maxThreadCount() < threadCount - 1)
+        pool->setMaxThreadCount(threadCount - 1);
+    for (int index = 1; index < threadCount; ++index) {
+        pool->start([&updatePartition, &finished, index]() {
+            updatePartition(index);
+            finished.release();
+        });
+    }
+
+    // The render thread updates the first partition itself.
+    updatePartition(0);
+    finished.acquire(threadCount - 1);
+
+    for (QQuickItem *item : std::as_const(threadSafePaintNodeItems))
+        qquickitem_insert_paintNode(QQuickItemPrivate::get(item));
+
+    qCDebug(lcDirty) << "Updated" << itemCount << "paint nodes of" << subtrees.size()
+                     << "subtrees on" << threadCount << "threads";
+    threadSafePaintNodeItems.clear();
+#endif
+}
+
 bool QQuickWindowPrivate::emitError(QQuickWindow::SceneGraphError error, const QString &msg)
 {
     Q_Q(QQuickWindow);
@@ -2661,6 +2873,11 @@ QImage QQuickWindow::grabWindow()
     for this window. QQuickView automatically installs this controller for you,
     otherwise you will need to install it yourself using \l{QQmlEngine::setIncubationController()}.
 
+    While animations are running with the threaded render loop, the controller
+    incubates objects for the time left in the current frame after the window
+    has been synchronized with the render thread. Otherwise it incubates for a
+    fixed share of the frame time.
+
     The controller is owned by the window and will be destroyed when the window
     is deleted.
 */
@@ -46,6 +46,7 @@ class QQuickDragGrabber;
 class QQuickItemPrivate;
 class QPointingDevice;
 class QQuickRenderControl;
+class QQuickTextLayoutCache;
 class QQuickWindowIncubationController;
 class QQuickWindowPrivate;
 class QSGRenderLoop;
@@ -164,6 +165,9 @@ public:
     QQuickItem::UpdatePaintNodeData updatePaintNodeData;
 
     QQuickItem *dirtyItemList;
+    // Items with ItemHasThreadSafeUpdatePaintNode, see updateThreadSafePaintNodes()
+    QList<QQuickItem *> threadSafePaintNodeItems;
+    bool deferThreadSafePaintNodes = false;
     QList<QSGNode *> cleanupNodeList;
 
     QVector<QQuickItem *> itemsToPolish;
@@ -177,6 +181,10 @@ public:
     bool updateEffectiveOpacity(QQuickItem *);
     void updateEffectiveOpacityRoot(QQuickItem *, qreal);
     void updateDirtyNode(QQuickItem *);
+    void updateThreadSafePaintNodes();
+
+    static int syncThreadCount();
+    static void setSyncThreadCount(int count);
 
     void fireFrameSwapped() { Q_EMIT q_func()->frameSwapped(); }
     void fireAboutToStop() { Q_EMIT q_func()->sceneGraphAboutToStop(); }
@@ -192,6 +200,8 @@ public:
     QSGRenderLoop *windowManager;
     QQuickRenderControl *renderControl;
     QScopedPointer<QQuickAnimatorController> animationController;
+    // Created by QQuickTextLayoutCache::forWindow()
+    QScopedPointer<QQuickTextLayoutCache> textLayoutCache;
 
     QColor clearColor;
 
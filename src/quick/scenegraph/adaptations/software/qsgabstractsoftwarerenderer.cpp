@@ -9,9 +9,17 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/qmath.h>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
+#include <vector>
+
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
@@ -24,10 +32,16 @@ QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *conte
     // Setup special background node
     auto backgroundRenderable = new QSGSoftwareRenderableNode(QSGSoftwareRenderableNode::SimpleRect, m_background);
     addNodeMapping(m_background, backgroundRenderable);
+
+    // Budget in megabytes
+    m_rasterCache.setMaxCost(
+            qsizetype(qMax(0, qEnvironmentVariableIntValue("QSG_SOFTWARE_RASTER_CACHE"))) * 1024 * 1024);
 }
 
 QSGAbstractSoftwareRenderer::~QSGAbstractSoftwareRenderer()
 {
+    m_rasterCache.clear();
+
     // Cleanup RenderableNodes
     delete m_background;
 
@@ -93,6 +107,12 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     if (m_renderableNodes.isEmpty())
         return dirtyRegion;
 
+    if (m_rasterCache.maxCost() > 0)
+        updateRasterCache(painter->device()->devicePixelRatio());
+
+    if (renderNodesConcurrently(painter, &dirtyRegion))
+        return dirtyRegion;
+
     auto iterator = m_renderableNodes.begin();
     // First node is the background and needs to painted without blending
     auto backgroundNode = *iterator;
@@ -107,6 +127,208 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+QSGAbstractSoftwareRenderer::RasterCacheEntry::~RasterCacheEntry()
+{
+    node->releaseRasterCache();
+}
+
+/*
+    Decides which of the nodes to be painted are blitted from their rasterized content. The
+    content of static nodes, like text, is rasterized the second time they are painted, and
+    then reused for as long as the node moves by whole pixels only. The least recently painted
+    nodes are evicted when the cache exceeds its budget. Nodes are removed from the cache when
+    their geometry or material changes.
+*/
+void QSGAbstractSoftwareRenderer::updateRasterCache(qreal devicePixelRatio)
+{
+    int created = 0;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (!node->needsPainting())
+            continue;
+
+        // Looking the node up makes it the most recently used one
+        if (m_rasterCache.object(node) && node->reuseRasterCache(devicePixelRatio))
+            continue;
+
+        m_rasterCache.remove(node);
+        if (!node->isRasterCacheable(devicePixelRatio))
+            continue;
+
+        node->createRasterCache(devicePixelRatio);
+        // Deletes the entry, releasing the image again, if it exceeds the budget on its own
+        m_rasterCache.insert(node, new RasterCacheEntry{ node }, node->rasterCacheCost());
+        ++created;
+    }
+
+    if (created) {
+        qCDebug(lc2DRender) << "Rasterized" << created << "nodes, raster cache uses"
+                            << m_rasterCache.totalCost() << "bytes";
+    }
+}
+
+#if QT_CONFIG(thread)
+namespace {
+class RenderThreadPool : public QThreadPool
+{
+public:
+    RenderThreadPool() { setObjectName(QStringLiteral("QSGAbstractSoftwareRenderer")); }
+};
+}
+
+Q_GLOBAL_STATIC(RenderThreadPool, renderThreadPool)
+#endif
+
+static int initialRenderThreadCount()
+{
+#if QT_CONFIG(thread)
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS", &ok);
+    if (ok)
+        return count > 0 ? count : QThread::idealThreadCount();
+#endif
+    return 1;
+}
+
+Q_CONSTINIT static QBasicAtomicInt renderThreads = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+int QSGAbstractSoftwareRenderer::renderThreadCount()
+{
+    int count = renderThreads.loadRelaxed();
+    if (count < 0) {
+        count = initialRenderThreadCount();
+        renderThreads.storeRelaxed(count);
+    }
+    return count;
+}
+
+void QSGAbstractSoftwareRenderer::setRenderThreadCount(int count)
+{
+    renderThreads.storeRelaxed(qMax(1, count));
+}
+
+/*
+    Splits the area to be painted into bands of scanlines and paints them on a thread pool, each
+    band with its own QPainter over the part of the image it covers. Each band paints all the nodes
+    intersecting it, in the order of the render list and with the same opacity and clipping, so
+    the result matches painting the whole area with \a painter. Returns \c false, without
+    painting anything, if the area is too small or the nodes cannot be painted this way.
+*/
+bool QSGAbstractSoftwareRenderer::renderNodesConcurrently(QPainter *painter, QRegion *dirtyRegion)
+{
+#if QT_CONFIG(thread)
+    const int threadCount = renderThreadCount();
+    if (threadCount < 2)
+        return false;
+
+    // Only images can be shared between painters, and the bands are positioned with the world
+    // transform.
+    QPaintDevice *device = painter->device();
+    if (device->devType() != QInternal::Image || painter->viewTransformEnabled()
+            || !painter->transform().isIdentity()) {
+        return false;
+    }
+
+    QImage *image = static_cast<QImage *>(device);
+    const qreal devicePixelRatio = image->devicePixelRatio();
+
+    struct Job
+    {
+        QSGSoftwareRenderableNode *node;
+        QRect bounds;
+    };
+    std::vector<Job> jobs;
+    jobs.reserve(m_renderableNodes.size());
+
+    QRect paintedRect;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (!node->prepareConcurrentPainting(devicePixelRatio))
+            return false;
+        if (!node->needsPainting())
+            continue;
+        const QRect bounds = node->dirtyRegion().boundingRect();
+        jobs.push_back({ node, bounds });
+        paintedRect |= bounds;
+    }
+
+    // Bands of fewer scanlines are not worth the synchronization
+    constexpr int MinimumBandHeight = 64;
+    const QRect deviceRect = QRect(qFloor(paintedRect.left() * devicePixelRatio),
+                                   qFloor(paintedRect.top() * devicePixelRatio),
+                                   qCeil(paintedRect.width() * devicePixelRatio),
+                                   qCeil(paintedRect.height() * devicePixelRatio))
+                                     .intersected(image->rect());
+    const int bandCount = qMin(threadCount, deviceRect.height() / MinimumBandHeight);
+    if (bandCount < 2)
+        return false;
+
+    // Don't detach the image from the worker threads
+    uchar *bits = image->bits();
+    const qsizetype bytesPerLine = image->bytesPerLine();
+    const QPainter::RenderHints renderHints = painter->renderHints();
+    QSGSoftwareRenderableNode *background = m_renderableNodes.first();
+
+    // The glyph caches of the font engines are not thread-safe.
+    QMutex glyphMutex;
+
+    const auto paintBand = [&](int band) {
+        const int top = deviceRect.top() + deviceRect.height() * band / bandCount;
+        const int bottom = deviceRect.top() + deviceRect.height() * (band + 1) / bandCount;
+        QImage bandImage(bits + top * bytesPerLine, image->width(), bottom - top, bytesPerLine,
+                         image->format());
+        bandImage.setDevicePixelRatio(devicePixelRatio);
+        if (image->format() == QImage::Format_Indexed8)
+            bandImage.setColorTable(image->colorTable());
+
+        const QRectF bandRect(0, top / devicePixelRatio,
+                              image->width() / devicePixelRatio,
+                              (bottom - top) / devicePixelRatio);
+
+        QPainter bandPainter(&bandImage);
+        bandPainter.setRenderHints(renderHints);
+        bandPainter.translate(0, -bandRect.top());
+
+        for (const Job &job : jobs) {
+            if (!bandRect.intersects(job.bounds))
+                continue;
+            // The background needs to be painted without blending
+            const bool forceOpaquePainting = job.node == background;
+            if (job.node->type() == QSGSoftwareRenderableNode::Glyph
+                    && !job.node->hasRasterCache()) {
+                QMutexLocker locker(&glyphMutex);
+                job.node->paint(&bandPainter, forceOpaquePainting);
+            } else {
+                job.node->paint(&bandPainter, forceOpaquePainting);
+            }
+        }
+    };
+
+    QSemaphore finished;
+    QThreadPool *pool = renderThreadPool();
+    if (pool->maxThreadCount() < threadCount - 1)
+        pool->setMaxThreadCount(threadCount - 1);
+    for (int band = 1; band < bandCount; ++band) {
+        pool->start([&paintBand, &finished, band]() {
+            paintBand(band);
+            finished.release();
+        });
+    }
+
+    // The render thread paints the first band itself.
+    paintBand(0);
+    finished.acquire(bandCount - 1);
+
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes))
+        *dirtyRegion += node->finishPainting();
+
+    qCDebug(lc2DRender) << "Painted" << jobs.size() << "nodes in" << bandCount << "bands";
+    return true;
+#else
+    Q_UNUSED(painter);
+    Q_UNUSED(dirtyRegion);
+    return false;
+#endif
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -248,6 +470,7 @@ void QSGAbstractSoftwareRenderer::nodeRemoved(QSGNode *node)
             dirtyRegion = renderable->boundingRectMax();
         m_dirtyRegion += dirtyRegion;
         m_nodes.remove(node);
+        m_rasterCache.remove(renderable);
         delete renderable;
     }
 
@@ -266,6 +489,7 @@ void QSGAbstractSoftwareRenderer::nodeGeometryUpdated(QSGNode *node)
     // Mark node as dirty
     auto renderable = renderableNode(node);
     if (renderable != nullptr) {
+        m_rasterCache.remove(renderable);
         renderable->markGeometryDirty();
     } else {
         m_nodeUpdater->updateNodes(node);
@@ -279,6 +503,7 @@ void QSGAbstractSoftwareRenderer::nodeMaterialUpdated(QSGNode *node)
     // Mark node as dirty
     auto renderable = renderableNode(node);
     if (renderable != nullptr) {
+        m_rasterCache.remove(renderable);
         renderable->markMaterialDirty();
     } else {
         m_nodeUpdater->updateNodes(node);
@@ -17,6 +17,7 @@
 
 #include <private/qsgrenderer_p.h>
 
+#include <QtCore/QCache>
 #include <QtCore/QHash>
 
 QT_BEGIN_NAMESPACE
@@ -40,6 +41,11 @@ public:
 
     void markDirty();
 
+    // Number of threads painting the nodes, including the render thread. Initialized from the
+    // QSG_SOFTWARE_RENDER_THREADS environment variable. 1 paints serially.
+    static int renderThreadCount();
+    static void setRenderThreadCount(int count);
+
 protected:
     QRegion renderNodes(QPainter *painter);
     void buildRenderList();
@@ -54,6 +60,9 @@ protected:
     const QVector<QSGSoftwareRenderableNode*> &renderableNodes() const;
 
 private:
+    bool renderNodesConcurrently(QPainter *painter, QRegion *dirtyRegion);
+    void updateRasterCache(qreal devicePixelRatio);
+
     void nodeAdded(QSGNode *node);
     void nodeRemoved(QSGNode *node);
     void nodeGeometryUpdated(QSGNode *node);
@@ -72,6 +81,16 @@ private:
     bool m_isOpaque = false;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
+
+    // Releases the rasterized content of the node when evicted from m_rasterCache
+    struct RasterCacheEntry
+    {
+        QSGSoftwareRenderableNode *node;
+        ~RasterCacheEntry();
+    };
+    // Nodes with rasterized content, the cost being the size of the images in bytes. Disabled
+    // unless the QSG_SOFTWARE_RASTER_CACHE environment variable sets a budget.
+    QCache<QSGSoftwareRenderableNode *, RasterCacheEntry> m_rasterCache;
 };
 
 QT_END_NAMESPACE
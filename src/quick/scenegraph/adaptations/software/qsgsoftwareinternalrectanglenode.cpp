@@ -238,14 +238,20 @@ void QSGSoftwareInternalRectangleNode::update()
     }
 }
 
+void QSGSoftwareInternalRectangleNode::setDevicePixelRatio(qreal ratio)
+{
+    if (qFuzzyCompare(ratio, m_devicePixelRatio))
+        return;
+
+    m_devicePixelRatio = ratio;
+    generateCornerPixmap();
+}
+
 void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (!qFuzzyCompare(painter->device()->devicePixelRatio(), m_devicePixelRatio)) {
-        m_devicePixelRatio = painter->device()->devicePixelRatio();
-        generateCornerPixmap();
-    }
+    setDevicePixelRatio(painter->device()->devicePixelRatio());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -310,6 +316,17 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 
 }
 
+bool QSGSoftwareInternalRectangleNode::isPlainFill() const
+{
+    return m_radius == 0
+            && m_penWidth == 0
+            && m_topLeftRadius <= 0
+            && m_topRightRadius <= 0
+            && m_bottomLeftRadius <= 0
+            && m_bottomRightRadius <= 0
+            && m_stops.isEmpty();
+}
+
 bool QSGSoftwareInternalRectangleNode::isOpaque() const
 {
     if (m_radius > 0.0f)
@@ -45,8 +45,12 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    // paint() calls this, too. Call it in advance to paint from several threads.
+    void setDevicePixelRatio(qreal ratio);
 
     bool isOpaque() const;
+    // A single fill, which is cheap to paint
+    bool isPlainFill() const;
     QRectF rect() const;
 private:
     void paintRectangle(QPainter *painter, const QRect &rect);
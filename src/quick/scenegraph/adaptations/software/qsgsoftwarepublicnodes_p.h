@@ -72,6 +72,8 @@ public:
     bool ownsTexture() const override { return m_owns; }
 
     void paint(QPainter *painter);
+    // paint() calls this, too. Call it in advance to paint from several threads.
+    void updateCachedPixmap();
 
 private:
     void updateCachedMirroredPixmap();
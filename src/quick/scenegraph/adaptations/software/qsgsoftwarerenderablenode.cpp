@@ -46,6 +46,7 @@ QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(NodeType type, QSGNode *nod
     , m_isDirty(true)
     , m_hasClipRegion(false)
     , m_opacity(1.0f)
+    , m_contentPainted(false)
 {
     switch (m_nodeType) {
     case QSGSoftwareRenderableNode::SimpleRect:
@@ -172,6 +173,7 @@ void QSGSoftwareRenderableNode::update()
     if (m_transform.isRotating())
         m_isOpaque = false;
 
+    m_boundingRect = boundingRect;
     const QRectF transformedRect = m_transform.mapRect(boundingRect);
     m_boundingRectMin = toRectMin(transformedRect);
     m_boundingRectMax = toRectMax(transformedRect);
@@ -213,11 +215,9 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
 
     // Check for don't paint conditions
     if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        }
+        if (needsPainting())
+            paint(painter, forceOpaquePainting);
+        return finishPainting();
     } else {
         if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
             m_isDirty = false;
@@ -249,6 +249,44 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
             return br;
         }
     }
+}
+
+bool QSGSoftwareRenderableNode::needsPainting() const
+{
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+/*
+    Prepares the node for painting with paint() from several threads at the same time, into
+    separate tiles of the same paint device. Returns \c false if the node cannot be painted
+    that way. Must be called from the thread the node is rendered in.
+*/
+bool QSGSoftwareRenderableNode::prepareConcurrentPainting(qreal devicePixelRatio)
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::RenderNode:
+        // Renders with the active painter of the render context
+        return !m_isDirty || qFuzzyIsNull(m_opacity);
+    case QSGSoftwareRenderableNode::Rectangle:
+        if (needsPainting())
+            m_handle.rectangleNode->setDevicePixelRatio(devicePixelRatio);
+        return true;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        if (needsPainting())
+            static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->updateCachedPixmap();
+        return true;
+    default:
+        return true;
+    }
+}
+
+/*
+    Paints the node with \a painter, without changing its dirty state. The world transform of
+    \a painter is applied on top of the node's transform.
+*/
+void QSGSoftwareRenderableNode::paint(QPainter *painter, bool forceOpaquePainting)
+{
+    Q_ASSERT(m_nodeType != RenderNode);
 
     painter->save();
     painter->setOpacity(m_opacity);
@@ -259,10 +297,21 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
-    painter->setTransform(m_transform, false); //precalculated worldTransform
-    if (forceOpaquePainting || m_isOpaque)
-        painter->setCompositionMode(QPainter::CompositionMode_Source);
+    if (!m_rasterCache.isNull()) {
+        // Blended, as the cache is transparent around the content
+        painter->drawImage(m_rasterCachePosition, m_rasterCache);
+    } else {
+        painter->setTransform(m_transform * painter->transform(), false); //precalculated worldTransform
+        if (forceOpaquePainting || m_isOpaque)
+            painter->setCompositionMode(QPainter::CompositionMode_Source);
+        paintContent(painter);
+    }
+
+    painter->restore();
+}
 
+void QSGSoftwareRenderableNode::paintContent(QPainter *painter)
+{
     switch (m_nodeType) {
     case QSGSoftwareRenderableNode::SimpleRect:
         painter->fillRect(m_handle.simpleRectNode->rect(), m_handle.simpleRectNode->color());
@@ -308,17 +357,120 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     default:
         break;
     }
+}
 
-    painter->restore();
+/*
+    Clears the dirty state of the node after it has been painted, and returns the area to be
+    flushed.
+*/
+QRegion QSGSoftwareRenderableNode::finishPainting()
+{
+    if (!needsPainting()) {
+        m_isDirty = false;
+        m_dirtyRegion = QRegion();
+        return QRegion();
+    }
 
     QRegion areaToBeFlushed = m_dirtyRegion;
     m_previousDirtyRegion = QRegion(m_boundingRectMax);
     m_isDirty = false;
     m_dirtyRegion = QRegion();
 
+    m_contentPainted = true;
+    m_rasterCacheTransform = rasterCacheTransform(rasterCacheRect());
+
     return areaToBeFlushed;
 }
 
+// Caching larger nodes would evict everything else
+static constexpr qsizetype MaximumRasterCachePixels = 512 * 512;
+
+/*
+    Returns whether the content of the node is worth rasterizing into an image once and blitting
+    that from then on. This is the case for nodes that are expensive to paint and have been
+    painted before with the same content and at the same fractional position, so that nodes
+    which change every frame aren't painted twice. Only translations and scaling can be cached
+    without loss of quality.
+*/
+bool QSGSoftwareRenderableNode::isRasterCacheable(qreal devicePixelRatio) const
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        if (m_handle.rectangleNode->isPlainFill())
+            return false;
+        break;
+    case QSGSoftwareRenderableNode::Glyph:
+    case QSGSoftwareRenderableNode::NinePatch:
+        break;
+    default:
+        return false;
+    }
+
+    // The cache is blitted at integer logical coordinates, which only map to whole device
+    // pixels for integer device pixel ratios.
+    if (!m_contentPainted || m_transform.type() > QTransform::TxScale
+            || devicePixelRatio != qFloor(devicePixelRatio)) {
+        return false;
+    }
+
+    const QRect rect = rasterCacheRect();
+    return !rect.isEmpty()
+            && qsizetype(rect.width()) * rect.height() * devicePixelRatio * devicePixelRatio
+                    <= MaximumRasterCachePixels
+            && rasterCacheTransform(rect) == m_rasterCacheTransform;
+}
+
+// The area covered by the node, unclipped, in world coordinates
+QRect QSGSoftwareRenderableNode::rasterCacheRect() const
+{
+    return m_transform.mapRect(m_boundingRect).toAlignedRect();
+}
+
+// The transform of the node relative to the top left corner of \a rect
+QTransform QSGSoftwareRenderableNode::rasterCacheTransform(const QRect &rect) const
+{
+    return m_transform * QTransform::fromTranslate(-rect.x(), -rect.y());
+}
+
+/*
+    Returns whether the existing cache can still be used for painting the node, and moves it
+    to the current position of the node. The content does not need to be rasterized again when
+    the node has been moved by whole pixels, which is what happens when scrolling.
+*/
+bool QSGSoftwareRenderableNode::reuseRasterCache(qreal devicePixelRatio)
+{
+    if (m_rasterCache.isNull() || m_rasterCache.devicePixelRatio() != devicePixelRatio)
+        return false;
+
+    const QRect rect = rasterCacheRect();
+    if (rasterCacheTransform(rect) != m_rasterCacheTransform)
+        return false;
+
+    m_rasterCachePosition = rect.topLeft();
+    return true;
+}
+
+void QSGSoftwareRenderableNode::createRasterCache(qreal devicePixelRatio)
+{
+    const QRect rect = rasterCacheRect();
+    m_rasterCachePosition = rect.topLeft();
+    m_rasterCacheTransform = rasterCacheTransform(rect);
+
+    m_rasterCache = QImage(rect.size() * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    m_rasterCache.setDevicePixelRatio(devicePixelRatio);
+    m_rasterCache.fill(Qt::transparent);
+
+    QPainter painter(&m_rasterCache);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setTransform(m_rasterCacheTransform);
+    paintContent(&painter);
+}
+
+void QSGSoftwareRenderableNode::releaseRasterCache()
+{
+    m_rasterCache = QImage();
+}
+
 bool QSGSoftwareRenderableNode::isDirtyRegionEmpty() const
 {
     return m_dirtyRegion.isEmpty();
@@ -353,11 +505,15 @@ void QSGSoftwareRenderableNode::setOpacity(float opacity)
 
 void QSGSoftwareRenderableNode::markGeometryDirty()
 {
+    m_contentPainted = false;
+    releaseRasterCache();
     update();
 }
 
 void QSGSoftwareRenderableNode::markMaterialDirty()
 {
+    m_contentPainted = false;
+    releaseRasterCache();
     update();
 }
 
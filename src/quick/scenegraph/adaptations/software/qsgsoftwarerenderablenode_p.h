@@ -17,6 +17,7 @@
 
 #include <QtQuick/private/qtquickglobal_p.h>
 
+#include <QtGui/QImage>
 #include <QtGui/QRegion>
 #include <QtCore/QRect>
 #include <QtGui/QTransform>
@@ -62,6 +63,22 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+
+    // renderNode() split up, for painting a node into several tiles concurrently
+    bool prepareConcurrentPainting(qreal devicePixelRatio);
+    bool needsPainting() const;
+    void paint(QPainter *painter, bool forceOpaquePainting = false);
+    QRegion finishPainting();
+
+    // Content rasterized in advance, and blitted by paint(). Managed by
+    // QSGAbstractSoftwareRenderer, which bounds the memory used by all nodes.
+    bool isRasterCacheable(qreal devicePixelRatio) const;
+    bool reuseRasterCache(qreal devicePixelRatio);
+    void createRasterCache(qreal devicePixelRatio);
+    void releaseRasterCache();
+    bool hasRasterCache() const { return !m_rasterCache.isNull(); }
+    qsizetype rasterCacheCost() const { return m_rasterCache.sizeInBytes(); }
+
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -87,6 +104,10 @@ public:
     QRegion dirtyRegion() const;
 
 private:
+    void paintContent(QPainter *painter);
+    QRect rasterCacheRect() const;
+    QTransform rasterCacheTransform(const QRect &rect) const;
+
     union RenderableNodeHandle {
         QSGNode *node;
         QSGSimpleRectNode *simpleRectNode;
@@ -116,8 +137,14 @@ private:
     bool m_hasClipRegion;
     float m_opacity;
 
+    QRectF m_boundingRect;
     QRect m_boundingRectMin;
     QRect m_boundingRectMax;
+
+    QImage m_rasterCache;
+    QTransform m_rasterCacheTransform; // m_transform relative to the cache, when last painted
+    QPoint m_rasterCachePosition;
+    bool m_contentPainted; // painted since the content last changed
 };
 
 QT_END_NAMESPACE
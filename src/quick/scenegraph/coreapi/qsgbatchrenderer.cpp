@@ -8,7 +8,11 @@
 #include <qmath.h>
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QtNumeric>
+#include <QtCore/private/qsimd_p.h>
 
 #include <QtGui/QGuiApplication>
 
@@ -851,6 +855,7 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     , m_currentShader(nullptr)
     , m_vertexUploadPool(256)
     , m_indexUploadPool(64)
+    , m_mergedElementUploads(64)
 {
     m_rhi = m_context->rhi();
     Q_ASSERT(m_rhi); // no more direct OpenGL code path in Qt 6
@@ -876,6 +881,11 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
         QObject::connect(ctx, SIGNAL(invalidated()), m_shaderManager, SLOT(invalidated()), Qt::DirectConnection);
     }
 
+    // 0 uses as many threads as there are cores
+    m_uploadThreadCount = qt_sg_envInt("QSG_RENDERER_UPLOAD_THREADS", 1);
+    if (m_uploadThreadCount <= 0)
+        m_uploadThreadCount = QThread::idealThreadCount();
+
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
     m_srbPoolThreshold = qt_sg_envInt("QSG_RENDERER_SRB_POOL_THRESHOLD", 1024);
@@ -1892,23 +1902,176 @@ static inline float calculateElementZOrder(const Element *e, qreal zRange)
     return std::clamp(1.0f - float(e->order * zRange), VIEWPORT_MIN_DEPTH, VIEWPORT_MAX_DEPTH);
 }
 
-/* These parameters warrant some explanation...
+/*
+    The kernels below write the vertices and indices of merged batches. They handle several
+    vertices or indices per iteration with SSE2 or NEON, which are part of the baseline of the
+    respective architectures, and fall back to plain loops for the rest.
+*/
+
+#if defined(__SSE2__)
+// Maps the positions in xs and ys in the same order of operations as Pt::map()
+static inline __m128 qsg_mapPositions(__m128 xs, __m128 ys, __m128 mx, __m128 my, __m128 t)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, mx), _mm_mul_ps(ys, my)), t);
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+static inline float32x4_t qsg_mapPositions(float32x4_t xs, float32x4_t ys, float32x4_t mx,
+                                           float32x4_t my, float32x4_t t)
+{
+    return vaddq_f32(vaddq_f32(vmulq_f32(xs, mx), vmulq_f32(ys, my)), t);
+}
+#endif
+
+void qsg_translateVertices(char *vertices, int count, int stride, float dx, float dy)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    if (stride == 2 * sizeof(float)) {
+        // Two vertices per vector
+        const __m128 t = _mm_setr_ps(dx, dy, dx, dy);
+        for (; i + 2 <= count; i += 2, vertices += 2 * stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            _mm_storeu_ps(p, _mm_add_ps(_mm_loadu_ps(p), t));
+        }
+    } else if (stride == 4 * sizeof(float)) {
+        // One vertex per vector, keeping the other attributes. The last vertex is done below,
+        // as the vector could extend past the end of the vertex data.
+        const __m128 t = _mm_setr_ps(dx, dy, 0, 0);
+        for (; i + 1 < count; ++i, vertices += stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            const __m128 v = _mm_loadu_ps(p);
+            _mm_storeu_ps(p, _mm_shuffle_ps(_mm_add_ps(v, t), v, _MM_SHUFFLE(3, 2, 1, 0)));
+        }
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    if (stride == 2 * sizeof(float)) {
+        const float tv[] = { dx, dy, dx, dy };
+        const float32x4_t t = vld1q_f32(tv);
+        for (; i + 2 <= count; i += 2, vertices += 2 * stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            vst1q_f32(p, vaddq_f32(vld1q_f32(p), t));
+        }
+    } else if (stride == 4 * sizeof(float)) {
+        const float tv[] = { dx, dy };
+        const float32x2_t t = vld1_f32(tv);
+        for (; i < count; ++i, vertices += stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            vst1_f32(p, vadd_f32(vld1_f32(p), t));
+        }
+    }
+#endif
+    for (; i < count; ++i, vertices += stride) {
+        Pt *p = reinterpret_cast<Pt *>(vertices);
+        p->x += dx;
+        p->y += dy;
+    }
+}
+
+void qsg_transformVertices(char *vertices, int count, int stride, const QMatrix4x4 &matrix)
+{
+    int i = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float *m = matrix.constData();
+#endif
+#if defined(__SSE2__)
+    if (stride == 2 * sizeof(float)) {
+        const __m128 mx = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+        const __m128 my = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+        const __m128 t = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+        for (; i + 2 <= count; i += 2, vertices += 2 * stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            const __m128 v = _mm_loadu_ps(p);
+            const __m128 xs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+            const __m128 ys = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+            _mm_storeu_ps(p, qsg_mapPositions(xs, ys, mx, my, t));
+        }
+    } else if (stride == 4 * sizeof(float)) {
+        const __m128 mx = _mm_setr_ps(m[0], m[1], 0, 0);
+        const __m128 my = _mm_setr_ps(m[4], m[5], 0, 0);
+        const __m128 t = _mm_setr_ps(m[12], m[13], 0, 0);
+        for (; i + 1 < count; ++i, vertices += stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            const __m128 v = _mm_loadu_ps(p);
+            const __m128 xs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 ys = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 r = qsg_mapPositions(xs, ys, mx, my, t);
+            _mm_storeu_ps(p, _mm_shuffle_ps(r, v, _MM_SHUFFLE(3, 2, 1, 0)));
+        }
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    if (stride == 2 * sizeof(float)) {
+        const float mv[] = { m[0], m[1], m[0], m[1], m[4], m[5], m[4], m[5],
+                             m[12], m[13], m[12], m[13] };
+        const float32x4_t mx = vld1q_f32(mv);
+        const float32x4_t my = vld1q_f32(mv + 4);
+        const float32x4_t t = vld1q_f32(mv + 8);
+        for (; i + 2 <= count; i += 2, vertices += 2 * stride) {
+            float *p = reinterpret_cast<float *>(vertices);
+            const float32x4_t v = vld1q_f32(p);
+            const float32x4x2_t xys = vtrnq_f32(v, v);
+            vst1q_f32(p, qsg_mapPositions(xys.val[0], xys.val[1], mx, my, t));
+        }
+    }
+#endif
+    for (; i < count; ++i, vertices += stride)
+        reinterpret_cast<Pt *>(vertices)->map(matrix);
+}
+
+void qsg_offsetIndices(quint16 *dst, const quint16 *src, int count, quint16 offset)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i o = _mm_set1_epi16(short(offset));
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_add_epi16(v, o));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint16x8_t o = vdupq_n_u16(offset);
+    for (; i + 8 <= count; i += 8)
+        vst1q_u16(dst + i, vaddq_u16(vld1q_u16(src + i), o));
+#endif
+    for (; i < count; ++i)
+        dst[i] = offset + src[i];
+}
+
+void qsg_offsetIndices(quint32 *dst, const quint16 *src, int count, quint32 offset)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i o = _mm_set1_epi32(int(offset));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                         _mm_add_epi32(_mm_unpacklo_epi16(v, zero), o));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4),
+                         _mm_add_epi32(_mm_unpackhi_epi16(v, zero), o));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint32x4_t o = vdupq_n_u32(offset);
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t v = vld1q_u16(src + i);
+        vst1q_u32(dst + i, vaddq_u32(vmovl_u16(vget_low_u16(v)), o));
+        vst1q_u32(dst + i + 4, vaddq_u32(vmovl_u16(vget_high_u16(v)), o));
+    }
+#endif
+    for (; i < count; ++i)
+        dst[i] = offset + src[i];
+}
+
+/* Writes the element's vertices, with the transform relative to the batch root applied, its
+ * z positions and its indices to the locations laid out by uploadBatch(). Elements don't
+ * share any of the memory they write to, so they can be uploaded from several threads.
  *
  * vaOffset: The byte offset into the vertex data to the location of the
  *           2D float point vertex attributes.
- *
- * vertexData: destination where the geometry's vertex data should go
- *
- * zData: destination of geometries injected Z positioning
- *
- * indexData: destination of the indices for this element
- *
- * iBase: The starting index for this element in the batch
  */
 
-void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount)
+void Renderer::uploadMergedElement(const MergedElementUpload &upload, int vaOffset)
 {
-    if (Q_UNLIKELY(debug_upload())) qDebug() << "  - uploading element:" << e << e->node << (void *) *vertexData << (qintptr) (*zData - *vertexData) << (qintptr) (*indexData - *vertexData);
+    Element *e = upload.element;
+    if (Q_UNLIKELY(debug_upload())) qDebug() << "  - uploading element:" << e << e->node << (void *) upload.vertexData << (qintptr) (upload.zData - upload.vertexData) << (qintptr) (upload.indexData - upload.vertexData);
     QSGGeometry *g = e->node->geometry();
 
     const QMatrix4x4 &localx = *e->node->matrix();
@@ -1916,95 +2079,137 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
 
     const int vCount = g->vertexCount();
     const int vSize = g->sizeOfVertex();
-    memcpy(*vertexData, g->vertexData(), vSize * vCount);
+    memcpy(upload.vertexData, g->vertexData(), vSize * vCount);
 
     // apply vertex transform..
-    char *vdata = *vertexData + vaOffset;
-    if (localx.flags() == QMatrix4x4::Translation) {
-        for (int i=0; i<vCount; ++i) {
-            Pt *p = (Pt *) vdata;
-            p->x += localxdata[12];
-            p->y += localxdata[13];
-            vdata += vSize;
-        }
-    } else if (localx.flags() > QMatrix4x4::Translation) {
-        for (int i=0; i<vCount; ++i) {
-            ((Pt *) vdata)->map(localx);
-            vdata += vSize;
-        }
-    }
+    char *vdata = upload.vertexData + vaOffset;
+    if (localx.flags() == QMatrix4x4::Translation)
+        qsg_translateVertices(vdata, vCount, vSize, localxdata[12], localxdata[13]);
+    else if (localx.flags() > QMatrix4x4::Translation)
+        qsg_transformVertices(vdata, vCount, vSize, localx);
 
     if (useDepthBuffer()) {
-        float *vzorder = (float *) *zData;
+        float *vzorder = (float *) upload.zData;
         float zorder = calculateElementZOrder(e, m_zRange);
         for (int i=0; i<vCount; ++i)
             vzorder[i] = zorder;
-        *zData += vCount * sizeof(float);
     }
 
     int iCount = g->indexCount();
     if (m_uint32IndexForRhi) {
         // can only happen when using the rhi
-        quint32 *iBase = (quint32 *) iBasePtr;
-        quint32 *indices = (quint32 *) *indexData;
+        const quint32 iBase = upload.indexBase;
+        quint32 *indices = (quint32 *) upload.indexData;
         if (iCount == 0) {
             iCount = vCount;
             if (g->drawingMode() == QSGGeometry::DrawTriangleStrip)
-                *indices++ = *iBase;
+                *indices++ = iBase;
             else
                 iCount = qsg_fixIndexCount(iCount, g->drawingMode());
 
             for (int i=0; i<iCount; ++i)
-                indices[i] = *iBase + i;
+                indices[i] = iBase + i;
         } else {
             // source index data in QSGGeometry is always ushort (we would not merge otherwise)
             const quint16 *srcIndices = g->indexDataAsUShort();
             if (g->drawingMode() == QSGGeometry::DrawTriangleStrip)
-                *indices++ = *iBase + srcIndices[0];
+                *indices++ = iBase + srcIndices[0];
             else
                 iCount = qsg_fixIndexCount(iCount, g->drawingMode());
 
-            for (int i=0; i<iCount; ++i)
-                indices[i] = *iBase + srcIndices[i];
+            qsg_offsetIndices(indices, srcIndices, iCount, iBase);
         }
-        if (g->drawingMode() == QSGGeometry::DrawTriangleStrip) {
+        if (g->drawingMode() == QSGGeometry::DrawTriangleStrip)
             indices[iCount] = indices[iCount - 1];
-            iCount += 2;
-        }
-        *iBase += vCount;
     } else {
         // normally batching is only done for ushort index data
-        quint16 *iBase = (quint16 *) iBasePtr;
-        quint16 *indices = (quint16 *) *indexData;
+        const quint16 iBase = quint16(upload.indexBase);
+        quint16 *indices = (quint16 *) upload.indexData;
         if (iCount == 0) {
             iCount = vCount;
             if (g->drawingMode() == QSGGeometry::DrawTriangleStrip)
-                *indices++ = *iBase;
+                *indices++ = iBase;
             else
                 iCount = qsg_fixIndexCount(iCount, g->drawingMode());
 
             for (int i=0; i<iCount; ++i)
-                indices[i] = *iBase + i;
+                indices[i] = iBase + i;
         } else {
             const quint16 *srcIndices = g->indexDataAsUShort();
             if (g->drawingMode() == QSGGeometry::DrawTriangleStrip)
-                *indices++ = *iBase + srcIndices[0];
+                *indices++ = iBase + srcIndices[0];
             else
                 iCount = qsg_fixIndexCount(iCount, g->drawingMode());
 
-            for (int i=0; i<iCount; ++i)
-                indices[i] = *iBase + srcIndices[i];
+            qsg_offsetIndices(indices, srcIndices, iCount, iBase);
         }
-        if (g->drawingMode() == QSGGeometry::DrawTriangleStrip) {
+        if (g->drawingMode() == QSGGeometry::DrawTriangleStrip)
             indices[iCount] = indices[iCount - 1];
-            iCount += 2;
-        }
-        *iBase += vCount;
     }
+}
 
-    *vertexData += vCount * vSize;
-    *indexData += iCount * mergedIndexElemSize();
-    *indexCount += iCount;
+#if QT_CONFIG(thread)
+namespace {
+class UploadThreadPool : public QThreadPool
+{
+public:
+    UploadThreadPool() { setObjectName(QStringLiteral("QSGBatchRenderer")); }
+};
+}
+
+Q_GLOBAL_STATIC(UploadThreadPool, uploadThreadPool)
+#endif
+
+/* Uploads the elements laid out in m_mergedElementUploads. Large batches are split into
+ * ranges of elements, which are uploaded by the worker threads and the render thread at the
+ * same time.
+ */
+void Renderer::uploadMergedElements(int vaOffset, int vertexCount)
+{
+    const qsizetype elementCount = m_mergedElementUploads.size();
+    const MergedElementUpload *uploads = m_mergedElementUploads.data();
+
+    // Smaller batches are not worth the synchronization
+    constexpr int MinimumVerticesPerThread = 8192;
+    int threadCount = 1;
+#if QT_CONFIG(thread)
+    if (!debug_upload()) {
+        threadCount = qMin(m_uploadThreadCount, vertexCount / MinimumVerticesPerThread);
+        threadCount = int(qMin(qsizetype(threadCount), elementCount));
+    }
+#else
+    Q_UNUSED(vertexCount);
+#endif
+
+    if (threadCount < 2) {
+        for (qsizetype i = 0; i < elementCount; ++i)
+            uploadMergedElement(uploads[i], vaOffset);
+        return;
+    }
+
+#if QT_CONFIG(thread)
+    const auto uploadRange = [&](int range) {
+        const qsizetype begin = elementCount * range / threadCount;
+        const qsizetype end = elementCount * (range + 1) / threadCount;
+        for (qsizetype i = begin; i < end; ++i)
+            uploadMergedElement(uploads[i], vaOffset);
+    };
+
+    QSemaphore finished;
+    QThreadPool *pool = uploadThreadPool();
+    if (pool->maxThreadCount() < threadCount - 1)
+        pool->setMaxThreadCount(threadCount - 1);
+    for (int range = 1; range < threadCount; ++range) {
+        pool->start([&uploadRange, &finished, range]() {
+            uploadRange(range);
+            finished.release();
+        });
+    }
+
+    // The render thread uploads the first range itself.
+    uploadRange(0);
+    finished.acquire(threadCount - 1);
+#endif
 }
 
 QMatrix4x4 qsg_matrixForRoot(Node *node)
@@ -2111,9 +2316,11 @@ void Renderer::uploadBatch(Batch *b)
         char *vertexData = b->vbo.data;
         char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
         char *indexData = b->ibo.data;
+        const int vSize = g->sizeOfVertex();
 
-        quint16 iOffset16 = 0;
-        quint32 iOffset32 = 0;
+        // Lay out the elements first, so that they can be uploaded independently.
+        m_mergedElementUploads.reset();
+        quint32 iOffset = 0;
         e = b->first;
         uint verticesInSet = 0;
         // Start a new set already after 65534 vertices because 0xFFFF may be
@@ -2137,17 +2344,26 @@ void Renderer::uploadBatch(Batch *b)
                 b->drawSets << DrawSet(vertexData - b->vbo.data,
                                        zData - b->vbo.data,
                                        drawSetIndices);
-                iOffset16 = 0;
-                iOffset32 = 0;
+                iOffset = 0;
                 verticesInSet = e->node->geometry()->vertexCount();
                 indicesInSet = 0;
             }
-            void *iBasePtr = &iOffset16;
-            if (m_uint32IndexForRhi)
-                iBasePtr = &iOffset32;
-            uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, iBasePtr, &indicesInSet);
+            m_mergedElementUploads.add({ e, vertexData, zData, indexData, iOffset });
+
+            // Must match what uploadMergedElement() writes
+            const QSGGeometry *eg = e->node->geometry();
+            const int vCount = eg->vertexCount();
+            const int iCount = qsg_fixIndexCount(eg->indexCount() ? eg->indexCount() : vCount,
+                                                 g->drawingMode());
+            vertexData += vCount * vSize;
+            if (useDepthBuffer())
+                zData += vCount * sizeof(float);
+            indexData += iCount * mergedIndexElemSize();
+            indicesInSet += iCount;
+            iOffset += vCount;
             e = e->nextInBatch;
         }
+        uploadMergedElements(b->positionAttribute, b->vertexCount);
         b->drawSets.last().indexCount = indicesInSet;
         // We skip the very first and very last degenerate triangles since they aren't needed
         // and the first one would reverse the vertex ordering of the merged strips.
@@ -29,6 +29,8 @@
 
 #include <rhi/qrhi.h>
 
+class NodesTest;
+
 QT_BEGIN_NAMESPACE
 
 namespace QSGBatchRenderer
@@ -723,6 +725,13 @@ protected:
     QHash<Node *, uint> m_visualizeChangeSet;
 };
 
+// Used for merging the geometry of elements, exported for testing. The vertex functions map
+// the 2D float positions at the start of vertices, which are stride bytes apart.
+Q_QUICK_PRIVATE_EXPORT void qsg_translateVertices(char *vertices, int count, int stride, float dx, float dy);
+Q_QUICK_PRIVATE_EXPORT void qsg_transformVertices(char *vertices, int count, int stride, const QMatrix4x4 &matrix);
+Q_QUICK_PRIVATE_EXPORT void qsg_offsetIndices(quint16 *dst, const quint16 *src, int count, quint16 offset);
+Q_QUICK_PRIVATE_EXPORT void qsg_offsetIndices(quint32 *dst, const quint16 *src, int count, quint32 offset);
+
 class Q_QUICK_PRIVATE_EXPORT Renderer : public QSGRenderer
 {
 public:
@@ -775,6 +784,7 @@ private:
 
     friend class Updater;
     friend class RhiVisualizer;
+    friend class ::NodesTest;
 
     void destroyGraphicsResources();
     void map(Buffer *buffer, quint32 byteSize, bool isIndexBuf = false);
@@ -792,8 +802,18 @@ private:
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
 
+    // Where uploadMergedElement() writes the data of an element
+    struct MergedElementUpload {
+        Element *element;
+        char *vertexData;
+        char *zData;
+        char *indexData;
+        quint32 indexBase;
+    };
+
     void uploadBatch(Batch *b);
-    void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount);
+    void uploadMergedElement(const MergedElementUpload &upload, int vaOffset);
+    void uploadMergedElements(int vaOffset, int vertexCount);
 
     bool ensurePipelineState(Element *e, const ShaderManager::Shader *sms, bool depthPostPass = false);
     QRhiTexture *dummyTexture();
@@ -882,6 +902,8 @@ private:
 
     QDataBuffer<char> m_vertexUploadPool;
     QDataBuffer<char> m_indexUploadPool;
+    QDataBuffer<MergedElementUpload> m_mergedElementUploads;
+    int m_uploadThreadCount;
 
     Allocator<Node, 256> m_nodeAllocator;
     Allocator<Element, 64> m_elementAllocator;
@@ -9,20 +9,27 @@
 
 #include "limits.h"
 
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(lcQsgLeak)
 
 #ifndef QT_NO_DEBUG
-static int qt_node_count = 0;
+static QBasicAtomicInt qt_node_count = Q_BASIC_ATOMIC_INITIALIZER(0);
 
 static void qt_print_node_count()
 {
-    qCDebug(lcQsgLeak, "Number of leaked nodes: %i", qt_node_count);
-    qt_node_count = -1;
+    qCDebug(lcQsgLeak, "Number of leaked nodes: %i", qt_node_count.loadRelaxed());
+    qt_node_count.storeRelaxed(-1);
 }
 #endif
 
+// Set while several threads update disjoint subtrees of the same tree, see
+// QSGNodePrivate::setChangeMutex().
+Q_CONSTINIT static thread_local QMutex *qt_node_change_mutex = nullptr;
+
 /*!
     \group qtquick-scenegraph-nodes
     \title Qt Quick Scene Graph Node classes
@@ -258,7 +265,7 @@ void QSGNode::init()
 {
 #ifndef QT_NO_DEBUG
     if (lcQsgLeak().isDebugEnabled()) {
-        ++qt_node_count;
+        qt_node_count.ref();
         static bool atexit_registered = false;
         if (!atexit_registered) {
             atexit(qt_print_node_count);
@@ -283,8 +290,7 @@ QSGNode::~QSGNode()
 {
 #ifndef QT_NO_DEBUG
     if (lcQsgLeak().isDebugEnabled()) {
-        --qt_node_count;
-        if (qt_node_count < 0)
+        if (qt_node_count.fetchAndSubRelaxed(1) <= 0)
             qCDebug(lcQsgLeak, "Node destroyed after qt_print_node_count() was called.");
     }
 #endif
@@ -623,6 +629,9 @@ void QSGNode::setFlags(Flags f, bool enabled)
 
 void QSGNode::markDirty(DirtyState bits)
 {
+    // The ancestors and the renderer are shared with the other subtrees.
+    QMutexLocker locker(qt_node_change_mutex);
+
     int renderableCountDiff = 0;
     if (bits & DirtyNodeAdded)
         renderableCountDiff += m_subtreeRenderableCount;
@@ -638,6 +647,18 @@ void QSGNode::markDirty(DirtyState bits)
     }
 }
 
+/*!
+    \internal
+
+    Makes QSGNode::markDirty() lock \a mutex in the calling thread, until it is called
+    again with \c nullptr. This allows several threads to update nodes in disjoint subtrees
+    of the same tree, as long as they all use the same mutex.
+ */
+void QSGNodePrivate::setChangeMutex(QMutex *mutex)
+{
+    qt_node_change_mutex = mutex;
+}
+
 void qsgnode_set_description(QSGNode *node, const QString &description)
 {
 #ifdef QSG_RUNTIME_DESCRIPTION
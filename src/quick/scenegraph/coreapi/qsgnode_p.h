@@ -21,12 +21,16 @@
 
 QT_BEGIN_NAMESPACE
 
+class QMutex;
+
 class QSGNodePrivate
 {
 public:
     QSGNodePrivate() {}
     virtual ~QSGNodePrivate() {}
 
+    static void setChangeMutex(QMutex *mutex);
+
 #ifdef QSG_RUNTIME_DESCRIPTION
     static void setDescription(QSGNode *node, const QString &description) {
         node->d_ptr->descr= description;
@@ -73,6 +73,8 @@ public:
     static void setInstance(QSGRenderLoop *instance);
 
     virtual bool interleaveIncubation() const { return false; }
+    // Milliseconds left until the current frame is due, or -1 if unknown
+    virtual int remainingFrameTime() const { return -1; }
 
     virtual int flags() const { return 0; }
 
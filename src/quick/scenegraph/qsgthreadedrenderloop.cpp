@@ -1031,6 +1031,22 @@ bool QSGThreadedRenderLoop::interleaveIncubation() const
     return m_animation_driver->isRunning() && anyoneShowing();
 }
 
+int QSGThreadedRenderLoop::remainingFrameTime() const
+{
+    if (!m_frameTimer.isValid() || m_frameInterval <= 0)
+        return -1;
+
+    // Keep a millisecond for event processing before the next frame is due.
+    const int remaining = int(m_frameInterval - m_frameTimer.nsecsElapsed() / 1000000.0f) - 1;
+    return qMax(1, remaining);
+}
+
+void QSGThreadedRenderLoop::startFrame()
+{
+    m_frameTimer.start();
+    m_frameInterval = sg->vsyncIntervalForAnimationDriver(m_animation_driver);
+}
+
 void QSGThreadedRenderLoop::animationStarted()
 {
     qCDebug(QSG_LOG_RENDERLOOP, "- animationStarted()");
@@ -1514,6 +1530,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     }
 
     Q_TRACE_SCOPE(QSG_polishAndSync);
+    startFrame();
     QElapsedTimer timer;
     qint64 polishTime = 0;
     qint64 waitTime = 0;
@@ -1682,6 +1699,7 @@ bool QSGThreadedRenderLoop::event(QEvent *e)
         QTimerEvent *te = static_cast<QTimerEvent *>(e);
         if (te->timerId() == m_animation_timer) {
             qCDebug(QSG_LOG_RENDERLOOP, "- ticking non-render thread timer");
+            startFrame();
             m_animation_driver->advance();
             emit timeToIncubate();
             return true;
@@ -56,6 +56,7 @@ public:
     void postJob(QQuickWindow *window, QRunnable *job) override;
 
     bool interleaveIncubation() const override;
+    int remainingFrameTime() const override;
 
 public Q_SLOTS:
     void animationStarted();
@@ -88,6 +89,7 @@ private:
     void postUpdateRequest(Window *w);
     void waitForReleaseComplete();
     void polishAndSync(Window *w, bool inExpose = false);
+    void startFrame();
     void maybeUpdate(Window *window);
 
     void handleExposure(QQuickWindow *w);
@@ -105,6 +107,10 @@ private:
 
     int m_animation_timer;
 
+    // Started when the gui thread begins preparing a frame
+    QElapsedTimer m_frameTimer;
+    float m_frameInterval = 0;
+
     bool m_lockedForSync;
     bool m_inPolish = false;
 };
@@ -13,6 +13,9 @@
 #include <qqmlcomponent.h>
 #include <stdlib.h>
 #include <private/qv4alloca_p.h>
+#include <private/qv4mm_p.h>
+#include <private/qv4lookup_p.h>
+#include <private/qv4identifiertable_p.h>
 #include <private/qjsvalue_p.h>
 #include <QScopeGuard>
 #include <QUrl>
@@ -266,6 +269,14 @@ private slots:
 
     void equality();
     void aggressiveGc();
+    void incrementalGc();
+    void incrementalGcWithGenerator();
+    void concurrentSweep();
+    void generationalGc();
+    void generationalGcWithGenerator();
+    void packedArrays();
+    void polymorphicLookups();
+    void propertyHash();
     void noAccumulatorInTemplateLiteral();
 
     void interrupt_data();
@@ -5292,6 +5303,365 @@ void tst_QJSEngine::aggressiveGc()
     qputenv("QV4_MM_AGGRESSIVE_GC", origAggressiveGc);
 }
 
+void tst_QJSEngine::incrementalGc()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+    QVERIFY(!mm->isGCInProgress());
+
+    QJSValue array = engine.evaluate(
+            "(function() { var a = []; for (var i = 0; i < 10000; ++i) a.push({ x: i }); return a; })()");
+    QVERIFY(array.isArray());
+
+    // A slice without any budget only gets through a small part of the heap.
+    QVERIFY(!mm->runGCSlice(std::chrono::microseconds(0)));
+    QVERIFY(mm->isGCInProgress());
+
+    // Create new references while marking is in progress. The write barrier and the handling of
+    // objects allocated during the mark phase have to keep them alive.
+    QJSValue mutate = engine.evaluate(
+            "(function(a) { for (var i = 0; i < 100; ++i) a[i].y = { z: 'z' + i }; "
+            "a.push({ x: 'late' }); })");
+    mutate.call({array});
+
+    while (!mm->runGCSlice(std::chrono::microseconds(0))) {}
+    QVERIFY(!mm->isGCInProgress());
+
+    // And a full collection on top of it.
+    engine.collectGarbage();
+
+    QCOMPARE(array.property("length").toInt(), 10001);
+    QCOMPARE(array.property(42).property("x").toInt(), 42);
+    QCOMPARE(array.property(42).property("y").property("z").toString(), QStringLiteral("z42"));
+    QCOMPARE(array.property(10000).property("x").toString(), QStringLiteral("late"));
+}
+
+void tst_QJSEngine::incrementalGcWithGenerator()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+
+    // Each step of the generator moves an object from one of the holders into its own frame,
+    // which is the only reference to it while the generator is suspended.
+    const int count = 2000;
+    QJSValue holders = engine.evaluate(
+            "(function(n) { var a = []; for (var i = 0; i < n; ++i) a.push({ o: { v: 'v' + i } }); "
+            "return a; })").call({count});
+    QJSValue generator = engine.evaluate(
+            "(function(holders) { function* take() { var previous = 'none'; "
+            "for (var i = 0; i < holders.length; ++i) { var o = holders[i].o; holders[i].o = null; "
+            "yield previous; previous = o.v; } return previous; } return take(); })")
+            .call({holders});
+    QVERIFY(generator.isObject());
+    QJSValue next = generator.property("next");
+
+    // Resume the generator in between the slices of ongoing collection cycles.
+    for (int i = 0; i < count; ++i) {
+        mm->runGCSlice(std::chrono::microseconds(0));
+        const QJSValue result = next.callWithInstance(generator);
+        QCOMPARE(result.property("value").toString(),
+                 i ? QStringLiteral("v%1").arg(i - 1) : QStringLiteral("none"));
+        engine.evaluate("for (var i = 0; i < 100; ++i) ({ garbage: 'g' + i });");
+    }
+
+    while (!mm->runGCSlice(std::chrono::microseconds(0))) {}
+    const QJSValue result = next.callWithInstance(generator);
+    QVERIFY(result.property("done").toBool());
+    QCOMPARE(result.property("value").toString(), QStringLiteral("v%1").arg(count - 1));
+}
+
+void tst_QJSEngine::concurrentSweep()
+{
+    const QByteArray origConcurrentSweep = qgetenv("QV4_MM_CONCURRENT_SWEEP");
+    qputenv("QV4_MM_CONCURRENT_SWEEP", "1");
+    const auto guard = qScopeGuard([&]() {
+        qputenv("QV4_MM_CONCURRENT_SWEEP", origConcurrentSweep);
+    });
+
+    QJSEngine engine;
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+
+    QJSValue fill = engine.evaluate(
+            "(function(n) { var a = []; for (var i = 0; i < n; ++i) a.push({ x: i, s: 'str' + i }); "
+            "return a; })");
+    QJSValue keep = fill.call({20000});
+    for (int i = 0; i < 5; ++i)
+        fill.call({20000}); // garbage
+    engine.collectGarbage();
+    QVERIFY(mm->blockAllocator.isBackgroundSweepPending());
+
+    // Allocate on top of the chunks that are being swept.
+    QJSValue more = fill.call({20000});
+    engine.collectGarbage();
+    engine.collectGarbage();
+
+    QCOMPARE(keep.property("length").toInt(), 20000);
+    QCOMPARE(keep.property(12345).property("s").toString(), QStringLiteral("str12345"));
+    QCOMPARE(more.property(19999).property("x").toInt(), 19999);
+}
+
+void tst_QJSEngine::generationalGc()
+{
+    const QByteArray origGenerationalGc = qgetenv("QV4_MM_GENERATIONAL_GC");
+    qputenv("QV4_MM_GENERATIONAL_GC", "1");
+    const auto guard = qScopeGuard([&]() {
+        qputenv("QV4_MM_GENERATIONAL_GC", origGenerationalGc);
+    });
+
+    QJSEngine engine;
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+    QVERIFY(mm->isGenerationalGCEnabled());
+    QVERIFY(!mm->isIncrementalGCEnabled());
+
+    QJSValue array = engine.evaluate(
+            "(function() { var a = []; for (var i = 0; i < 10000; ++i) a.push({ x: i }); "
+            "a.m = new Map; a.s = new Set; return a; })()");
+    QVERIFY(array.isArray());
+
+    // Everything that survives a full collection is old.
+    engine.collectGarbage();
+
+    // Store young objects into old ones. Only the remembered set keeps them alive through a
+    // minor collection, as the old objects are not marked again.
+    QJSValue mutate = engine.evaluate(
+            "(function(a) { for (var i = 0; i < 100; ++i) a[i].y = { z: 'z' + i }; "
+            "a.push({ x: 'late' }); a.m.set('k', { v: 'map' }); a.s.add({ v: 'set' }); "
+            "a[1].proto = Object.create({ p: 'proto' }); "
+            "a[2].big = new Array(100000).fill('big'); "
+            "for (var i = 0; i < 10000; ++i) ({ garbage: 'g' + i }); })");
+    mutate.call({array});
+
+    const auto verify = [&]() {
+        QCOMPARE(array.property("length").toInt(), 10001);
+        QCOMPARE(array.property(42).property("x").toInt(), 42);
+        QCOMPARE(array.property(42).property("y").property("z").toString(), QStringLiteral("z42"));
+        QCOMPARE(array.property(10000).property("x").toString(), QStringLiteral("late"));
+        QCOMPARE(engine.evaluate("(function(a) { return a.m.get('k').v; })")
+                         .call({array}).toString(), QStringLiteral("map"));
+        QCOMPARE(engine.evaluate("(function(a) { return a.s.values().next().value.v; })")
+                         .call({array}).toString(), QStringLiteral("set"));
+        QCOMPARE(array.property(1).property("proto").property("p").toString(),
+                 QStringLiteral("proto"));
+        QCOMPARE(array.property(2).property("big").property(99999).toString(),
+                 QStringLiteral("big"));
+    };
+
+    mm->runMinorGC();
+    verify();
+
+    // Young objects referenced from objects promoted by the previous minor collection.
+    engine.evaluate("(function(a) { a[42].y.w = { z: 'w' }; })").call({array});
+    mm->runMinorGC();
+    QCOMPARE(array.property(42).property("y").property("w").property("z").toString(),
+             QStringLiteral("w"));
+
+    engine.collectGarbage();
+    verify();
+}
+
+void tst_QJSEngine::generationalGcWithGenerator()
+{
+    const QByteArray origGenerationalGc = qgetenv("QV4_MM_GENERATIONAL_GC");
+    qputenv("QV4_MM_GENERATIONAL_GC", "1");
+    const auto guard = qScopeGuard([&]() {
+        qputenv("QV4_MM_GENERATIONAL_GC", origGenerationalGc);
+    });
+
+    QJSEngine engine;
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+    QVERIFY(mm->isGenerationalGCEnabled());
+
+    // Each step of the generator creates a young object that is only referenced by the
+    // generator's frame while it is suspended.
+    QJSValue generator = engine.evaluate(
+            "(function*() { var previous = 'none'; "
+            "for (var i = 0; ; ++i) { var o = { v: 'v' + i }; yield previous; previous = o.v; } })()");
+    QVERIFY(generator.isObject());
+    QJSValue next = generator.property("next");
+    QCOMPARE(next.callWithInstance(generator).property("value").toString(), QStringLiteral("none"));
+
+    // The generator and its frame are old from now on.
+    engine.collectGarbage();
+
+    for (int i = 0; i < 100; ++i) {
+        const QJSValue result = next.callWithInstance(generator);
+        QCOMPARE(result.property("value").toString(), QStringLiteral("v%1").arg(i));
+        mm->runMinorGC();
+        engine.evaluate("for (var i = 0; i < 100; ++i) ({ garbage: 'g' + i });");
+    }
+
+    engine.collectGarbage();
+    QCOMPARE(next.callWithInstance(generator).property("value").toString(),
+             QStringLiteral("v100"));
+}
+
+void tst_QJSEngine::packedArrays()
+{
+    QJSEngine engine;
+
+    const auto elementKind = [](const QJSValue &array) {
+        QV4::Value v = QV4::Value::fromReturnedValue(QJSValuePrivate::asReturnedValue(&array));
+        const QV4::Heap::ArrayData *d = v.as<QV4::Object>()->arrayData();
+        return QV4::Heap::ArrayData::ElementKind(d ? d->elementKind : 0);
+    };
+
+    QJSValue ints = engine.evaluate("var ints = [10, 9, 1, -1, -10]; ints");
+    QCOMPARE(elementKind(ints), QV4::Heap::ArrayData::PackedInt32);
+    QCOMPARE(engine.evaluate("ints.indexOf(1)").toInt(), 2);
+    QCOMPARE(engine.evaluate("ints.indexOf(1.0)").toInt(), 2);
+    QCOMPARE(engine.evaluate("ints.indexOf('1')").toInt(), -1);
+    QCOMPARE(engine.evaluate("ints.indexOf(NaN)").toInt(), -1);
+    QCOMPARE(engine.evaluate("ints.slice(1, 3).join()").toString(), QStringLiteral("9,1"));
+    QCOMPARE(engine.evaluate("ints.map(x => x * 2).join()").toString(),
+             QStringLiteral("20,18,2,-2,-20"));
+    QCOMPARE(engine.evaluate("ints.slice().sort().join()").toString(),
+             QStringLiteral("-1,-10,1,10,9"));
+    QCOMPARE(engine.evaluate("ints.slice().sort((a, b) => a - b).join()").toString(),
+             QStringLiteral("-10,-1,1,9,10"));
+
+    QJSValue doubles = engine.evaluate("var doubles = []; doubles.push(1, 2.5, -0); doubles");
+    QCOMPARE(elementKind(doubles), QV4::Heap::ArrayData::PackedDouble);
+    QCOMPARE(engine.evaluate("doubles.indexOf(0)").toInt(), 2);
+    QCOMPARE(engine.evaluate("doubles.indexOf(2.5)").toInt(), 1);
+
+    // Anything that is not a number, and holes, turn the array generic
+    engine.evaluate("ints.push('x')");
+    QCOMPARE(elementKind(ints), QV4::Heap::ArrayData::Generic);
+    QCOMPARE(engine.evaluate("ints.indexOf('x')").toInt(), 5);
+    engine.evaluate("delete doubles[1]");
+    QCOMPARE(elementKind(doubles), QV4::Heap::ArrayData::Generic);
+    QCOMPARE(engine.evaluate("1 in doubles").toBool(), false);
+
+    // Objects stored after the conversion still need to be marked
+    QJSValue objects = engine.evaluate(
+            "var objects = [1, 2, 3]; for (var i = 0; i < 1000; ++i) objects.push({ i: i }); objects");
+    QCOMPARE(elementKind(objects), QV4::Heap::ArrayData::Generic);
+    engine.collectGarbage();
+    QCOMPARE(engine.evaluate("objects[999].i").toInt(), 996);
+}
+
+void tst_QJSEngine::polymorphicLookups()
+{
+    QJSEngine engine;
+    QV4::ExecutionEngine *v4 = engine.handle();
+
+    // Each object literal gets its own shape. "x" is sometimes inline, sometimes on the prototype.
+    QJSValue makeShapes = engine.evaluate(R"(
+        (function(n) {
+            var result = [];
+            for (var i = 0; i < n; ++i) {
+                var o = {};
+                o["p" + i] = i;
+                if (i % 3 === 2)
+                    o = Object.create({ x: i });
+                else
+                    o.x = i;
+                result.push(o);
+            }
+            return result;
+        })
+    )");
+    QJSValue sumX = engine.evaluate(R"(
+        (function(objects) {
+            var sum = 0;
+            for (var round = 0; round < 3; ++round) {
+                for (var i = 0; i < objects.length; ++i)
+                    sum += objects[i].x;
+            }
+            return sum;
+        })
+    )");
+
+    QCOMPARE(sumX.call({makeShapes.call({6})}).toInt(), 3 * (0 + 1 + 2 + 3 + 4 + 5));
+    QVERIFY(!v4->megamorphicLookupCache);
+
+    // Too many shapes for a polymorphic lookup
+    const QJSValue manyShapes = makeShapes.call({32});
+    QCOMPARE(sumX.call({manyShapes}).toInt(), 3 * (31 * 32 / 2));
+    QVERIFY(v4->megamorphicLookupCache);
+    QCOMPARE(v4->megamorphicLookupCache->megamorphicLookups, 1u);
+    QVERIFY(v4->megamorphicLookupCache->hits > 0);
+
+    // The megamorphic cache must not hand out stale entries after a gc
+    engine.collectGarbage();
+    QCOMPARE(sumX.call({makeShapes.call({32})}).toInt(), 3 * (31 * 32 / 2));
+    QCOMPARE(sumX.call({manyShapes}).toInt(), 3 * (31 * 32 / 2));
+}
+
+void tst_QJSEngine::propertyHash()
+{
+    QJSEngine engine;
+
+    // Objects sharing a transition chain up to p49, then branching off with different names,
+    // and getters and setters in between, which take two entries each.
+    QJSValue objects = engine.evaluate(R"(
+        (function() {
+            function make(branch) {
+                var o = {};
+                for (var i = 0; i < 200; ++i) {
+                    // Each accessor has to capture its own name.
+                    let name = (i < 50 ? "p" : branch) + i;
+                    if (i % 7 === 3) {
+                        Object.defineProperty(o, name, {
+                            get: function() { return this["_" + name]; },
+                            set: function(v) { this["_" + name] = v; },
+                            configurable: true, enumerable: false
+                        });
+                        o["_" + name] = i;
+                    } else {
+                        o[name] = i;
+                    }
+                }
+                return o;
+            }
+            return [make("a"), make("b"), make("a")];
+        })()
+    )");
+    QVERIFY2(!objects.isError(), qPrintable(objects.toString()));
+
+    QJSValue check = engine.evaluate(R"(
+        (function(o, branch) {
+            for (var i = 0; i < 200; ++i) {
+                var name = (i < 50 ? "p" : branch) + i;
+                if (o[name] !== i)
+                    return name;
+                if (i % 7 === 3) {
+                    o[name] = -i;
+                    if (o["_" + name] !== -i || o[name] !== -i)
+                        return name;
+                    o[name] = i;
+                }
+            }
+            var other = branch === "a" ? "b" : "a";
+            for (var i = 50; i < 200; ++i) {
+                if ((other + i) in o)
+                    return other + i;
+            }
+            return "";
+        })
+    )");
+    QCOMPARE(check.call({objects.property(0), QStringLiteral("a")}).toString(), QString());
+    QCOMPARE(check.call({objects.property(1), QStringLiteral("b")}).toString(), QString());
+    QCOMPARE(check.call({objects.property(2), QStringLiteral("a")}).toString(), QString());
+
+    QV4::ExecutionEngine *v4 = engine.handle();
+    QJSValue first = objects.property(0);
+    QV4::Scope scope(v4);
+    QV4::ScopedObject o(scope, QJSValuePrivate::asManagedType<QV4::Object>(&first));
+    QVERIFY(o);
+    // InternalClass::find() always goes through the property hash, including for the accessors.
+    QV4::Heap::InternalClass *ic = o->internalClass();
+    for (int i = 0; i < 200; ++i) {
+        const QString name = (i < 50 ? QStringLiteral("p") : QStringLiteral("a")) + QString::number(i);
+        const QV4::InternalClassEntry entry = ic->find(v4->identifierTable->asPropertyKey(name));
+        QVERIFY2(entry.isValid(), qPrintable(name));
+        QCOMPARE(entry.attributes.isAccessor(), i % 7 == 3);
+        if (entry.attributes.isAccessor())
+            QCOMPARE(entry.setterIndex, entry.index + 1);
+    }
+    QVERIFY(!ic->find(v4->identifierTable->asPropertyKey(QStringLiteral("b100"))).isValid());
+}
+
 void tst_QJSEngine::noAccumulatorInTemplateLiteral()
 {
     // Use aggressive GC to increase our chances of triggering the problem.
@@ -10,6 +10,7 @@
 #include <QStandardPaths>
 #include <QSysInfo>
 #include <QLoggingCategory>
+#include <private/qqmlcompilationbundle_p.h>
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <private/qv4compileddata_p.h>
@@ -49,6 +50,8 @@ private slots:
 
     void qrcScriptImport();
     void fsScriptImport();
+    void compilationBundle();
+    void compilationBundleWithCorruptedUnit();
     void moduleScriptImport();
     void esModulesViaQJSEngine();
 
@@ -91,7 +94,7 @@ public:
     }
 };
 
-static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+static bool runQmlcachegen(const QStringList &arguments, QByteArray *capturedStderr = nullptr)
 {
 #if defined(QTEST_CROSS_COMPILED)
     QTest::qFail("You cannot call qmlcachegen on the target.", __FILE__, __LINE__);
@@ -102,7 +105,7 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
         proc.setProcessChannelMode(QProcess::ForwardedChannels);
     proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
                     + QLatin1String("/qmlcachegen"));
-    proc.setArguments(QStringList() << qmlFileName);
+    proc.setArguments(arguments);
     proc.start();
     if (!proc.waitForFinished())
         return false;
@@ -115,6 +118,11 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
     return proc.exitCode() == 0;
 }
 
+static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+{
+    return runQmlcachegen(QStringList() << qmlFileName, capturedStderr);
+}
+
 tst_qmlcachegen::tst_qmlcachegen()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -701,6 +709,121 @@ void tst_qmlcachegen::fsScriptImport()
     QCOMPARE(obj->property("value").toInt(), 42);
 }
 
+void tst_qmlcachegen::compilationBundle()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const auto writeTempFile = [&tempDir](const QString &fileName, const char *contents) {
+        QFile f(tempDir.path() + '/' + fileName);
+        const bool ok = f.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        Q_ASSERT(ok);
+        f.write(contents);
+        return f.fileName();
+    };
+
+    const QStringList sources = {
+        writeTempFile(
+                "test.qml",
+                "import QtQml 2.0\n"
+                "import \"test.js\" as ScriptTest\n"
+                "Helper {\n"
+                "    property int value: ScriptTest.value + helperValue\n"
+                "}\n"),
+        writeTempFile(
+                "Helper.qml",
+                "import QtQml 2.0\n"
+                "QtObject {\n"
+                "    property int helperValue: 1\n"
+                "}\n"),
+        writeTempFile("test.js", "var value = 42"),
+    };
+
+    QStringList bundleArguments = { u"--bundle"_s, u"-o"_s, tempDir.filePath(u"app.qmlbundle"_s) };
+    for (const QString &source : sources) {
+        QVERIFY(generateCache(source));
+        bundleArguments.append(source + u"c="_s + QUrl::fromLocalFile(source).toString());
+    }
+    QVERIFY(runQmlcachegen(bundleArguments));
+
+    // Only the bundle remains. Loading can only succeed if everything comes from it.
+    for (const QString &source : sources) {
+        QVERIFY(QFile::remove(source));
+        QVERIFY(QFile::remove(source + u'c'));
+    }
+
+    QString error;
+    QVERIFY2(QQmlCompilationBundle::load(tempDir.filePath(u"app.qmlbundle"_s), &error),
+             qPrintable(error));
+
+    const QUrl testUrl = QUrl::fromLocalFile(sources[0]);
+    const QList<QUrl> dependencies = QQmlCompilationBundle::dependencies(testUrl);
+    QCOMPARE(dependencies.size(), 2);
+    QVERIFY(dependencies.contains(QUrl::fromLocalFile(sources[1])));
+    QVERIFY(dependencies.contains(QUrl::fromLocalFile(sources[2])));
+    QVERIFY(QQmlCompilationBundle::containsFile(sources[1]));
+
+    QQmlEngine engine;
+    CleanlyLoadingComponent component(&engine, testUrl);
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> obj(component.create());
+    QVERIFY(!obj.isNull());
+    QCOMPARE(obj->property("value").toInt(), 43);
+}
+
+void tst_qmlcachegen::compilationBundleWithCorruptedUnit()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString source = tempDir.filePath(u"test.qml"_s);
+    {
+        QFile f(source);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("import QtQml 2.0\nQtObject { property int value: 42 }\n");
+    }
+    QVERIFY(generateCache(source));
+
+    const QString bundlePath = tempDir.filePath(u"app.qmlbundle"_s);
+    QVERIFY(runQmlcachegen({ u"--bundle"_s, u"-o"_s, bundlePath,
+                             source + u"c="_s + QUrl::fromLocalFile(source).toString() }));
+
+    QByteArray contents;
+    {
+        QFile bundleFile(bundlePath);
+        QVERIFY(bundleFile.open(QIODevice::ReadOnly));
+        contents = bundleFile.readAll();
+    }
+    QVERIFY(contents.size() > qsizetype(sizeof(QV4::CompiledData::Bundle)));
+
+    // Break the magic of the embedded unit only. The bundle itself stays intact.
+    const auto *bundle = reinterpret_cast<const QV4::CompiledData::Bundle *>(contents.constData());
+    QCOMPARE(quint32(bundle->unitTableSize), 1u);
+    const quint32 offsetToUnit = bundle->unitAt(0)->offsetToUnit;
+    QVERIFY(offsetToUnit < quint32(contents.size()));
+    contents[offsetToUnit] = 'x';
+
+    const QString corruptedPath = tempDir.filePath(u"corrupted.qmlbundle"_s);
+    {
+        QFile corrupted(corruptedPath);
+        QVERIFY(corrupted.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(corrupted.write(contents), contents.size());
+    }
+
+    QString error;
+    QVERIFY(!QQmlCompilationBundle::load(corruptedPath, &error));
+    QVERIFY2(error.contains(u"Magic bytes"_s), qPrintable(error));
+    QVERIFY(!QQmlCompilationBundle::containsFile(source));
+}
+
 void tst_qmlcachegen::moduleScriptImport()
 {
     QQmlEngine engine;
@@ -942,6 +942,13 @@ void tst_QmlCppCodegen::boundComponents()
     QObject *c2o = c1o->property("o").value<QObject *>();
     QVERIFY(c2o != nullptr);
     QCOMPARE(c2o->objectName(), u"bar12"_s);
+
+    // The ids of the enclosing components are captured, too
+    o->setProperty("foo", u"baz"_s);
+    QCOMPARE(c1o->objectName(), u"baz"_s);
+    QCOMPARE(c2o->objectName(), u"baz12"_s);
+    c1o->setProperty("i", 13);
+    QCOMPARE(c2o->objectName(), u"baz13"_s);
 }
 
 void tst_QmlCppCodegen::callContextPropertyLookupResult()
@@ -9,6 +9,7 @@
 #include <private/qv4codegen_p.h>
 #include <private/qqmlcomponent_p.h>
 #include <private/qv4executablecompilationunit_p.h>
+#include <private/qv4lookup_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <QQmlComponent>
 #include <QQmlEngine>
@@ -17,6 +18,8 @@
 #include <QCryptographicHash>
 #include <QStandardPaths>
 #include <QDirIterator>
+#include <QResource>
+#include <QScopeGuard>
 
 class tst_qmldiskcache: public QObject
 {
@@ -41,6 +44,8 @@ private slots:
     void cppRegisteredSingletonDependency();
     void cacheModuleScripts();
     void reuseStaticMappings();
+    void lazyRuntimeStringsAndLookups();
+    void useResourceUnitInPlace();
     void invalidateSaveLoadCache();
 
     void inlineComponentDoesNotCauseConstantInvalidation_data();
@@ -1061,6 +1066,152 @@ void tst_qmldiskcache::reuseStaticMappings()
     QCOMPARE(testCompiler.unitData(), data1);
 }
 
+void tst_qmldiskcache::lazyRuntimeStringsAndLookups()
+{
+    QQmlEngine engine;
+
+    TestCompiler testCompiler(&engine);
+    QVERIFY(testCompiler.tempDir.isValid());
+
+    const QByteArray contents = QByteArrayLiteral(
+            "import QtQml\n"
+            "QtObject {\n"
+            "    function lookUp(o) { return o.lazilyResolvedName; }\n"
+            "}\n");
+    QVERIFY2(testCompiler.compile(contents), qPrintable(testCompiler.lastErrorString));
+
+    QQmlRefPointer<QV4::ExecutableCompilationUnit> unit
+            = QV4::ExecutableCompilationUnit::create();
+    QVERIFY2(unit->loadFromDisk(QUrl::fromLocalFile(testCompiler.testFilePath),
+                                QFileInfo(testCompiler.testFilePath).lastModified(),
+                                &testCompiler.lastErrorString),
+             qPrintable(testCompiler.lastErrorString));
+    unit->linkToEngine(engine.handle());
+
+    const QV4::CompiledData::Unit *data = unit->unitData();
+    QVERIFY(data->lookupTableSize > 0);
+    QVERIFY(!unit->runtimeLookups);
+
+    const uint nameIndex = data->lookupTable()[0].nameIndex();
+    QCOMPARE(unit->stringAt(nameIndex), QStringLiteral("lazilyResolvedName"));
+    QVERIFY(!unit->runtimeStrings[nameIndex]);
+
+    QV4::Heap::String *name = unit->runtimeString(nameIndex);
+    QVERIFY(name);
+    QCOMPARE(name->toQString(), QStringLiteral("lazilyResolvedName"));
+    QCOMPARE(unit->runtimeStrings[nameIndex], name);
+    QCOMPARE(unit->runtimeString(nameIndex), name);
+
+    QV4::Lookup *lookup = unit->runtimeLookup(0);
+    QVERIFY(unit->runtimeLookups);
+    QCOMPARE(lookup, unit->runtimeLookups);
+    QCOMPARE(lookup->nameIndex, nameIndex);
+    QCOMPARE(unit->runtimeLookup(0), lookup);
+}
+
+// Builds a binary resource that holds one uncompressed file right below the resource root it is
+// registered under. Unlike rcc, this places the contents on an 8 byte boundary, so that
+// compilation units can be used from it in place.
+static std::vector<quint64> singleFileResource(
+        const QString &fileName, const QByteArray &contents, const QDateTime &lastModified)
+{
+    QByteArray rcc;
+    const auto write = [&rcc](quint64 value, int size) {
+        for (int shift = (size - 1) * 8; shift >= 0; shift -= 8)
+            rcc.append(char(value >> shift));
+    };
+
+    const int headerSize = 20;
+    const int dataOffset = 28; // The size comes first, the contents then start at 32.
+    const int treeOffset = dataOffset + 4 + ((contents.size() + 3) & ~3);
+    const int nodeSize = 22;
+    const int namesOffset = treeOffset + 2 * nodeSize;
+
+    rcc.append("qres");
+    write(2, 4); // format version
+    write(treeOffset, 4);
+    write(dataOffset, 4);
+    write(namesOffset, 4);
+    rcc.append(dataOffset - headerSize, '\0');
+
+    write(contents.size(), 4);
+    rcc.append(contents);
+    rcc.append(treeOffset - rcc.size(), '\0');
+
+    // The root directory, with the file as its only child
+    write(0, 4); // name offset
+    write(0x02, 2); // directory
+    write(1, 4); // child count
+    write(1, 4); // first child
+    write(0, 8); // last modified
+
+    // The file
+    write(0, 4); // name offset
+    write(0, 2); // uncompressed
+    write(0, 2); // any territory
+    write(0, 2); // any language
+    write(0, 4); // data offset
+    write(lastModified.toMSecsSinceEpoch(), 8);
+
+    write(fileName.size(), 2);
+    write(qt_hash(fileName), 4);
+    for (const QChar c : fileName)
+        write(c.unicode(), 2);
+
+    std::vector<quint64> resource((rcc.size() + 7) / 8);
+    memcpy(resource.data(), rcc.constData(), rcc.size());
+    return resource;
+}
+
+void tst_qmldiskcache::useResourceUnitInPlace()
+{
+    const QString resourceRoot = QStringLiteral("/inplace");
+    const QDateTime lastModified = QDateTime::currentDateTime().addDays(-1);
+
+    const std::vector<quint64> source = singleFileResource(
+            QStringLiteral("test.qml"), "import QtQml\nQtObject { objectName: 'inplace' }\n",
+            lastModified);
+    QVERIFY(QResource::registerResource(reinterpret_cast<const uchar *>(source.data()),
+                                        resourceRoot));
+    auto unregisterSource = qScopeGuard([&]() {
+        QResource::unregisterResource(reinterpret_cast<const uchar *>(source.data()),
+                                      resourceRoot);
+    });
+
+    const QUrl url(QStringLiteral("qrc:/inplace/test.qml"));
+    const QString cacheFilePath = QV4::ExecutableCompilationUnit::localCacheFilePath(url);
+    QFile::remove(cacheFilePath);
+
+    {
+        QQmlEngine engine;
+        CleanlyLoadingComponent component(&engine, url);
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    }
+
+    QFile cacheFile(cacheFilePath);
+    QVERIFY2(cacheFile.open(QIODevice::ReadOnly), qPrintable(cacheFile.errorString()));
+    const std::vector<quint64> cache = singleFileResource(
+            QStringLiteral("test.qmlc"), cacheFile.readAll(), lastModified);
+    QVERIFY(QResource::registerResource(reinterpret_cast<const uchar *>(cache.data()),
+                                        resourceRoot));
+    auto unregisterCache = qScopeGuard([&]() {
+        QResource::unregisterResource(reinterpret_cast<const uchar *>(cache.data()),
+                                      resourceRoot);
+    });
+
+    const QResource embeddedUnit(QStringLiteral(":/inplace/test.qmlc"));
+    QVERIFY(embeddedUnit.isValid());
+    QCOMPARE(embeddedUnit.compressionAlgorithm(), QResource::NoCompression);
+
+    QQmlRefPointer<QV4::ExecutableCompilationUnit> unit
+            = QV4::ExecutableCompilationUnit::create();
+    QString errorString;
+    QVERIFY2(unit->loadFromDisk(url, QFileInfo(QStringLiteral(":/inplace/test.qml")).lastModified(),
+                                &errorString),
+             qPrintable(errorString));
+    QCOMPARE(reinterpret_cast<const uchar *>(unit->unitData()), embeddedUnit.data());
+}
+
 class AParent : public QObject
 {
     Q_OBJECT
@@ -0,0 +1,16 @@
+import QtQml
+
+QtObject {
+    property int source: 1
+
+    property int a: source + 1
+    property int b: source * 2
+    property int d: source + 3
+    property int e: d + 1
+
+    property var counter: ({ evaluations: 0 })
+    property int c: {
+        ++counter.evaluations;
+        return a + b + e;
+    }
+}
@@ -0,0 +1,10 @@
+import QtQml
+
+QtObject {
+    property bool useB: true
+    property int a: 1
+    property int b: 2
+    property int c: 3
+
+    property int result: a + a + (useB ? b : 0) + c
+}
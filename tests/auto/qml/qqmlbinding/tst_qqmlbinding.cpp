@@ -4,7 +4,10 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <QtQml/private/qqmlbind_p.h>
+#include <QtQml/private/qqmlbindingbatch_p.h>
 #include <QtQml/private/qqmlcomponentattached_p.h>
+#include <QtQml/private/qqmlengine_p.h>
+#include <QtQml/private/qqmlproperty_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include "WithBindableProperties.h"
@@ -40,6 +43,9 @@ private slots:
     void localSignalHandler();
     void whenEvaluatedEarlyEnough();
     void propertiesAttachedToBindingItself();
+    void batchedUpdates();
+    void batchedUpdateOfDestroyedTarget();
+    void stableDependencies();
 
 private:
     QQmlEngine engine;
@@ -625,6 +631,135 @@ void tst_qqmlbinding::propertiesAttachedToBindingItself()
     QTRY_COMPARE(root->property("check").toInt(), 3);
 }
 
+void tst_qqmlbinding::batchedUpdates()
+{
+    QQmlEngine e;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&e);
+    ep->setBindingBatchingEnabled(true);
+    QQmlBindingBatch *batch = ep->bindingBatch;
+    QVERIFY(batch);
+
+    QQmlComponent c(&e, testFileUrl("batchedUpdates.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    std::unique_ptr<QObject> root { c.create() };
+    QVERIFY2(root, qPrintable(c.errorString()));
+    batch->flush();
+    QCOMPARE(root->property("c").toInt(), 2 + 2 + 5);
+
+    auto evaluations = [&]() {
+        return root->property("counter").value<QJSValue>().property("evaluations").toInt();
+    };
+
+    // The first batch teaches the ranks of the bindings
+    root->setProperty("source", 2);
+    QCOMPARE(root->property("c").toInt(), 2 + 2 + 5);
+    batch->flush();
+    QCOMPARE(root->property("c").toInt(), 3 + 4 + 6);
+
+    // Now c is evaluated last, and only once
+    const int evaluationsBefore = evaluations();
+    batch->resetStatistics();
+    root->setProperty("source", 3);
+    QVERIFY(!batch->isEmpty());
+    QCOMPARE(root->property("c").toInt(), 3 + 4 + 6);
+    batch->flush();
+    QVERIFY(batch->isEmpty());
+    QCOMPARE(root->property("c").toInt(), 4 + 6 + 7);
+    QCOMPARE(evaluations() - evaluationsBefore, 1);
+    QCOMPARE(batch->statistics().batches, 1u);
+    QCOMPARE(batch->statistics().evaluations, 5u);
+    QVERIFY(batch->statistics().avoided >= 2);
+
+    // Switching back to immediate updates brings the bindings up to date
+    root->setProperty("source", 4);
+    ep->setBindingBatchingEnabled(false);
+    QVERIFY(!ep->bindingBatch);
+    QCOMPARE(root->property("c").toInt(), 5 + 8 + 8);
+    root->setProperty("source", 5);
+    QCOMPARE(root->property("c").toInt(), 6 + 10 + 9);
+}
+
+void tst_qqmlbinding::stableDependencies()
+{
+    QQmlEngine e;
+    QQmlComponent c(&e, testFileUrl("stableDependencies.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    std::unique_ptr<QObject> root { c.create() };
+    QVERIFY2(root, qPrintable(c.errorString()));
+
+    auto *binding = static_cast<QQmlBinding *>(
+            QQmlPropertyPrivate::binding(QQmlProperty(root.get(), QStringLiteral("result"))));
+    QVERIFY(binding);
+
+    // a is captured, and guarded, twice
+    QCOMPARE(binding->dependencies().size(), 5);
+    QCOMPARE(root->property("result").toInt(), 1 + 1 + 2 + 3);
+
+    // Evaluate often enough for the dependencies to be considered stable
+    for (int i = 2; i < 8; ++i) {
+        root->setProperty("a", i);
+        QCOMPARE(root->property("result").toInt(), i + i + 2 + 3);
+        QCOMPARE(binding->dependencies().size(), 5);
+    }
+
+    // Dropping a dependency
+    root->setProperty("useB", false);
+    QCOMPARE(root->property("result").toInt(), 7 + 7 + 3);
+    QCOMPARE(binding->dependencies().size(), 4);
+    root->setProperty("b", 10);
+    QCOMPARE(root->property("result").toInt(), 7 + 7 + 3);
+    for (int i = 4; i < 10; ++i) {
+        root->setProperty("c", i);
+        QCOMPARE(root->property("result").toInt(), 7 + 7 + i);
+        QCOMPARE(binding->dependencies().size(), 4);
+    }
+
+    // Adding it back
+    root->setProperty("useB", true);
+    QCOMPARE(root->property("result").toInt(), 7 + 7 + 10 + 9);
+    QCOMPARE(binding->dependencies().size(), 5);
+    root->setProperty("b", 20);
+    QCOMPARE(root->property("result").toInt(), 7 + 7 + 20 + 9);
+    root->setProperty("a", 1);
+    QCOMPARE(root->property("result").toInt(), 1 + 1 + 20 + 9);
+}
+
+void tst_qqmlbinding::batchedUpdateOfDestroyedTarget()
+{
+    QQmlEngine e;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&e);
+    ep->setBindingBatchingEnabled(true);
+    QQmlBindingBatch *batch = ep->bindingBatch;
+    QVERIFY(batch);
+
+    QQmlComponent c(&e);
+    c.setData("import QtQml\n"
+              "QtObject {\n"
+              "    property int source: 1\n"
+              "    property QtObject target: QtObject { property int value: source * 2 }\n"
+              "    property int other: source + 1\n"
+              "}\n", QUrl());
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    std::unique_ptr<QObject> root { c.create() };
+    QVERIFY2(root, qPrintable(c.errorString()));
+    batch->flush();
+
+    QObject *target = root->property("target").value<QObject *>();
+    QVERIFY(target);
+    QCOMPARE(target->property("value").toInt(), 2);
+
+    // Both bindings are pending when the target of one of them is destroyed.
+    root->setProperty("source", 2);
+    batch->resetStatistics();
+    QVERIFY(!batch->isEmpty());
+    delete target;
+
+    batch->flush();
+    QVERIFY(batch->isEmpty());
+    QCOMPARE(root->property("other").toInt(), 3);
+    QCOMPARE(batch->statistics().evaluations, 1u);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
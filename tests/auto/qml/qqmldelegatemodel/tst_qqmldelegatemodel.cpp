@@ -9,6 +9,8 @@
 #include <QtQml/qqmlapplicationengine.h>
 #include <QtQmlModels/private/qqmldelegatemodel_p.h>
 #include <QtQmlModels/private/qqmllistmodel_p.h>
+#include <QtQml/private/qqmlbindingbatch_p.h>
+#include <QtQml/private/qqmlengine_p.h>
 #include <QtQuick/qquickview.h>
 #include <QtQuick/qquickitem.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
@@ -40,6 +42,7 @@ private slots:
     void unknownContainersAsModel();
     void doNotUnrefObjectUnderConstruction();
     void clearCacheDuringInsertion();
+    void batchedDataChanged();
 };
 
 class AbstractItemModel : public QAbstractItemModel
@@ -564,6 +567,61 @@ void tst_QQmlDelegateModel::clearCacheDuringInsertion()
     QTRY_COMPARE(object->property("testModel").toInt(), 0);
 }
 
+void tst_QQmlDelegateModel::batchedDataChanged()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->setBindingBatchingEnabled(true);
+
+    QStandardItemModel model;
+    model.appendRow(new QStandardItem("a"));
+    model.appendRow(new QStandardItem("b"));
+
+    QQmlComponent modelComponent(&engine);
+    modelComponent.setData("import QtQml.Models\nDelegateModel {}\n", QUrl());
+    QCOMPARE(modelComponent.status(), QQmlComponent::Ready);
+    QScopedPointer<QObject> o(modelComponent.create());
+    QQmlDelegateModel *delegateModel = qobject_cast<QQmlDelegateModel *>(o.data());
+    QVERIFY(delegateModel);
+
+    QQmlComponent delegateComponent(&engine);
+    delegateComponent.setData("import QtQml\nQtObject {\n"
+                              "    property string text: display\n"
+                              "    property int changes: 0\n"
+                              "    onTextChanged: ++changes\n"
+                              "}\n", QUrl());
+    QCOMPARE(delegateComponent.status(), QQmlComponent::Ready);
+    delegateModel->setDelegate(&delegateComponent);
+    delegateModel->setModel(QVariant::fromValue<QObject *>(&model));
+
+    QObject *first = delegateModel->object(0, QQmlIncubator::Synchronous);
+    QObject *second = delegateModel->object(1, QQmlIncubator::Synchronous);
+    QVERIFY(first);
+    QVERIFY(second);
+    QCOMPARE(first->property("text").toString(), QLatin1String("a"));
+
+    // Several changes of the same item result in one change signal when the batch is flushed
+    model.item(0)->setText("c");
+    model.item(0)->setText("d");
+    model.item(0)->setText("e");
+    QCOMPARE(first->property("text").toString(), QLatin1String("a"));
+    QVERIFY(!ep->bindingBatch->isEmpty());
+
+    ep->bindingBatch->flush();
+    QCOMPARE(first->property("text").toString(), QLatin1String("e"));
+    QCOMPARE(first->property("changes").toInt(), 1);
+    QCOMPARE(second->property("text").toString(), QLatin1String("b"));
+    QCOMPARE(second->property("changes").toInt(), 0);
+
+    // The queued flush brings the delegates up to date without an explicit one
+    model.item(1)->setText("f");
+    QTRY_COMPARE(second->property("text").toString(), QLatin1String("f"));
+    QCOMPARE(second->property("changes").toInt(), 1);
+
+    delegateModel->release(first);
+    delegateModel->release(second);
+}
+
 QTEST_MAIN(tst_QQmlDelegateModel)
 
 #include "tst_qqmldelegatemodel.moc"
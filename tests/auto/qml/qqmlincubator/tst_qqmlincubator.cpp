@@ -40,6 +40,7 @@ private slots:
     void asynchronousIfNested();
     void nestedComponent();
     void chainedAsynchronousIfNested();
+    void nestedIncubatorsFirst();
     void chainedAsynchronousIfNestedOnCompleted();
     void chainedAsynchronousClear();
     void selfDelete();
@@ -794,6 +795,55 @@ void tst_qqmlincubator::chainedAsynchronousIfNested()
     incubator2.object()->deleteLater();
 }
 
+// Nested incubators block the completion of their parent, and are therefore incubated before
+// incubators that were started later but do not block anything
+void tst_qqmlincubator::nestedIncubatorsFirst()
+{
+    SelfRegisteringType::clearMe();
+
+    QQmlComponent component(&engine, testFileUrl("asynchronousIfNested.2.qml"));
+    QVERIFY(component.isReady());
+
+    QQmlIncubator incubator;
+    component.create(incubator);
+
+    while (SelfRegisteringType::me() == nullptr && incubator.isLoading()) {
+        std::atomic<bool> b{false};
+        controller.incubateWhile(&b);
+    }
+    QVERIFY(SelfRegisteringType::me() != nullptr);
+    QVERIFY(incubator.isLoading());
+
+    QQmlIncubator nested(QQmlIncubator::AsynchronousIfNested);
+    component.create(nested, nullptr, qmlContext(SelfRegisteringType::me()));
+    QVERIFY(nested.isLoading());
+
+    QQmlComponent laterComponent(&engine, testFileUrl("asynchronousIfNested.1.qml"));
+    QVERIFY(laterComponent.isReady());
+    QQmlIncubator later;
+    laterComponent.create(later);
+    QVERIFY(later.isLoading());
+
+    while (nested.isLoading()) {
+        QVERIFY(later.isLoading());
+        std::atomic<bool> b{false};
+        controller.incubateWhile(&b);
+    }
+    QVERIFY(nested.isReady());
+
+    {
+        std::atomic<bool> b{true};
+        controller.incubateWhile(&b);
+    }
+
+    QVERIFY(incubator.isReady());
+    QVERIFY(later.isReady());
+
+    delete later.object();
+    delete nested.object();
+    delete incubator.object();
+}
+
 // Checks that new AsynchronousIfNested incubators can be correctly chained if started in
 // componentCompleted().
 void tst_qqmlincubator::chainedAsynchronousIfNestedOnCompleted()
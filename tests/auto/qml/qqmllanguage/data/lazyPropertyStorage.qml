@@ -0,0 +1,18 @@
+import QtQml
+
+QtObject {
+    // Object properties need storage, so the literals live in an object of their own
+    property QtObject literals: QtObject {
+        property int i: 5
+        property real r: 2.5
+        property bool b: true
+        property string s: "literal"
+        property int plain
+        property url u
+    }
+
+    property QtObject observed: QtObject {
+        onIChanged: {}
+        property int i: 7
+    }
+}
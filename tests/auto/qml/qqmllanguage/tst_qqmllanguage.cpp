@@ -89,6 +89,7 @@ private slots:
     void assignLiteralSignalProperty();
     void assignQmlComponent();
     void assignValueTypes();
+    void decodedLiteralValues();
     void assignTypeExtremes();
     void assignCompositeToType();
     void assignLiteralToVar();
@@ -437,6 +438,7 @@ private slots:
     void objectInQmlListAndGc();
     void asCastToInlineComponent();
     void deepAliasOnICOrReadonly();
+    void lazyPropertyStorage();
 
 private:
     QQmlEngine engine;
@@ -929,6 +931,50 @@ void tst_qqmllanguage::assignValueTypes()
     QCOMPARE(object->property("mirroredEnumTriggeredChange").toBool(), false);
 }
 
+void tst_qqmllanguage::decodedLiteralValues()
+{
+    QQmlComponent component(&engine, testFileUrl("assignValueTypes.qml"));
+    VERIFY_ERRORS(0);
+
+    auto compilationUnit = QQmlComponentPrivate::get(&component)->compilationUnit;
+    QVERIFY(compilationUnit);
+    QCOMPARE(compilationUnit->bindingLiteralValuesPerObject.size(),
+             qsizetype(compilationUnit->objectCount()));
+
+    // The literals to be converted have been decoded by the type loader
+    const QV4::CompiledData::Object *root = compilationUnit->objectAt(/*root object*/0);
+    const QV4::BindingLiteralValues &values = compilationUnit->bindingLiteralValuesPerObject.at(0);
+    QCOMPARE(values.size(), qsizetype(root->nBindings));
+    QHash<QString, QVariant> decoded;
+    const QV4::CompiledData::Binding *binding = root->bindingTable();
+    for (quint32 i = 0; i < root->nBindings; ++i, ++binding) {
+        if (values.at(i).isValid())
+            decoded.insert(compilationUnit->stringAt(binding->propertyNameIndex), values.at(i));
+    }
+    QCOMPARE(decoded.value("colorProperty"), QVariant(QColor("red")));
+    QCOMPARE(decoded.value("pointProperty"), QVariant(QPoint(99, 13)));
+    QCOMPARE(decoded.value("rectFProperty"), QVariant(QRectF(1000.1, -10.9, 400, 90.99)));
+    QCOMPARE(decoded.value("vector4Property"), QVariant(QVector4D(10, 1, 2.2f, 2.3f)));
+    QVERIFY(decoded.contains("urlProperty"));
+    QVERIFY(!decoded.contains("stringProperty"));
+    QVERIFY(!decoded.contains("intProperty"));
+    QVERIFY(!decoded.contains("enumProperty"));
+    QVERIFY(!decoded.contains("variantProperty"));
+
+    // Each object gets its own copy
+    QScopedPointer<MyTypeObject> first(qobject_cast<MyTypeObject *>(component.create()));
+    QVERIFY(first);
+    QScopedPointer<MyTypeObject> second(qobject_cast<MyTypeObject *>(component.create()));
+    QVERIFY(second);
+    first->setColorProperty(QColor("blue"));
+    first->setPointProperty(QPoint(1, 2));
+    QCOMPARE(second->colorProperty(), QColor("red"));
+    QCOMPARE(second->pointProperty(), QPoint(99, 13));
+    QCOMPARE(second->dateTimeProperty(), QDateTime(QDate(2009, 5, 12), QTime(13, 22, 1)));
+    QCOMPARE(second->urlProperty(),
+             QUrl::fromEncoded("main.qml?with%3cencoded%3edata", QUrl::TolerantMode));
+}
+
 // Test edge case type assignments
 void tst_qqmllanguage::assignTypeExtremes()
 {
@@ -8425,6 +8471,48 @@ void tst_qqmllanguage::deepAliasOnICOrReadonly()
                     "Invalid property assignment: \"readonlyRectX\" is a read-only property")));
 }
 
+void tst_qqmllanguage::lazyPropertyStorage()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("lazyPropertyStorage.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> root(c.create());
+    QVERIFY(!root.isNull());
+
+    // Literal values are served without allocating any storage
+    QObject *o = root->property("literals").value<QObject *>();
+    QVERIFY(o);
+    QQmlVMEMetaObject *vmemo = QQmlVMEMetaObject::get(o);
+    QVERIFY(vmemo);
+    QCOMPARE(o->property("i").toInt(), 5);
+    QCOMPARE(o->property("r").toDouble(), 2.5);
+    QCOMPARE(o->property("b").toBool(), true);
+    QCOMPARE(o->property("s").toString(), QLatin1String("literal"));
+    QCOMPARE(o->property("plain").toInt(), 0);
+    QCOMPARE(o->property("u").toUrl(), QUrl());
+    QVERIFY(!vmemo->propertyAndMethodStorage.valueRef());
+
+    // The first write allocates the storage, and keeps the other literal values
+    QSignalSpy spy(o, SIGNAL(iChanged()));
+    QVERIFY(o->setProperty("i", 5));
+    QCOMPARE(spy.size(), 0);
+    QVERIFY(o->setProperty("i", 6));
+    QCOMPARE(spy.size(), 1);
+    QVERIFY(vmemo->propertyAndMethodStorage.valueRef());
+    QCOMPARE(o->property("i").toInt(), 6);
+    QCOMPARE(o->property("r").toDouble(), 2.5);
+    QCOMPARE(o->property("b").toBool(), true);
+    QCOMPARE(o->property("s").toString(), QLatin1String("literal"));
+
+    // A signal handler could observe the initial change signal, so the value is written
+    QObject *observed = root->property("observed").value<QObject *>();
+    QVERIFY(observed);
+    QQmlVMEMetaObject *observedVmemo = QQmlVMEMetaObject::get(observed);
+    QVERIFY(observedVmemo);
+    QVERIFY(observedVmemo->propertyAndMethodStorage.valueRef());
+    QCOMPARE(observed->property("i").toInt(), 7);
+}
+
 QTEST_MAIN(tst_qqmllanguage)
 
 #include "tst_qqmllanguage.moc"
@@ -6,10 +6,14 @@
 #include <QtCore/qprocess.h>
 #endif
 #include <QtCore/qtemporaryfile.h>
+#include <QtQml/qjsengine.h>
 #include <QtQml/qqml.h>
 #include <QtQml/qqmlapplicationengine.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 
+#include <private/qjsvalue_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4functionobject_p.h>
 #include <private/qv4global_p.h>
 
 #ifdef Q_OS_WIN
@@ -28,6 +32,7 @@ private slots:
     void perfMapFile();
     void functionTable();
     void jitEnabled();
+    void optimizingTier();
 };
 
 tst_QV4Assembler::tst_QV4Assembler()
@@ -38,6 +43,19 @@ tst_QV4Assembler::tst_QV4Assembler()
 void tst_QV4Assembler::initTestCase()
 {
     qputenv("QV4_JIT_CALL_THRESHOLD", "0");
+
+    // The JIT thresholds are read once, when the first engine is created. Optimize functions on
+    // their second call, but don't pass that on to the processes the tests start.
+    const QByteArray origOptimizeThreshold = qgetenv("QV4_JIT_OPTIMIZE_THRESHOLD");
+    qputenv("QV4_JIT_OPTIMIZE_THRESHOLD", "0");
+    {
+        QJSEngine engine;
+    }
+    if (origOptimizeThreshold.isNull())
+        qunsetenv("QV4_JIT_OPTIMIZE_THRESHOLD");
+    else
+        qputenv("QV4_JIT_OPTIMIZE_THRESHOLD", origOptimizeThreshold);
+
     QQmlDataTest::initTestCase();
 }
 
@@ -143,6 +161,72 @@ void tst_QV4Assembler::jitEnabled()
 #endif
 }
 
+void tst_QV4Assembler::optimizingTier()
+{
+    // The first call of each function runs baseline code, every later call runs optimized
+    // code that was specialized for what the first call saw.
+    QJSEngine engine;
+    const QJSValue result = engine.evaluate(R"(
+        function sum(from, to) {
+            var s = 0;
+            for (var i = from; i < to; ++i)
+                s = s + i * 2 - 1;
+            return s;
+        }
+        function add(a, b) { return a + b; }
+        function scale(a, b) { return a * b - 1; }
+        function less(a, b) { return a < b; }
+        function twice(a) { return a + a; }
+
+        var results = [];
+        for (var i = 0; i < 3; ++i)
+            results.push(sum(0, 100));
+        results.push(sum(0.5, 3));
+
+        results.push(add(1, 2), add(0x7fffffff, 1), add(0.5, 0.25), add("a", 1), add(1, 2));
+        results.push(scale(0.5, 3), scale(3, 4), scale(0x10000, 0x10000), scale("2", 2));
+        results.push(less(1, 2), less(2.5, 1), less(1, 1.5), less("a", "b"), less(NaN, 1));
+        results.push(twice(3), twice(4), twice(5));
+        results.join(",");
+    )");
+    QVERIFY(!result.isError());
+    QCOMPARE(result.toString(),
+             QStringLiteral("9800,9800,9800,6,"
+                            "3,2147483648,0.75,a1,3,"
+                            "0.5,11,4294967295,3,"
+                            "true,false,true,true,false,"
+                            "6,8,10"));
+
+#if !ENABLE_OPTIMIZING_JIT
+    QSKIP("The optimizing JIT is not available on this platform");
+#else
+    const auto function = [&](const char *name) -> QV4::Function * {
+        const QJSValue value = engine.globalObject().property(QLatin1String(name));
+        const QV4::FunctionObject *functionObject
+                = QJSValuePrivate::asManagedType<QV4::FunctionObject>(&value);
+        return functionObject ? functionObject->function() : nullptr;
+    };
+
+    // Each of these functions was optimized after its first call, and has since been called
+    // with operands its speculations did not cover.
+    for (const char *name : { "sum", "add", "scale", "less" }) {
+        QV4::Function *f = function(name);
+        QVERIFY(f);
+        QVERIFY2(f->optimized, name);
+        QVERIFY2(f->baselineJittedCode, name);
+        QVERIFY2(f->deoptimizationCount > 0, name);
+    }
+
+    // This one never left the optimized code.
+    QV4::Function *f = function("twice");
+    QVERIFY(f);
+    QVERIFY(f->optimized);
+    QVERIFY(f->baselineJittedCode);
+    QVERIFY(f->jittedCode != f->baselineJittedCode);
+    QCOMPARE(f->deoptimizationCount, quint16(0));
+#endif
+}
+
 QTEST_MAIN(tst_QV4Assembler)
 
 #include "tst_qv4assembler.moc"
@@ -12,6 +12,7 @@
 
 #include <QtQuick/qsgsimplerectnode.h>
 #include <QtQuick/qsgsimpletexturenode.h>
+#include <QtQuick/qsgflatcolormaterial.h>
 #include <QtQuick/private/qsgplaintexture_p.h>
 
 #include <QtGui/private/qguiapplication_p.h>
@@ -77,9 +78,25 @@ private Q_SLOTS:
     void textureNodeRect_data();
     void textureNodeRect();
 
+    // Batch renderer
+    void mergedVertices_data();
+    void mergedVertices();
+    void mergedIndices_data();
+    void mergedIndices();
+    void mergedUpload_data();
+    void mergedUpload();
+
 private:
     void rhiTestData();
 
+    struct MergedBatch {
+        QRhiBufferReadbackResult vertices;
+        QRhiBufferReadbackResult indices;
+        QList<int> drawSets;
+        int vertexCount = 0;
+    };
+    QList<MergedBatch> renderMergedBatches(QRhi *rhi, QSGRootNode *root, int uploadThreadCount);
+
     QSGDefaultRenderContext *renderContext = nullptr;
 
     struct {
@@ -485,6 +502,233 @@ void NodesTest::textureNodeRect()
     renderContext->invalidate();
 }
 
+void NodesTest::mergedVertices_data()
+{
+    QTest::addColumn<int>("stride");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QMatrix4x4>("matrix");
+    QTest::addColumn<bool>("translateOnly");
+
+    QMatrix4x4 translation;
+    translation.translate(10.5f, -3.25f);
+    QMatrix4x4 transform;
+    transform.translate(7, 11);
+    transform.rotate(30, 0, 0, 1);
+    transform.scale(2.0f, 0.5f);
+
+    // Strides of positions only, and of colored and textured vertices
+    for (int stride : { 8, 12, 16 }) {
+        for (int count : { 0, 1, 2, 3, 8, 11 }) {
+            QTest::addRow("translate, stride %d, %d vertices", stride, count)
+                    << stride << count << translation << true;
+            QTest::addRow("transform, stride %d, %d vertices", stride, count)
+                    << stride << count << transform << false;
+        }
+    }
+}
+
+void NodesTest::mergedVertices()
+{
+    QFETCH(int, stride);
+    QFETCH(int, count);
+    QFETCH(QMatrix4x4, matrix);
+    QFETCH(bool, translateOnly);
+
+    // Guard bytes after the vertices must not be written
+    QByteArray source(stride * count + 16, Qt::Uninitialized);
+    for (int i = 0; i < source.size(); ++i)
+        source[i] = char(i * 7);
+    for (int i = 0; i < count; ++i) {
+        float *p = reinterpret_cast<float *>(source.data() + i * stride);
+        p[0] = i * 3.5f - 4;
+        p[1] = 100 - i * 1.25f;
+    }
+
+    QByteArray vertices = source;
+    if (translateOnly) {
+        QSGBatchRenderer::qsg_translateVertices(vertices.data(), count, stride,
+                                                matrix(0, 3), matrix(1, 3));
+    } else {
+        QSGBatchRenderer::qsg_transformVertices(vertices.data(), count, stride, matrix);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const float *s = reinterpret_cast<const float *>(source.constData() + i * stride);
+        const float *v = reinterpret_cast<const float *>(vertices.constData() + i * stride);
+        const QPointF expected = matrix.map(QPointF(s[0], s[1]));
+        QCOMPARE(v[0], float(expected.x()));
+        QCOMPARE(v[1], float(expected.y()));
+        QCOMPARE(vertices.mid(i * stride + 8, stride - 8), source.mid(i * stride + 8, stride - 8));
+    }
+    QCOMPARE(vertices.mid(count * stride), source.mid(count * stride));
+}
+
+void NodesTest::mergedIndices_data()
+{
+    QTest::addColumn<int>("count");
+
+    for (int count : { 0, 1, 7, 8, 9, 16, 23 })
+        QTest::addRow("%d indices", count) << count;
+}
+
+void NodesTest::mergedIndices()
+{
+    QFETCH(int, count);
+
+    QList<quint16> source(count);
+    for (int i = 0; i < count; ++i)
+        source[i] = quint16(i * 4099);
+
+    // One element more than needed, which must not be written
+    QList<quint16> indices16(count + 1, 0xabcd);
+    QSGBatchRenderer::qsg_offsetIndices(indices16.data(), source.constData(), count, 1000);
+    QList<quint32> indices32(count + 1, 0xabcdef);
+    QSGBatchRenderer::qsg_offsetIndices(indices32.data(), source.constData(), count, 70000);
+
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(indices16.at(i), quint16(source.at(i) + 1000));
+        QCOMPARE(indices32.at(i), quint32(source.at(i)) + 70000);
+    }
+    QCOMPARE(indices16.at(count), 0xabcd);
+    QCOMPARE(indices32.at(count), 0xabcdefu);
+}
+
+// Adds nodes which all end up in one merged batch, each below a transform of its own
+static void addMergeableNodes(QSGNode *parent, QSGMaterial *material,
+                              QSGGeometry::DrawingMode drawingMode, int count, int verticesPerNode)
+{
+    const bool strip = drawingMode == QSGGeometry::DrawTriangleStrip;
+    const int indexCount = strip ? verticesPerNode : (verticesPerNode - 2) * 3;
+    for (int n = 0; n < count; ++n) {
+        QMatrix4x4 matrix;
+        matrix.translate(n % 100 * 10, n / 100 * 10);
+        if (n % 3 == 0)
+            matrix.rotate(n % 360, 0, 0, 1);
+        auto *transform = new QSGTransformNode;
+        transform->setMatrix(matrix);
+        parent->appendChildNode(transform);
+
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),
+                                         verticesPerNode, indexCount);
+        geometry->setDrawingMode(drawingMode);
+        QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+        for (int i = 0; i < verticesPerNode; ++i)
+            vertices[i].set(i / 2 * 0.5f + n % 7, i % 2 * 3.0f);
+        // The triangles of the strip, as a list
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int i = 0; i < indexCount; ++i)
+            indices[i] = strip ? i : i / 3 + i % 3;
+
+        auto *node = new QSGGeometryNode;
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(material);
+        transform->appendChildNode(node);
+    }
+}
+
+QList<NodesTest::MergedBatch> NodesTest::renderMergedBatches(QRhi *rhi, QSGRootNode *root,
+                                                             int uploadThreadCount)
+{
+    QSGBatchRenderer::Renderer renderer(renderContext);
+    renderer.m_uploadThreadCount = uploadThreadCount;
+    renderer.setRootNode(root);
+
+    const QSize size(64, 64);
+    QScopedPointer<QRhiTexture> texture(rhi->newTexture(QRhiTexture::RGBA8, size, 1,
+                                                        QRhiTexture::RenderTarget));
+    texture->create();
+    QScopedPointer<QRhiRenderBuffer> ds(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, size));
+    ds->create();
+    QRhiTextureRenderTargetDescription rtDesc(QRhiColorAttachment(texture.data()));
+    rtDesc.setDepthStencilBuffer(ds.data());
+    QScopedPointer<QRhiTextureRenderTarget> rt(rhi->newTextureRenderTarget(rtDesc));
+    QScopedPointer<QRhiRenderPassDescriptor> rp(rt->newCompatibleRenderPassDescriptor());
+    rt->setRenderPassDescriptor(rp.data());
+    rt->create();
+
+    QRhiCommandBuffer *cb = nullptr;
+    rhi->beginOffscreenFrame(&cb);
+    renderContext->beginNextFrame(&renderer, QSGRenderTarget(rt.data(), rp.data(), cb),
+                                  nullptr, nullptr, nullptr);
+    renderer.setDeviceRect(size);
+    renderer.setViewportRect(size);
+    renderer.setProjectionMatrixToRect(QRectF(0, 0, 1000, 1000));
+    renderContext->renderNextFrame(&renderer);
+
+    int mergedCount = 0;
+    for (int i = 0; i < renderer.m_opaqueBatches.size(); ++i)
+        mergedCount += renderer.m_opaqueBatches.at(i)->merged;
+
+    QList<MergedBatch> batches(mergedCount);
+    QRhiResourceUpdateBatch *readbacks = rhi->nextResourceUpdateBatch();
+    auto batch = batches.begin();
+    for (int i = 0; i < renderer.m_opaqueBatches.size(); ++i) {
+        const QSGBatchRenderer::Batch *b = renderer.m_opaqueBatches.at(i);
+        if (!b->merged)
+            continue;
+        readbacks->readBackBuffer(b->vbo.buf, 0, b->vbo.size, &batch->vertices);
+        readbacks->readBackBuffer(b->ibo.buf, 0, b->ibo.size, &batch->indices);
+        for (int j = 0; j < b->drawSets.size(); ++j) {
+            const QSGBatchRenderer::DrawSet &set = b->drawSets.at(j);
+            batch->drawSets << set.vertices << set.zorders << set.indices << set.indexCount;
+        }
+        batch->vertexCount = b->vertexCount;
+        ++batch;
+    }
+    cb->resourceUpdate(readbacks);
+
+    renderContext->endNextFrame(&renderer);
+    rhi->endOffscreenFrame();
+    return batches;
+}
+
+void NodesTest::mergedUpload_data()
+{
+    QTest::addColumn<QRhi::Implementation>("impl");
+    QTest::addColumn<QRhiInitParams *>("initParams");
+    QTest::addColumn<int>("drawingMode");
+
+    // The null backend keeps the buffer contents, so it is enough to compare the uploads
+    QRhiInitParams *params = &initParams.null;
+    QTest::newRow("triangles") << QRhi::Null << params << int(QSGGeometry::DrawTriangles);
+    QTest::newRow("triangle strips") << QRhi::Null << params << int(QSGGeometry::DrawTriangleStrip);
+}
+
+void NodesTest::mergedUpload()
+{
+    INIT_RHI();
+    QFETCH(int, drawingMode);
+
+    // More vertices than fit into one draw set with 16 bit indices, and enough
+    // for each of the upload threads to get a range of elements
+    QSGFlatColorMaterial material;
+    material.setColor(Qt::darkBlue);
+    QSGRootNode root;
+    addMergeableNodes(&root, &material, QSGGeometry::DrawingMode(drawingMode), 4000, 24);
+
+    const QList<MergedBatch> serial = renderMergedBatches(rhi.data(), &root, 1);
+    const QList<MergedBatch> threaded = renderMergedBatches(rhi.data(), &root, 4);
+
+    QCOMPARE(serial.size(), 1);
+    QCOMPARE(serial.first().vertexCount, 4000 * 24);
+    // The null backend gets 16 bit indices, so the batch is split into two draw sets
+    QCOMPARE(serial.first().drawSets.size(), 2 * 4);
+
+    // The readback holds what was uploaded
+    const QByteArray &vertices = serial.first().vertices.data;
+    QVERIFY(std::any_of(vertices.cbegin(), vertices.cend(), [](char c) { return c != 0; }));
+
+    QCOMPARE(threaded.size(), serial.size());
+    for (int i = 0; i < serial.size(); ++i) {
+        QCOMPARE(threaded.at(i).drawSets, serial.at(i).drawSets);
+        QCOMPARE(threaded.at(i).vertices.data, serial.at(i).vertices.data);
+        QCOMPARE(threaded.at(i).indices.data, serial.at(i).indices.data);
+    }
+
+    renderContext->invalidate();
+}
+
 QTEST_MAIN(NodesTest);
 
 #include "tst_nodestest.moc"
@@ -0,0 +1,26 @@
+import QtQuick
+
+Column {
+    Text {
+        objectName: "first"
+        text: "Shared layout"
+        font.pixelSize: 16
+    }
+    Text {
+        objectName: "second"
+        text: "Shared layout"
+        font.pixelSize: 16
+    }
+    Text {
+        objectName: "wrapped"
+        text: "Shared layout"
+        font.pixelSize: 16
+        width: 40
+        wrapMode: Text.Wrap
+    }
+    Text {
+        objectName: "styled"
+        text: "<b>Shared layout</b>"
+        font.pixelSize: 16
+    }
+}
@@ -12,6 +12,7 @@
 #include <QtQuick/private/qquickpixmapcache_p.h>
 #include <QtQuickTest/QtQuickTest>
 #include <private/qquicktext_p_p.h>
+#include <private/qquicktextlayoutcache_p.h>
 #include <private/qsginternaltextnode_p.h>
 #include <private/qquickvaluetypes_p.h>
 #include <QFontMetrics>
@@ -21,6 +22,7 @@
 #include <private/qguiapplication_p.h>
 #include <limits.h>
 #include <QtGui/QMouseEvent>
+#include <QtCore/QScopeGuard>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QtQuickTestUtils/private/testhttpserver_p.h>
 #include <QtQuickTestUtils/private/viewtestutils_p.h>
@@ -162,6 +164,9 @@ private slots:
 
     void displaySuperscriptedTag();
 
+    void sharedLayout();
+    void sharedLayoutAfterPainting();
+
 private:
     QStringList standard;
     QStringList richText;
@@ -4822,6 +4827,102 @@ void tst_qquicktext::displaySuperscriptedTag()
     QCOMPARE(color.green(), 255);
 }
 
+void tst_qquicktext::sharedLayout()
+{
+    const int previousCacheSize = QQuickTextLayoutCache::maximumSize();
+    auto restoreCacheSize = qScopeGuard([previousCacheSize] {
+        QQuickTextLayoutCache::setMaximumSize(previousCacheSize);
+    });
+    QQuickTextLayoutCache::setMaximumSize(1000);
+
+    // The items are laid out when they are completed, they must be in the window by then
+    QQuickWindow window;
+    QQmlComponent component(&engine, testFile("sharedLayout.qml"));
+    QScopedPointer<QObject> object(component.beginCreate(engine.rootContext()));
+    QQuickItem *root = qobject_cast<QQuickItem *>(object.data());
+    QVERIFY2(root, qPrintable(component.errorString()));
+    root->setParentItem(window.contentItem());
+    component.completeCreate();
+
+    QQuickText *first = root->findChild<QQuickText *>("first");
+    QVERIFY(first);
+    QQuickText *second = root->findChild<QQuickText *>("second");
+    QVERIFY(second);
+    QQuickText *wrapped = root->findChild<QQuickText *>("wrapped");
+    QVERIFY(wrapped);
+    QQuickText *styled = root->findChild<QQuickText *>("styled");
+    QVERIFY(styled);
+
+    QQuickTextPrivate *firstPrivate = QQuickTextPrivate::get(first);
+    QQuickTextPrivate *secondPrivate = QQuickTextPrivate::get(second);
+    QVERIFY(firstPrivate->sharedLayout);
+    QCOMPARE(secondPrivate->sharedLayout, firstPrivate->sharedLayout);
+    QCOMPARE(second->implicitWidth(), first->implicitWidth());
+    QCOMPARE(second->implicitHeight(), first->implicitHeight());
+    QCOMPARE(second->lineCount(), 1);
+
+    QVERIFY(QQuickTextPrivate::get(wrapped)->sharedLayout != firstPrivate->sharedLayout);
+    QVERIFY(wrapped->lineCount() > 1);
+    QVERIFY(!QQuickTextPrivate::get(styled)->sharedLayout);
+
+    // Each window paints its own layouts
+    QQuickWindow otherWindow;
+    second->setParentItem(otherWindow.contentItem());
+    QVERIFY(secondPrivate->sharedLayout);
+    QVERIFY(secondPrivate->sharedLayout != firstPrivate->sharedLayout);
+    QCOMPARE(second->implicitWidth(), first->implicitWidth());
+    QCOMPARE(secondPrivate->paintedLayout()->text(), QLatin1String("Shared layout"));
+
+    // Changing the text of one item must not affect the other one
+    second->setText("Another layout");
+    QVERIFY(secondPrivate->sharedLayout != firstPrivate->sharedLayout);
+    QCOMPARE(first->text(), QLatin1String("Shared layout"));
+    QCOMPARE(firstPrivate->paintedLayout()->text(), QLatin1String("Shared layout"));
+    QCOMPARE(secondPrivate->paintedLayout()->text(), QLatin1String("Another layout"));
+}
+
+void tst_qquicktext::sharedLayoutAfterPainting()
+{
+    const int previousCacheSize = QQuickTextLayoutCache::maximumSize();
+    auto restoreCacheSize = qScopeGuard([previousCacheSize] {
+        QQuickTextLayoutCache::setMaximumSize(previousCacheSize);
+    });
+    QQuickTextLayoutCache::setMaximumSize(1000);
+
+    QQuickWindow window;
+    window.resize(200, 200);
+    QSignalSpy frameSwappedSpy(&window, &QQuickWindow::frameSwapped);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick\nText { text: \"Shared layout\"; font.pixelSize: 16 }", QUrl());
+    auto createText = [&]() -> QQuickText * {
+        auto *text = qobject_cast<QQuickText *>(component.beginCreate(engine.rootContext()));
+        if (text) {
+            text->setParentItem(window.contentItem());
+            component.completeCreate();
+        }
+        return text;
+    };
+
+    QScopedPointer<QQuickText> first(createText());
+    QVERIFY2(first, qPrintable(component.errorString()));
+    QQuickTextPrivate *firstPrivate = QQuickTextPrivate::get(first.data());
+    QVERIFY(firstPrivate->sharedLayout);
+    frameSwappedSpy.clear();
+    QTRY_VERIFY(frameSwappedSpy.size() > 0);
+
+    // Painting the layout keeps it in the cache
+    QScopedPointer<QQuickText> second(createText());
+    QVERIFY(second);
+    QCOMPARE(QQuickTextPrivate::get(second.data())->sharedLayout, firstPrivate->sharedLayout);
+    frameSwappedSpy.clear();
+    QTRY_VERIFY(frameSwappedSpy.size() > 0);
+    QCOMPARE(firstPrivate->paintedLayout()->text(), QLatin1String("Shared layout"));
+    QCOMPARE(first->lineCount(), 1);
+}
+
 QT_END_NAMESPACE
 
 QTEST_MAIN(tst_qquicktext)
@@ -11,6 +11,7 @@
 #include <QtQuick/QQuickWindow>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlComponent>
+#include <QtQuick/private/qquickitem_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuick/private/qquickloader_p.h>
 #include <QtQuick/private/qquickmousearea_p.h>
@@ -22,6 +23,8 @@
 #include <private/qguiapplication_p.h>
 #include <QtGui/qpa/qplatformintegration.h>
 #include <QRunnable>
+#include <QScopeGuard>
+#include <QSGSimpleRectNode>
 #include <QSGRendererInterface>
 #include <QQuickRenderControl>
 #include <QOperatingSystemVersion>
@@ -304,6 +307,32 @@ protected:
     }
 };
 
+class ThreadSafeRectItem : public QQuickItem
+{
+public:
+    ThreadSafeRectItem(const QColor &color, QQuickItem *parent = nullptr)
+        : QQuickItem(parent), color(color)
+    {
+        setFlags(ItemHasContents | ItemHasThreadSafeUpdatePaintNode);
+    }
+
+    QColor color;
+    QAtomicInt updates;
+    QThread *updateThread = nullptr;
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override
+    {
+        updates.ref();
+        updateThread = QThread::currentThread();
+        auto *node = static_cast<QSGSimpleRectNode *>(oldNode);
+        if (!node)
+            return new QSGSimpleRectNode(boundingRect(), color);
+        node->setColor(color);
+        return node;
+    }
+};
+
 class PointerRecordingWindow : public QQuickWindow
 {
 public:
@@ -436,6 +465,7 @@ private slots:
     void constantUpdates();
     void constantUpdatesOnWindow_data();
     void constantUpdatesOnWindow();
+    void concurrentUpdatePaintNode();
     void mouseFiltering();
     void headless();
     void destroyShowWithoutHide();
@@ -1389,6 +1419,105 @@ void tst_qquickwindow::clearWindow()
     delete item;
 }
 
+void tst_qquickwindow::concurrentUpdatePaintNode()
+{
+    const int previousThreadCount = QQuickWindowPrivate::syncThreadCount();
+    auto restoreThreadCount = qScopeGuard([previousThreadCount] {
+        QQuickWindowPrivate::setSyncThreadCount(previousThreadCount);
+    });
+    QQuickWindowPrivate::setSyncThreadCount(4);
+
+    // 8 groups of 16 items on top of their parent's paint node, enough for 4 threads. The
+    // first item of each group is stacked below its parent and must stay hidden.
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.setColor(Qt::black);
+    window.resize(160, 80);
+    QList<ThreadSafeRectItem *> groups;
+    QList<ThreadSafeRectItem *> items;
+    for (int g = 0; g < 8; ++g) {
+        auto *group = new ThreadSafeRectItem(Qt::red, window.contentItem());
+        group->setPosition(QPointF((g % 4) * 40, (g / 4) * 40));
+        group->setSize(QSizeF(40, 40));
+        groups.append(group);
+        items.append(group);
+        for (int i = 0; i < 16; ++i) {
+            auto *item = new ThreadSafeRectItem(QColor(g * 16, i * 16, 255), group);
+            item->setPosition(QPointF((i % 4) * 10, (i / 4) * 10));
+            item->setSize(QSizeF(8, 8));
+            if (i == 0)
+                item->setZ(-1);
+            items.append(item);
+        }
+    }
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    const bool canGrab = QGuiApplication::platformName() != QLatin1String("offscreen")
+            && QGuiApplication::platformName() != QLatin1String("minimal");
+    auto verifyScene = [&](int updates) {
+        QSet<QThread *> threads;
+        for (ThreadSafeRectItem *item : std::as_const(items)) {
+            QTRY_COMPARE(item->updates.loadAcquire(), updates);
+            threads.insert(item->updateThread);
+            QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
+            auto *node = static_cast<QSGSimpleRectNode *>(itemPriv->paintNode);
+            QVERIFY(node);
+            QCOMPARE(node->color(), item->color);
+            QCOMPARE(node->parent(), itemPriv->childContainerNode());
+        }
+        // The render thread updates one partition, the pool the others
+        QVERIFY(threads.size() > 1);
+
+        // Children stacked below the paint node come first
+        for (ThreadSafeRectItem *group : std::as_const(groups)) {
+            QQuickItemPrivate *groupPriv = QQuickItemPrivate::get(group);
+            QList<QSGNode *> expected;
+            const QList<QQuickItem *> children = groupPriv->paintOrderChildItems();
+            for (QQuickItem *child : children) {
+                if (child->z() < 0)
+                    expected.append(QQuickItemPrivate::get(child)->itemNode());
+            }
+            expected.append(groupPriv->paintNode);
+            for (QQuickItem *child : children) {
+                if (child->z() >= 0)
+                    expected.append(QQuickItemPrivate::get(child)->itemNode());
+            }
+            QList<QSGNode *> actual;
+            for (QSGNode *n = groupPriv->childContainerNode()->firstChild(); n; n = n->nextSibling())
+                actual.append(n);
+            QCOMPARE(actual, expected);
+        }
+
+        // Nodes changed concurrently must all have been rendered
+        if (canGrab) {
+            const QImage content = window.grabWindow().convertToFormat(QImage::Format_RGB32);
+            const qreal dpr = content.devicePixelRatio();
+            for (ThreadSafeRectItem *group : std::as_const(groups)) {
+                const QList<QQuickItem *> children = group->childItems();
+                for (QQuickItem *child : children) {
+                    const QPointF center = child->mapToScene(QPointF(4, 4)) * dpr;
+                    const QColor expected = child->z() < 0
+                            ? group->color : static_cast<ThreadSafeRectItem *>(child)->color;
+                    QCOMPARE(content.pixelColor(center.toPoint()), expected);
+                }
+            }
+        }
+    };
+
+    verifyScene(1);
+    if (QTest::currentTestFailed())
+        return;
+
+    // Updating the existing nodes marks their materials dirty from the workers
+    for (ThreadSafeRectItem *item : std::as_const(items)) {
+        item->color = QColor(item->color.blue(), item->color.green(), item->color.red());
+        item->update();
+    }
+    verifyScene(2);
+}
+
 void tst_qquickwindow::mouseFiltering()
 {
     TestTouchItem::clearMouseEventCounters();
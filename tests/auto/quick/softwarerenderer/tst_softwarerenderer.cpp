@@ -5,6 +5,11 @@
 #include <QtQml>
 #include <QGuiApplication>
 
+#include <private/qquickitem_p.h>
+#include <private/qquickwindow_p.h>
+#include <private/qsgabstractsoftwarerenderer_p.h>
+#include <private/qsgadaptationlayer_p.h>
+#include <private/qsgcontext_p.h>
 #include <private/qsgrenderloop_p.h>
 
 #include <QtQuickTestUtils/private/qmlutils_p.h>
@@ -22,8 +27,179 @@ private slots:
     void initTestCase() override;
 
     void renderTarget();
+    void concurrentPainting();
+    void rasterCache();
 };
 
+// Renders a scene into an image with QQuickRenderControl. The image is kept between frames, so
+// that later frames only repaint what has changed.
+class OffscreenScene
+{
+public:
+    explicit OffscreenScene(const QByteArray &qml)
+        : window(new QQuickWindow(&renderControl))
+    {
+        window->setWidth(256);
+        window->setHeight(256);
+        window->setColor(Qt::white);
+
+        target = QImage(window->size(), QImage::Format_ARGB32_Premultiplied);
+        target.fill(Qt::transparent);
+        auto renderTarget = QQuickRenderTarget::fromPaintDevice(&target);
+        renderTarget.setDevicePixelRatio(target.devicePixelRatio());
+        window->setRenderTarget(renderTarget);
+
+        QQmlComponent component(&engine);
+        component.setData(qml, QUrl());
+        root.reset(qobject_cast<QQuickItem *>(component.create()));
+        if (root)
+            root->setParentItem(window->contentItem());
+        else
+            errorString = component.errorString();
+    }
+
+    QQuickItem *item(const char *objectName) const
+    {
+        return root->findChild<QQuickItem *>(QLatin1String(objectName));
+    }
+
+    bool hasRasterCache(QQuickItem *item) const
+    {
+        auto *renderer = static_cast<QSGAbstractSoftwareRenderer *>(
+                QQuickWindowPrivate::get(window.get())->renderer);
+        QSGSoftwareRenderableNode *node
+                = renderer->renderableNode(QQuickItemPrivate::get(item)->paintNode);
+        return node && node->hasRasterCache();
+    }
+
+    QImage render()
+    {
+        if (renderThreads > 0)
+            QSGAbstractSoftwareRenderer::setRenderThreadCount(renderThreads);
+
+        renderControl.polishItems();
+        renderControl.beginFrame();
+        renderControl.sync();
+        renderControl.render();
+        renderControl.endFrame();
+        return target.copy();
+    }
+
+    QQmlEngine engine;
+    QQuickRenderControl renderControl;
+    std::unique_ptr<QQuickWindow> window;
+    std::unique_ptr<QQuickItem> root;
+    QImage target;
+    QString errorString;
+    int renderThreads = 0; // leaves the thread count alone
+};
+
+// Keeps a single glyph node and updates it in place, whereas Text creates new nodes whenever
+// its text or color changes.
+class GlyphItem : public QQuickItem
+{
+public:
+    GlyphItem(QQuickItem *parent) : QQuickItem(parent)
+    {
+        setFlag(ItemHasContents);
+        setSize(QSizeF(100, 30));
+        m_font.setPixelSize(22);
+    }
+
+    void setText(const QString &text)
+    {
+        m_text = text;
+        m_glyphsChanged = true;
+        update();
+    }
+
+    void setColor(const QColor &color)
+    {
+        m_color = color;
+        m_colorChanged = true;
+        update();
+    }
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override
+    {
+        auto *node = static_cast<QSGGlyphNode *>(oldNode);
+        if (!node) {
+            QSGRenderContext *rc = QQuickItemPrivate::get(this)->sceneGraphRenderContext();
+            node = rc->sceneGraphContext()->createGlyphNode(rc, QSGTextNode::QtRendering, 0);
+            m_glyphsChanged = m_colorChanged = true;
+        }
+
+        if (m_glyphsChanged) {
+            QTextLayout layout(m_text, m_font);
+            layout.beginLayout();
+            layout.createLine();
+            layout.endLayout();
+            node->setGlyphs(QPointF(), layout.glyphRuns().constFirst());
+            m_glyphsChanged = false;
+        }
+
+        if (m_colorChanged) {
+            node->setColor(m_color);
+            m_colorChanged = false;
+        }
+
+        node->update();
+        return node;
+    }
+
+private:
+    QString m_text = QStringLiteral("Glyphs");
+    QFont m_font;
+    QColor m_color = Qt::black;
+    bool m_glyphsChanged = true;
+    bool m_colorChanged = true;
+};
+
+static const QByteArray sceneQml = R"(
+import QtQuick
+
+Item {
+    width: 256
+    height: 256
+
+    Rectangle {
+        objectName: "rounded"
+        x: 10; y: 12; width: 110; height: 80
+        radius: 14
+        border.width: 3
+        border.color: "navy"
+        gradient: Gradient {
+            GradientStop { position: 0; color: "orange" }
+            GradientStop { position: 1; color: "purple" }
+        }
+    }
+
+    Rectangle {
+        objectName: "rotated"
+        x: 120; y: 60; width: 90; height: 120
+        rotation: 17
+        radius: 6
+        color: "#8040a0c0"
+    }
+
+    Text {
+        objectName: "label"
+        x: 16; y: 150
+        text: "Bands of scanlines"
+        font.pixelSize: 22
+        color: "darkgreen"
+    }
+
+    Rectangle {
+        objectName: "bar"
+        x: 30; y: 200; width: 180; height: 40
+        color: "teal"
+        opacity: 0.7
+    }
+}
+)";
+
 tst_SoftwareRenderer::tst_SoftwareRenderer()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -93,6 +269,179 @@ void tst_SoftwareRenderer::renderTarget()
              qPrintable(errorMessage));
 }
 
+void tst_SoftwareRenderer::concurrentPainting()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    // QSG_SOFTWARE_RENDER_THREADS is only read once per process, so set the thread count
+    // directly, and restore it when done.
+    const int renderThreadCount = QSGAbstractSoftwareRenderer::renderThreadCount();
+    const auto restoreRenderThreadCount = qScopeGuard([renderThreadCount]() {
+        QSGAbstractSoftwareRenderer::setRenderThreadCount(renderThreadCount);
+    });
+
+    QLoggingCategory::setFilterRules(
+            QStringLiteral("qt.scenegraph.softwarecontext.abstractrenderer.debug=true"));
+    const auto restoreFilterRules = qScopeGuard([]() {
+        QLoggingCategory::setFilterRules(QString());
+    });
+
+    OffscreenScene serial(sceneQml);
+    QVERIFY2(serial.root, qPrintable(serial.errorString));
+    serial.renderThreads = 1;
+    OffscreenScene concurrent(sceneQml);
+    QVERIFY2(concurrent.root, qPrintable(concurrent.errorString));
+    concurrent.renderThreads = 4;
+
+    const auto change = [&](const char *objectName, const char *property, const QVariant &value) {
+        QVERIFY(serial.item(objectName)->setProperty(property, value));
+        QVERIFY(concurrent.item(objectName)->setProperty(property, value));
+    };
+
+    // The first frame paints the whole window, in four bands
+    const QRegularExpression fourBands(QStringLiteral("^Painted \\d+ nodes in 4 bands$"));
+    QTest::ignoreMessage(QtDebugMsg, fourBands);
+    QCOMPARE(concurrent.render(), serial.render());
+
+    // Partial updates
+    change("bar", "y", 20);
+    QCOMPARE(concurrent.render(), serial.render());
+
+    change("label", "text", QStringLiteral("Painted concurrently"));
+    QCOMPARE(concurrent.render(), serial.render());
+
+    change("rotated", "rotation", 33);
+    change("rounded", "radius", 30);
+    QCOMPARE(concurrent.render(), serial.render());
+
+    // Everything again, on top of the previous frames
+    serial.window->setColor(Qt::lightGray);
+    concurrent.window->setColor(Qt::lightGray);
+    QTest::ignoreMessage(QtDebugMsg, fourBands);
+    QCOMPARE(concurrent.render(), serial.render());
+}
+
+void tst_SoftwareRenderer::rasterCache()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    QLoggingCategory::setFilterRules(
+            QStringLiteral("qt.scenegraph.softwarecontext.abstractrenderer.debug=true"));
+    const auto restoreFilterRules = qScopeGuard([]() {
+        QLoggingCategory::setFilterRules(QString());
+    });
+
+    OffscreenScene uncached(sceneQml);
+    QVERIFY2(uncached.root, qPrintable(uncached.errorString));
+    OffscreenScene cached(sceneQml);
+    QVERIFY2(cached.root, qPrintable(cached.errorString));
+
+    GlyphItem *uncachedGlyphs = new GlyphItem(uncached.root.get());
+    GlyphItem *cachedGlyphs = new GlyphItem(cached.root.get());
+    uncachedGlyphs->setPosition(QPointF(8, 100));
+    cachedGlyphs->setPosition(QPointF(8, 100));
+
+    QImage previous;
+    QString errorMessage;
+    const auto compareFrames = [&]() {
+        const QImage expected = uncached.render();
+        previous = cached.render();
+        return QQuickVisualTestUtils::compareImages(previous, expected, &errorMessage);
+    };
+
+    // Changing the background color repaints all nodes
+    bool lightBackground = false;
+    const auto repaintAll = [&]() {
+        lightBackground = !lightBackground;
+        const QColor color = lightBackground ? QColor(Qt::lightGray) : QColor(Qt::white);
+        uncached.window->setColor(color);
+        cached.window->setColor(color);
+        return compareFrames();
+    };
+
+    const auto change = [&](const char *objectName, const char *property, const QVariant &value) {
+        QVERIFY(uncached.item(objectName)->setProperty(property, value));
+        QVERIFY(cached.item(objectName)->setProperty(property, value));
+    };
+
+    QQuickItem *rounded = cached.item("rounded");
+    QVERIFY(rounded);
+
+    {
+        // The budget is read when the renderer is created, on the first frame.
+        const QByteArray budget = qgetenv("QSG_SOFTWARE_RASTER_CACHE");
+        qputenv("QSG_SOFTWARE_RASTER_CACHE", "16");
+        const auto restoreBudget = qScopeGuard([&budget]() {
+            if (budget.isNull())
+                qunsetenv("QSG_SOFTWARE_RASTER_CACHE");
+            else
+                qputenv("QSG_SOFTWARE_RASTER_CACHE", budget);
+        });
+        QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    }
+    QVERIFY(!cached.hasRasterCache(rounded));
+
+    // Nodes are rasterized when painted a second time, and blitted from then on
+    QTest::ignoreMessage(QtDebugMsg, QRegularExpression(QStringLiteral("^Rasterized \\d+ nodes")));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+    QVERIFY(cached.hasRasterCache(rounded));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+
+    // Moving by whole pixels keeps the cache
+    change("rounded", "x", 15);
+    QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    QVERIFY(cached.hasRasterCache(rounded));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+
+    // Geometry changes drop it
+    change("rounded", "width", 130);
+    QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    QVERIFY(!cached.hasRasterCache(rounded));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+    QVERIFY(cached.hasRasterCache(rounded));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+
+    // So do material changes
+    QVERIFY(uncached.item("rounded")->property("border").value<QObject *>()->setProperty(
+            "color", QColor(Qt::red)));
+    QVERIFY(rounded->property("border").value<QObject *>()->setProperty(
+            "color", QColor(Qt::red)));
+    QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    QVERIFY(!cached.hasRasterCache(rounded));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+
+    // Glyph nodes mark themselves dirty when changed in place
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+    QVERIFY(cached.hasRasterCache(cachedGlyphs));
+    QImage before = previous;
+    uncachedGlyphs->setColor(Qt::blue);
+    cachedGlyphs->setColor(Qt::blue);
+    QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    QVERIFY(previous != before);
+    QVERIFY(!cached.hasRasterCache(cachedGlyphs));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+
+    before = previous;
+    uncachedGlyphs->setText(QStringLiteral("Changed"));
+    cachedGlyphs->setText(QStringLiteral("Changed"));
+    QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    QVERIFY(previous != before);
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+
+    // Removed nodes leave nothing behind
+    delete uncached.item("label");
+    delete cached.item("label");
+    delete uncachedGlyphs;
+    delete cachedGlyphs;
+    QVERIFY2(compareFrames(), qPrintable(errorMessage));
+    QVERIFY2(repaintAll(), qPrintable(errorMessage));
+}
+
 #include "tst_softwarerenderer.moc"
 
 QTEST_MAIN(tst_SoftwareRenderer)
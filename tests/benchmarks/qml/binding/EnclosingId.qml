@@ -0,0 +1,14 @@
+pragma ComponentBehavior: Bound
+import QtQml
+
+Value {
+    id: root
+
+    property Component inner: Component {
+        QtObject {
+            property int result: root.value + root.value + 10
+        }
+    }
+
+    property QtObject object: inner.createObject(root)
+}
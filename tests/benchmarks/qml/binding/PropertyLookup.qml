@@ -0,0 +1,14 @@
+import QtQml
+
+Value {
+    id: root
+
+    property Component inner: Component {
+        QtObject {
+            property Value outer
+            property int result: outer ? outer.value + outer.value + 10 : 0
+        }
+    }
+
+    property QtObject object: inner.createObject(root, { outer: root })
+}
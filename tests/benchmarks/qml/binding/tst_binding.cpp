@@ -28,6 +28,8 @@ private slots:
     void basicproperty();
     void creation_data();
     void creation();
+    void enclosingid_data();
+    void enclosingid();
 
 private:
     QQmlEngine engine;
@@ -150,5 +152,47 @@ void tst_binding::creation()
     }
 }
 
+void tst_binding::enclosingid_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<bool>("compileAtRunTime");
+
+    // The id of an enclosing component, resolved by the AOT compiler
+    QTest::newRow("aot direct") << ":/qt/qml/BindingBenchmark/EnclosingId.qml" << false;
+    // The same object passed in a property, going through the generic property lookups
+    QTest::newRow("aot lookup") << ":/qt/qml/BindingBenchmark/PropertyLookup.qml" << false;
+    // The same document as "aot direct", compiled to byte code
+    QTest::newRow("bytecode") << ":/qt/qml/BindingBenchmark/EnclosingId.qml" << true;
+}
+
+void tst_binding::enclosingid()
+{
+    QFETCH(QString, file);
+    QFETCH(bool, compileAtRunTime);
+
+    QQmlComponent c(&engine);
+    if (compileAtRunTime) {
+        QFile f(file);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        // A URL different from the one of the AOT compiled document, in the same module
+        c.setData(f.readAll(), QUrl("qrc:/qt/qml/BindingBenchmark/EnclosingIdAtRunTime.qml"));
+    } else {
+        c.loadUrl(QUrl("qrc" + file));
+    }
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+
+    QScopedPointer<QObject> root(c.create());
+    QVERIFY(root);
+    QObject *object = root->property("object").value<QObject *>();
+    QVERIFY(object);
+    root->setProperty("value", 5);
+    QCOMPARE(object->property("result").toInt(), 20);
+
+    QBENCHMARK {
+        root->setProperty("value", 1);
+        root->setProperty("value", 2);
+    }
+}
+
 QTEST_MAIN(tst_binding)
 #include "tst_binding.moc"
@@ -9,10 +9,15 @@
 #include <QtQml/private/qqmljsmemorypool_p.h>
 #include <QtQml/private/qqmljsparser_p.h>
 #include <QtQml/private/qqmljslexer_p.h>
+#include <QtQml/private/qv4executablecompilationunit_p.h>
 
 #include <QFile>
 #include <QDebug>
+#include <QDir>
+#include <QScopeGuard>
+#include <QTemporaryDir>
 #include <QTextStream>
+#include <QThread>
 
 class tst_compilation : public QObject
 {
@@ -29,6 +34,9 @@ private slots:
     void bigimport_data();
     void bigimport();
 
+    void concurrentCompilation_data();
+    void concurrentCompilation();
+
 private:
     QQmlEngine engine;
 };
@@ -161,6 +169,91 @@ void tst_compilation::bigimport()
     }
 }
 
+void tst_compilation::concurrentCompilation_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("sequential") << 0;
+    for (int threads = 1; threads < QThread::idealThreadCount(); threads *= 2)
+        QTest::addRow("%d threads", threads) << threads;
+    QTest::addRow("%d threads", QThread::idealThreadCount()) << QThread::idealThreadCount();
+}
+
+void tst_compilation::concurrentCompilation()
+{
+    QFETCH(int, threads);
+
+    const int typeCount = 64;
+    const int functionCount = 50;
+
+    QTemporaryDir d;
+    QVERIFY(d.isValid());
+
+    QString p;
+    {
+        for (int i = 0; i < typeCount; ++i) {
+            QFile f(d.filePath(QString::fromLatin1("Type%1.qml").arg(i)));
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write("import QtQml\n");
+            f.write("QtObject {\n");
+            f.write("    property int value: 0\n");
+            for (int j = 0; j < functionCount; ++j) {
+                f.write(qPrintable(QString::fromLatin1(
+                        "    property int p%1: value + %1\n"
+                        "    function f%1(a, b) {\n"
+                        "        let result = [];\n"
+                        "        for (let i = 0; i < a; ++i)\n"
+                        "            result.push({ key: i, value: b * i + p%1 });\n"
+                        "        return result.filter(e => e.value % 2).map(e => e.key);\n"
+                        "    }\n").arg(j)));
+            }
+            f.write("}\n");
+        }
+
+        QFile main(d.filePath("main.qml"));
+        QVERIFY(main.open(QIODevice::WriteOnly));
+        p = QFileInfo(main).absoluteFilePath();
+
+        main.write("import QtQml\n");
+        main.write("QtObject {\n");
+        for (int i = 0; i < typeCount; ++i)
+            main.write(qPrintable(QString::fromLatin1("    property QtObject t%1: Type%1 {}\n").arg(i)));
+        main.write("}");
+    }
+
+    // Read by each new engine's type loader.
+    const QByteArray oldCompilationThreads = qgetenv("QML_COMPILATION_THREADS");
+    qputenv("QML_COMPILATION_THREADS", QByteArray::number(threads));
+    const auto restoreCompilationThreads = qScopeGuard([&]() {
+        if (oldCompilationThreads.isNull())
+            qunsetenv("QML_COMPILATION_THREADS");
+        else
+            qputenv("QML_COMPILATION_THREADS", oldCompilationThreads);
+    });
+
+    // QML_DISABLE_DISK_CACHE is read only once per process, and would affect the other tests.
+    // Remove the cache files written by the previous iteration instead, so that every
+    // iteration compiles the sources.
+    QStringList cacheFiles;
+    const QDir dir(d.path());
+    for (const QString &file : dir.entryList({ QStringLiteral("*.qml") })) {
+        cacheFiles.append(QV4::ExecutableCompilationUnit::localCacheFilePath(
+                QUrl::fromLocalFile(dir.filePath(file))));
+    }
+
+    QBENCHMARK {
+        for (const QString &cacheFile : std::as_const(cacheFiles))
+            QFile::remove(cacheFile);
+
+        QQmlEngine e;
+        QQmlComponent c(&e, p);
+        QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    }
+
+    for (const QString &cacheFile : std::as_const(cacheFiles))
+        QFile::remove(cacheFile);
+}
+
 QTEST_MAIN(tst_compilation)
 
 #include "tst_compilation.moc"
@@ -0,0 +1,206 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQml/qjsengine.h>
+#include <QtQml/qjsvalue.h>
+#include <QtQml/private/qjsvalue_p.h>
+#include <QtQml/private/qv4engine_p.h>
+#include <QtQml/private/qv4identifiertable_p.h>
+#include <QtQml/private/qv4object_p.h>
+
+class tst_InternalClass : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void find_data();
+    void find();
+
+    void objectLiteral_data();
+    void objectLiteral();
+
+    void addProperties_data();
+    void addProperties();
+
+    void jsonParse_data();
+    void jsonParse();
+
+    void computedPropertyAccess_data();
+    void computedPropertyAccess();
+
+private:
+    void addPropertyCounts();
+};
+
+static QString propertyName(int i)
+{
+    return QStringLiteral("property%1").arg(i);
+}
+
+static QString objectLiteral(int propertyCount)
+{
+    QString literal = QStringLiteral("({");
+    for (int i = 0; i < propertyCount; ++i)
+        literal += propertyName(i) + QLatin1String(": ") + QString::number(i) + QLatin1Char(',');
+    literal += QStringLiteral("})");
+    return literal;
+}
+
+void tst_InternalClass::addPropertyCounts()
+{
+    QTest::addColumn<int>("propertyCount");
+
+    QTest::newRow("4") << 4;
+    QTest::newRow("16") << 16;
+    QTest::newRow("64") << 64;
+    QTest::newRow("256") << 256;
+    QTest::newRow("1024") << 1024;
+}
+
+void tst_InternalClass::find_data()
+{
+    addPropertyCounts();
+}
+
+// Lookups in the property hash alone, without the lookup caches of generated code.
+void tst_InternalClass::find()
+{
+    QFETCH(int, propertyCount);
+
+    QJSEngine engine;
+    QV4::ExecutionEngine *v4 = engine.handle();
+    QJSValue value = engine.evaluate(objectLiteral(propertyCount));
+    QVERIFY(value.isObject());
+
+    QV4::Scope scope(v4);
+    QV4::ScopedObject object(scope, QJSValuePrivate::asManagedType<QV4::Object>(&value));
+    QVERIFY(object);
+
+    QList<QV4::PropertyKey> keys;
+    for (int i = 0; i < propertyCount; ++i)
+        keys.append(v4->identifierTable->asPropertyKey(propertyName(i)));
+    // Keys that are not in the object
+    for (int i = 0; i < propertyCount; ++i)
+        keys.append(v4->identifierTable->asPropertyKey(propertyName(i) + QLatin1String("x")));
+
+    QBENCHMARK {
+        uint found = 0;
+        for (const QV4::PropertyKey &key : std::as_const(keys))
+            found += object->internalClass()->find(key).isValid();
+        QCOMPARE(found, uint(propertyCount));
+    }
+}
+
+void tst_InternalClass::objectLiteral_data()
+{
+    addPropertyCounts();
+}
+
+void tst_InternalClass::objectLiteral()
+{
+    QFETCH(int, propertyCount);
+
+    QJSEngine engine;
+    QJSValue create = engine.evaluate(
+            QStringLiteral("(function() { return %1; })").arg(objectLiteral(propertyCount)));
+    QVERIFY(create.isCallable());
+
+    QBENCHMARK {
+        QJSValue result = create.call();
+        QVERIFY(result.isObject());
+    }
+}
+
+void tst_InternalClass::addProperties_data()
+{
+    addPropertyCounts();
+}
+
+// Each iteration uses new property names, so that no transition can be reused.
+void tst_InternalClass::addProperties()
+{
+    QFETCH(int, propertyCount);
+
+    QJSEngine engine;
+    QJSValue create = engine.evaluate(QStringLiteral(
+            "(function(count, generation) {\n"
+            "    let o = {};\n"
+            "    for (let i = 0; i < count; ++i)\n"
+            "        o['g' + generation + 'p' + i] = i;\n"
+            "    return o;\n"
+            "})"));
+    QVERIFY(create.isCallable());
+
+    int generation = 0;
+    QBENCHMARK {
+        QJSValue result = create.call({ propertyCount, ++generation });
+        QVERIFY(result.isObject());
+    }
+}
+
+void tst_InternalClass::jsonParse_data()
+{
+    addPropertyCounts();
+}
+
+void tst_InternalClass::jsonParse()
+{
+    QFETCH(int, propertyCount);
+
+    QString json = QStringLiteral("[");
+    for (int element = 0; element < 16; ++element) {
+        json += QLatin1Char('{');
+        for (int i = 0; i < propertyCount; ++i) {
+            json += QLatin1Char('"') + propertyName(i) + QLatin1String("\":") + QString::number(i);
+            if (i + 1 < propertyCount)
+                json += QLatin1Char(',');
+        }
+        json += QLatin1Char('}');
+        if (element + 1 < 16)
+            json += QLatin1Char(',');
+    }
+    json += QLatin1Char(']');
+
+    QJSEngine engine;
+    QJSValue parse = engine.evaluate(QStringLiteral("(function(json) { return JSON.parse(json); })"));
+    QVERIFY(parse.isCallable());
+
+    QBENCHMARK {
+        QJSValue result = parse.call({ json });
+        QVERIFY(result.isArray());
+    }
+}
+
+void tst_InternalClass::computedPropertyAccess_data()
+{
+    addPropertyCounts();
+}
+
+void tst_InternalClass::computedPropertyAccess()
+{
+    QFETCH(int, propertyCount);
+
+    QJSEngine engine;
+    engine.globalObject().setProperty(QStringLiteral("o"), engine.evaluate(objectLiteral(propertyCount)));
+    QJSValue sum = engine.evaluate(QStringLiteral(
+            "(function() {\n"
+            "    let keys = Object.keys(o);\n"
+            "    return function() {\n"
+            "        let sum = 0;\n"
+            "        for (let i = 0; i < keys.length; ++i)\n"
+            "            sum += o[keys[i]];\n"
+            "        return sum;\n"
+            "    };\n"
+            "})()"));
+    QVERIFY(sum.isCallable());
+
+    const int expected = propertyCount * (propertyCount - 1) / 2;
+    QBENCHMARK {
+        QCOMPARE(sum.call().toInt(), expected);
+    }
+}
+
+QTEST_MAIN(tst_InternalClass)
+
+#include "tst_internalclass.moc"
@@ -0,0 +1,145 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/QThread>
+#include <QtQuick/QSGFlatColorMaterial>
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/private/qsgbatchrenderer_p.h>
+#include <QtQuick/private/qsgdefaultrendercontext_p.h>
+#include <QtQuick/private/qsgrenderloop_p.h>
+#include <rhi/qrhi.h>
+
+// Measures how long the batch renderer takes to prepare a frame in which all
+// the geometry of one large merged batch has changed. The null backend does
+// not draw anything, so the time is spent merging the geometry into the buffers.
+class tst_mergedupload : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanupTestCase();
+    void prepareFrame_data();
+    void prepareFrame();
+};
+
+void tst_mergedupload::cleanupTestCase()
+{
+    qunsetenv("QSG_RENDERER_UPLOAD_THREADS");
+}
+
+void tst_mergedupload::prepareFrame_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("drawingMode");
+
+    const QList<std::pair<const char *, int>> threadCounts = {
+        { "serial", 1 }, { "2 threads", 2 }, { "4 threads", 4 },
+        { "ideal thread count", QThread::idealThreadCount() }
+    };
+    for (const auto &[name, threads] : threadCounts) {
+        QTest::addRow("triangles, %s", name) << threads << int(QSGGeometry::DrawTriangles);
+        QTest::addRow("triangle strips, %s", name) << threads << int(QSGGeometry::DrawTriangleStrip);
+    }
+}
+
+void tst_mergedupload::prepareFrame()
+{
+    QFETCH(int, threads);
+    QFETCH(int, drawingMode);
+
+    // Read when the renderer is created
+    qputenv("QSG_RENDERER_UPLOAD_THREADS", QByteArray::number(threads));
+
+    QRhiNullInitParams params;
+    QScopedPointer<QRhi> rhi(QRhi::create(QRhi::Null, &params));
+    QVERIFY(rhi);
+    QSGRenderLoop *renderLoop = QSGRenderLoop::instance();
+    QScopedPointer<QSGDefaultRenderContext> renderContext(static_cast<QSGDefaultRenderContext *>(
+            renderLoop->createRenderContext(renderLoop->sceneGraphContext())));
+    QSGDefaultRenderContext::InitParams rcParams;
+    rcParams.rhi = rhi.data();
+    rcParams.initialSurfacePixelSize = QSize(512, 512);
+    renderContext->initialize(&rcParams);
+    QVERIFY(renderContext->isValid());
+
+    // 200000 vertices in one batch, which is split into four draw sets
+    const int nodeCount = 5000;
+    const int verticesPerNode = 40;
+    const bool strip = drawingMode == QSGGeometry::DrawTriangleStrip;
+    const int indexCount = strip ? verticesPerNode : (verticesPerNode - 2) * 3;
+
+    QSGFlatColorMaterial material;
+    material.setColor(Qt::darkCyan);
+    QSGRootNode root;
+    QList<QSGGeometryNode *> nodes;
+    for (int n = 0; n < nodeCount; ++n) {
+        auto *transform = new QSGTransformNode;
+        QMatrix4x4 matrix;
+        matrix.translate(n % 100 * 10, n / 100 * 10);
+        transform->setMatrix(matrix);
+        root.appendChildNode(transform);
+
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),
+                                         verticesPerNode, indexCount);
+        geometry->setDrawingMode(QSGGeometry::DrawingMode(drawingMode));
+        QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+        for (int i = 0; i < verticesPerNode; ++i)
+            vertices[i].set(i / 2 * 0.25f, i % 2 * 5.0f);
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int i = 0; i < indexCount; ++i)
+            indices[i] = strip ? i : i / 3 + i % 3;
+
+        auto *node = new QSGGeometryNode;
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(&material);
+        transform->appendChildNode(node);
+        nodes.append(node);
+    }
+
+    const QSize size(64, 64);
+    QScopedPointer<QRhiTexture> texture(rhi->newTexture(QRhiTexture::RGBA8, size, 1,
+                                                        QRhiTexture::RenderTarget));
+    QVERIFY(texture->create());
+    QScopedPointer<QRhiRenderBuffer> ds(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, size));
+    QVERIFY(ds->create());
+    QRhiTextureRenderTargetDescription rtDesc(QRhiColorAttachment(texture.data()));
+    rtDesc.setDepthStencilBuffer(ds.data());
+    QScopedPointer<QRhiTextureRenderTarget> rt(rhi->newTextureRenderTarget(rtDesc));
+    QScopedPointer<QRhiRenderPassDescriptor> rp(rt->newCompatibleRenderPassDescriptor());
+    rt->setRenderPassDescriptor(rp.data());
+    QVERIFY(rt->create());
+
+    {
+        QSGBatchRenderer::Renderer renderer(renderContext.data());
+        renderer.setRootNode(&root);
+
+        const auto renderFrame = [&]() {
+            QRhiCommandBuffer *cb = nullptr;
+            rhi->beginOffscreenFrame(&cb);
+            renderContext->beginNextFrame(&renderer, QSGRenderTarget(rt.data(), rp.data(), cb),
+                                          nullptr, nullptr, nullptr);
+            renderer.setDeviceRect(size);
+            renderer.setViewportRect(size);
+            renderer.setProjectionMatrixToRect(QRectF(0, 0, 1000, 500));
+            renderContext->renderNextFrame(&renderer);
+            renderContext->endNextFrame(&renderer);
+            rhi->endOffscreenFrame();
+        };
+
+        // Builds the batches, so that the benchmark only measures the uploads
+        renderFrame();
+
+        QBENCHMARK {
+            for (QSGGeometryNode *node : std::as_const(nodes))
+                node->markDirty(QSGNode::DirtyGeometry);
+            renderFrame();
+        }
+    }
+
+    renderContext->invalidate();
+}
+
+QTEST_MAIN(tst_mergedupload)
+#include "tst_mergedupload.moc"
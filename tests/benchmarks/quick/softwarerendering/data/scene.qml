@@ -0,0 +1,42 @@
+import QtQuick
+
+Rectangle {
+    id: root
+    width: 1280
+    height: 800
+    color: "white"
+
+    // Changing the frame repaints the whole window
+    property int frame
+
+    Grid {
+        anchors.fill: parent
+        columns: 20
+
+        Repeater {
+            model: 400
+
+            Rectangle {
+                required property int index
+                width: root.width / 20
+                height: root.height / 20
+                radius: 8
+                border.width: 2
+                border.color: "black"
+                rotation: (index + root.frame) % 7 - 3
+                gradient: Gradient {
+                    GradientStop {
+                        position: 0
+                        color: Qt.hsla(((index + root.frame) % 100) / 100, 0.6, 0.5, 1)
+                    }
+                    GradientStop { position: 1; color: "white" }
+                }
+
+                Text {
+                    anchors.centerIn: parent
+                    text: index + root.frame
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/QThread>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QSGRendererInterface>
+#include <QtQuick/private/qsgabstractsoftwarerenderer_p.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+class tst_softwarerendering : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_softwarerendering();
+
+private slots:
+    void initTestCase() override;
+    void cleanupTestCase();
+    void fullUpdate_data();
+    void fullUpdate();
+};
+
+tst_softwarerendering::tst_softwarerendering()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_softwarerendering::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+}
+
+void tst_softwarerendering::cleanupTestCase()
+{
+    QSGAbstractSoftwareRenderer::setRenderThreadCount(1);
+}
+
+void tst_softwarerendering::fullUpdate_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("ideal thread count") << QThread::idealThreadCount();
+}
+
+void tst_softwarerendering::fullUpdate()
+{
+    QFETCH(int, threads);
+    QSGAbstractSoftwareRenderer::setRenderThreadCount(threads);
+
+    QQuickView view;
+    view.setSource(testFileUrl("scene.qml"));
+    QVERIFY(view.rootObject());
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QObject *root = view.rootObject();
+    int frame = 0;
+    QBENCHMARK {
+        root->setProperty("frame", ++frame);
+        const QImage image = view.grabWindow();
+        QVERIFY(!image.isNull());
+    }
+}
+
+QTEST_MAIN(tst_softwarerendering)
+#include "tst_softwarerendering.moc"
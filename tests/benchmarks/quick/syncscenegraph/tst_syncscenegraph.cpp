@@ -0,0 +1,123 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/QThread>
+#include <QtCore/qmath.h>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/QSGFlatColorMaterial>
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/private/qquickwindow_p.h>
+
+// Draws a line chart whose geometry is recomputed whenever the phase changes.
+class Sparkline : public QQuickItem
+{
+public:
+    enum { PointCount = 64 };
+
+    Sparkline(QQuickItem *parent)
+        : QQuickItem(parent)
+    {
+        setFlags(ItemHasContents | ItemHasThreadSafeUpdatePaintNode);
+    }
+
+    void setPhase(int phase)
+    {
+        m_phase = phase;
+        update();
+    }
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override
+    {
+        auto *node = static_cast<QSGGeometryNode *>(oldNode);
+        if (!node) {
+            node = new QSGGeometryNode;
+            auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), PointCount);
+            geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+            node->setGeometry(geometry);
+            node->setFlag(QSGNode::OwnsGeometry);
+            auto *material = new QSGFlatColorMaterial;
+            material->setColor(Qt::darkGreen);
+            node->setMaterial(material);
+            node->setFlag(QSGNode::OwnsMaterial);
+        }
+
+        QSGGeometry::Point2D *points = node->geometry()->vertexDataAsPoint2D();
+        for (int i = 0; i < PointCount; ++i) {
+            const qreal value = qSin((m_phase + i) * 0.2) * qCos((m_phase + i) * 0.05);
+            points[i].set(width() * i / (PointCount - 1), height() * (0.5 + 0.5 * value));
+        }
+        node->markDirty(QSGNode::DirtyGeometry);
+        return node;
+    }
+
+private:
+    int m_phase = 0;
+};
+
+class tst_syncscenegraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanupTestCase();
+    void updatePaintNodes_data();
+    void updatePaintNodes();
+};
+
+void tst_syncscenegraph::cleanupTestCase()
+{
+    QQuickWindowPrivate::setSyncThreadCount(1);
+}
+
+void tst_syncscenegraph::updatePaintNodes_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("ideal thread count") << QThread::idealThreadCount();
+}
+
+void tst_syncscenegraph::updatePaintNodes()
+{
+    QFETCH(int, threads);
+    QQuickWindowPrivate::setSyncThreadCount(threads);
+
+    const int rows = 100;
+    const int columns = 200;
+
+    QQuickWindow window;
+    window.resize(columns * 5, rows * 5);
+
+    QList<Sparkline *> items;
+    for (int row = 0; row < rows; ++row) {
+        auto *rowItem = new QQuickItem(window.contentItem());
+        rowItem->setPosition(QPointF(0, row * 5));
+        rowItem->setSize(QSizeF(columns * 5, 5));
+        for (int column = 0; column < columns; ++column) {
+            auto *item = new Sparkline(rowItem);
+            item->setPosition(QPointF(column * 5, 0));
+            item->setSize(QSizeF(5, 5));
+            items.append(item);
+        }
+    }
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    int frame = 0;
+    QBENCHMARK {
+        ++frame;
+        for (Sparkline *item : std::as_const(items))
+            item->setPhase(frame);
+        const QImage image = window.grabWindow();
+        QVERIFY(!image.isNull());
+    }
+}
+
+QTEST_MAIN(tst_syncscenegraph)
+#include "tst_syncscenegraph.moc"
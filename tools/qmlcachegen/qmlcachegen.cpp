@@ -19,6 +19,7 @@
 #include <private/qqmljslexer_p.h>
 #include <private/qqmljsresourcefilemapper_p.h>
 #include <private/qqmljsloadergenerator_p.h>
+#include <private/qqmljsbundlegenerator_p.h>
 #include <private/qqmljscompiler_p.h>
 #include <private/qresourcerelocater_p.h>
 
@@ -80,6 +81,8 @@ int main(int argc, char **argv)
     parser.addOption(resourcePathOption);
     QCommandLineOption resourceNameOption("resource-name"_L1, QCoreApplication::translate("main", "Required to generate qmlcache_loader without qrc files. This is the name of the Qt resource the input files belong to."), QCoreApplication::translate("main", "compiled-file-list"));
     parser.addOption(resourceNameOption);
+    QCommandLineOption bundleOption("bundle"_L1, QCoreApplication::translate("main", "Combine the given compiled files into one bundle that can be mapped at once. Each input can be given as file=url to set the URL the unit is loaded from."));
+    parser.addOption(bundleOption);
     QCommandLineOption directCallsOption("direct-calls"_L1, QCoreApplication::translate("main", "This option is ignored."));
     directCallsOption.setFlags(QCommandLineOption::HiddenFromHelp);
     parser.addOption(directCallsOption);
@@ -113,6 +116,7 @@ int main(int argc, char **argv)
         GenerateCacheFile,
         GenerateLoader,
         GenerateLoaderStandAlone,
+        GenerateBundle,
     } target = GenerateCacheFile;
 
     QString outputFileName;
@@ -128,10 +132,14 @@ int main(int argc, char **argv)
     if (target == GenerateLoader && parser.isSet(resourceNameOption))
         target = GenerateLoaderStandAlone;
 
+    if (parser.isSet(bundleOption))
+        target = GenerateBundle;
+
     const QStringList sources = parser.positionalArguments();
     if (sources.isEmpty()){
         parser.showHelp();
-    } else if (sources.size() > 1 && (target != GenerateLoader && target != GenerateLoaderStandAlone)) {
+    } else if (sources.size() > 1 && (target != GenerateLoader && target != GenerateLoaderStandAlone
+                                      && target != GenerateBundle)) {
         fprintf(stderr, "%s\n", qPrintable("Too many input files specified: '"_L1 + sources.join("' '"_L1) + u'\''));
         return EXIT_FAILURE;
     }
@@ -165,6 +173,22 @@ int main(int argc, char **argv)
         }
         return EXIT_SUCCESS;
     }
+
+    if (target == GenerateBundle) {
+        if (!parser.isSet(outputFileOption)) {
+            fprintf(stderr, "The --%s option requires an output file\n",
+                    qPrintable(bundleOption.names().first()));
+            return EXIT_FAILURE;
+        }
+
+        QQmlJSCompileError error;
+        if (!qQmlJSGenerateBundle(sources, outputFileName, &error.message)) {
+            error.augment("Error generating bundle: "_L1).print();
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     QString inputFileUrl = inputFile;
 
     QQmlJSSaveFunction saveFunction;
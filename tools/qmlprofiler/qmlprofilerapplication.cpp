@@ -55,6 +55,7 @@ QmlProfilerApplication::QmlProfilerApplication(int &argc, char **argv) :
     m_process(nullptr),
     m_hostName(QLatin1String("127.0.0.1")),
     m_port(0),
+    m_outputFormat(QmlProfilerData::QmlTrace),
     m_pendingRequest(REQUEST_NONE),
     m_verbose(false),
     m_recording(true),
@@ -133,6 +134,19 @@ void QmlProfilerApplication::parseArguments()
                                  "standard output."), QLatin1String("file"), QString());
     parser.addOption(output);
 
+    QCommandLineOption format(QLatin1String("format"),
+                              tr("Save the data in the given format. 'trace' writes a trace file "
+                                 "that can be loaded into Qt Creator. 'bindings' writes a table "
+                                 "of the bindings, aggregated per source location, with their "
+                                 "number of evaluations, total and self time, and the binding or "
+                                 "signal handler that most often triggered them. 'flamegraph' "
+                                 "writes collapsed stacks for flame graph tools, weighted by self "
+                                 "time in nanoseconds. 'chrome' writes JSON in the trace event "
+                                 "format. The default is 'trace'."),
+                              QLatin1String("trace|bindings|flamegraph|chrome"),
+                              QLatin1String("trace"));
+    parser.addOption(format);
+
     QCommandLineOption record(QLatin1String("record"),
                               tr("If set to 'off', don't immediately start recording data when the "
                                  "QML engine starts, but instead either start the recording "
@@ -204,6 +218,20 @@ void QmlProfilerApplication::parseArguments()
 
     m_outputFile = parser.value(output);
 
+    const QString formatValue = parser.value(format);
+    if (formatValue == QLatin1String("trace")) {
+        m_outputFormat = QmlProfilerData::QmlTrace;
+    } else if (formatValue == QLatin1String("bindings")) {
+        m_outputFormat = QmlProfilerData::BindingStatistics;
+    } else if (formatValue == QLatin1String("flamegraph")) {
+        m_outputFormat = QmlProfilerData::FlameGraph;
+    } else if (formatValue == QLatin1String("chrome")) {
+        m_outputFormat = QmlProfilerData::ChromeTrace;
+    } else {
+        logError(tr("'%1' is not a valid output format.").arg(formatValue));
+        parser.showHelp(5);
+    }
+
     m_recording = (parser.value(record) == QLatin1String("on"));
     m_interactive = parser.isSet(interactive);
 
@@ -280,7 +308,7 @@ void QmlProfilerApplication::flush()
         m_pendingRequest = REQUEST_FLUSH;
         m_qmlProfilerClient->setRecording(false);
     } else {
-        if (m_profilerData->save(m_interactiveOutputFile)) {
+        if (m_profilerData->save(m_interactiveOutputFile, m_outputFormat)) {
             m_profilerData->clear();
             if (!m_interactiveOutputFile.isEmpty())
                 prompt(tr("Data written to %1.").arg(m_interactiveOutputFile));
@@ -296,7 +324,7 @@ void QmlProfilerApplication::flush()
 
 void QmlProfilerApplication::output()
 {
-    if (m_profilerData->save(m_interactiveOutputFile)) {
+    if (m_profilerData->save(m_interactiveOutputFile, m_outputFormat)) {
         if (!m_interactiveOutputFile.isEmpty())
             prompt(tr("Data written to %1.").arg(m_interactiveOutputFile));
         else
@@ -427,7 +455,7 @@ void QmlProfilerApplication::notifyTraceStarted()
 void QmlProfilerApplication::outputData()
 {
     if (!m_profilerData->isEmpty()) {
-        m_profilerData->save(m_outputFile);
+        m_profilerData->save(m_outputFile, m_outputFormat);
         m_profilerData->clear();
     }
 }
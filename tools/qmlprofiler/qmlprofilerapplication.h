@@ -76,6 +76,7 @@ private:
     quint16 m_port;
     QString m_outputFile;
     QString m_interactiveOutputFile;
+    QmlProfilerData::OutputFormat m_outputFormat;
 
     PendingRequest m_pendingRequest;
     bool m_verbose;
@@ -11,7 +11,11 @@
 #include <QRegularExpression>
 #include <QQueue>
 #include <QStack>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
 
+#include <algorithm>
 #include <limits>
 
 const char PROFILER_FILE_VERSION[] = "1.02";
@@ -43,11 +47,22 @@ static const char *MESSAGE_STRINGS[] = {
 Q_STATIC_ASSERT(sizeof(MESSAGE_STRINGS) == MaximumMessage * sizeof(const char *));
 
 /////////////////////////////////////////////////////////////////
+struct QmlRange
+{
+    int typeIndex;
+    qint64 start;
+    qint64 childTime; // time spent in ranges nested into this one
+};
+
 class QmlProfilerDataPrivate
 {
 public:
     QmlProfilerDataPrivate(QmlProfilerData *qq){ Q_UNUSED(qq); }
 
+    template<typename Callback>
+    void forEachQmlRange(Callback &&callback) const;
+    QString frameName(int typeIndex) const;
+
     // data storage
     QVector<QQmlProfilerEventType> eventTypes;
     QVector<QQmlProfilerEvent> events;
@@ -205,6 +220,74 @@ void QmlProfilerData::addEventType(const QQmlProfilerEventType &type)
     d->eventTypes.append(newType);
 }
 
+static bool isQmlRange(RangeType rangeType)
+{
+    switch (rangeType) {
+    case Compiling:
+    case Creating:
+    case Binding:
+    case HandlingSignal:
+    case Javascript:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Calls callback with the enclosing ranges, outermost first, the range, and its end time for each
+// QML range when it ends. Ranges that haven't ended by the end of the trace are closed there. The
+// events have to be sorted by time.
+template<typename Callback>
+void QmlProfilerDataPrivate::forEachQmlRange(Callback &&callback) const
+{
+    QVector<QmlRange> stack;
+
+    auto closeInnermost = [&](qint64 end) {
+        const QmlRange range = stack.takeLast();
+        if (!stack.isEmpty())
+            stack.last().childTime += end - range.start;
+        callback(std::as_const(stack), range, end);
+    };
+
+    for (const QQmlProfilerEvent &event : std::as_const(events)) {
+        const QQmlProfilerEventType &type = eventTypes.at(event.typeIndex());
+        if (type.message() != MaximumMessage || !isQmlRange(type.rangeType()))
+            continue;
+
+        switch (event.rangeStage()) {
+        case RangeStart:
+            stack.append({event.typeIndex(), event.timestamp(), 0});
+            break;
+        case RangeEnd: {
+            // Ranges of the same type are nested. The end event only tells us the type.
+            qsizetype depth = stack.size();
+            while (depth > 0
+                   && eventTypes.at(stack.at(depth - 1).typeIndex).rangeType() != type.rangeType()) {
+                --depth;
+            }
+            while (depth > 0 && stack.size() >= depth)
+                closeInnermost(event.timestamp());
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    while (!stack.isEmpty())
+        closeInnermost(traceEndTime);
+}
+
+QString QmlProfilerDataPrivate::frameName(int typeIndex) const
+{
+    const QQmlProfilerEventType &type = eventTypes.at(typeIndex);
+    QString name = QmlProfilerData::qmlRangeTypeAsString(type.rangeType()) + QLatin1Char(' ')
+            + type.displayName();
+    // Semicolons separate the frames in collapsed stacks
+    name.replace(QLatin1Char(';'), QLatin1Char(','));
+    return name;
+}
+
 void QmlProfilerData::computeQmlTime()
 {
     // compute levels
@@ -296,23 +379,27 @@ bool QmlProfilerData::isEmpty() const
     return d->events.isEmpty();
 }
 
+static QString openOutputFile(QFile *file, const QString &filename)
+{
+    if (!filename.isEmpty()) {
+        file->setFileName(filename);
+        if (!file->open(QIODevice::WriteOnly))
+            return QmlProfilerData::tr("Could not open %1 for writing").arg(filename);
+    } else {
+        if (!file->open(stdout, QIODevice::WriteOnly))
+            return QmlProfilerData::tr("Could not open stdout for writing");
+    }
+    return QString();
+}
+
 struct StreamWriter {
     QString error;
 
     StreamWriter(const QString &filename)
     {
-        if (!filename.isEmpty()) {
-            file.setFileName(filename);
-            if (!file.open(QIODevice::WriteOnly)) {
-                error = QmlProfilerData::tr("Could not open %1 for writing").arg(filename);
-                return;
-            }
-        } else {
-            if (!file.open(stdout, QIODevice::WriteOnly)) {
-                error = QmlProfilerData::tr("Could not open stdout for writing");
-                return;
-            }
-        }
+        error = openOutputFile(&file, filename);
+        if (!error.isEmpty())
+            return;
 
         stream.setDevice(&file);
         stream.setAutoFormatting(true);
@@ -375,13 +462,29 @@ private:
     QXmlStreamWriter stream;
 };
 
-bool QmlProfilerData::save(const QString &filename)
+bool QmlProfilerData::save(const QString &filename, OutputFormat format)
 {
     if (isEmpty()) {
         emit error(tr("No data to save"));
         return false;
     }
 
+    switch (format) {
+    case QmlTrace:
+        return saveQmlTrace(filename);
+    case BindingStatistics:
+        return saveBindingStatistics(filename);
+    case FlameGraph:
+        return saveFlameGraph(filename);
+    case ChromeTrace:
+        return saveChromeTrace(filename);
+    }
+
+    Q_UNREACHABLE_RETURN(false);
+}
+
+bool QmlProfilerData::saveQmlTrace(const QString &filename)
+{
     StreamWriter stream(filename);
     if (!stream.error.isEmpty()) {
         emit error(stream.error);
@@ -555,6 +658,174 @@ bool QmlProfilerData::save(const QString &filename)
     return true;
 }
 
+// Writes a table of the bindings, aggregated per type, to filename. For each binding it lists how
+// often it was evaluated, the total time including nested ranges, the time spent in the binding
+// itself, and the range that most often triggered it. A binding evaluated while another binding
+// or signal handler runs is triggered by that one. The notifier of a binding evaluated at the top
+// level is not part of the trace.
+bool QmlProfilerData::saveBindingStatistics(const QString &filename)
+{
+    struct Statistics
+    {
+        qint64 calls = 0;
+        qint64 totalTime = 0;
+        qint64 selfTime = 0;
+        QHash<int, qint64> triggers; // -1 for top level
+    };
+
+    QHash<int, Statistics> statistics;
+    d->forEachQmlRange([&](const QVector<QmlRange> &stack, const QmlRange &range, qint64 end) {
+        if (d->eventTypes.at(range.typeIndex).rangeType() != Binding)
+            return;
+
+        Statistics &binding = statistics[range.typeIndex];
+        const qint64 duration = end - range.start;
+        ++binding.calls;
+        binding.selfTime += duration - range.childTime;
+
+        // Don't count the time of recursive evaluations twice.
+        const bool recursive = std::any_of(stack.begin(), stack.end(), [&](const QmlRange &outer) {
+            return outer.typeIndex == range.typeIndex;
+        });
+        if (!recursive)
+            binding.totalTime += duration;
+
+        ++binding.triggers[stack.isEmpty() ? -1 : stack.last().typeIndex];
+    });
+
+    QFile file;
+    const QString openError = openOutputFile(&file, filename);
+    if (!openError.isEmpty()) {
+        emit error(openError);
+        return false;
+    }
+
+    QList<int> bindings = statistics.keys();
+    std::sort(bindings.begin(), bindings.end(), [&](int a, int b) {
+        const Statistics &left = statistics[a];
+        const Statistics &right = statistics[b];
+        return left.selfTime != right.selfTime ? left.selfTime > right.selfTime : a < b;
+    });
+
+    auto milliseconds = [](qint64 nanoseconds) {
+        return QString::number(nanoseconds / 1e6, 'f', 3);
+    };
+
+    QTextStream stream(&file);
+    stream << Qt::left << qSetFieldWidth(10) << "Calls" << qSetFieldWidth(14) << "Total (ms)"
+           << "Self (ms)" << qSetFieldWidth(32) << "Location" << qSetFieldWidth(0)
+           << "Triggered by" << Qt::endl;
+
+    for (int typeIndex : std::as_const(bindings)) {
+        const Statistics &binding = statistics[typeIndex];
+
+        int trigger = -1;
+        qint64 triggerCount = 0;
+        for (auto it = binding.triggers.cbegin(), end = binding.triggers.cend(); it != end; ++it) {
+            if (it.value() > triggerCount || (it.value() == triggerCount && it.key() < trigger)) {
+                trigger = it.key();
+                triggerCount = it.value();
+            }
+        }
+
+        const QQmlProfilerEventType &type = d->eventTypes.at(typeIndex);
+        stream << qSetFieldWidth(10) << binding.calls << qSetFieldWidth(14)
+               << milliseconds(binding.totalTime) << milliseconds(binding.selfTime)
+               << qSetFieldWidth(32) << type.displayName() << qSetFieldWidth(0);
+        if (trigger == -1) {
+            stream << "-";
+        } else {
+            stream << d->frameName(trigger) << " (" << triggerCount << "/" << binding.calls
+                   << ")";
+        }
+        stream << Qt::endl;
+        if (!type.data().isEmpty())
+            stream << "    " << type.data() << Qt::endl;
+    }
+
+    return true;
+}
+
+// Writes the QML ranges as collapsed stacks to filename, as understood by flamegraph.pl and
+// compatible viewers. Each line holds the frames of a stack, separated by semicolons, and the
+// time spent in its innermost frame, in nanoseconds.
+bool QmlProfilerData::saveFlameGraph(const QString &filename)
+{
+    QHash<QString, qint64> selfTimes;
+    d->forEachQmlRange([&](const QVector<QmlRange> &stack, const QmlRange &range, qint64 end) {
+        QString frames;
+        for (const QmlRange &outer : stack)
+            frames += d->frameName(outer.typeIndex) + QLatin1Char(';');
+        frames += d->frameName(range.typeIndex);
+        selfTimes[frames] += end - range.start - range.childTime;
+    });
+
+    QFile file;
+    const QString openError = openOutputFile(&file, filename);
+    if (!openError.isEmpty()) {
+        emit error(openError);
+        return false;
+    }
+
+    QStringList stacks = selfTimes.keys();
+    stacks.sort();
+
+    QTextStream stream(&file);
+    for (const QString &frames : std::as_const(stacks))
+        stream << frames << ' ' << selfTimes.value(frames) << '\n';
+
+    return true;
+}
+
+// Writes the QML ranges as complete events in the trace event format to filename, which can be
+// loaded into chrome://tracing, Perfetto and similar viewers.
+bool QmlProfilerData::saveChromeTrace(const QString &filename)
+{
+    QFile file;
+    const QString openError = openOutputFile(&file, filename);
+    if (!openError.isEmpty()) {
+        emit error(openError);
+        return false;
+    }
+
+    file.write("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    bool first = true;
+    d->forEachQmlRange([&](const QVector<QmlRange> &, const QmlRange &range, qint64 end) {
+        const QQmlProfilerEventType &type = d->eventTypes.at(range.typeIndex);
+        const QQmlProfilerEventLocation location = type.location();
+
+        QJsonObject args;
+        if (!location.filename().isEmpty()) {
+            args.insert(QLatin1String("file"), location.filename());
+            args.insert(QLatin1String("line"), location.line());
+            args.insert(QLatin1String("column"), location.column());
+        }
+        if (!type.data().isEmpty())
+            args.insert(QLatin1String("details"), type.data());
+
+        // Timestamps and durations are given in microseconds.
+        const QJsonObject traceEvent {
+            { QLatin1String("name"), type.displayName() },
+            { QLatin1String("cat"), qmlRangeTypeAsString(type.rangeType()) },
+            { QLatin1String("ph"), QLatin1String("X") },
+            { QLatin1String("ts"), range.start / 1e3 },
+            { QLatin1String("dur"), (end - range.start) / 1e3 },
+            { QLatin1String("pid"), 1 },
+            { QLatin1String("tid"), 1 },
+            { QLatin1String("args"), args }
+        };
+
+        if (!first)
+            file.write(",\n");
+        first = false;
+        file.write(QJsonDocument(traceEvent).toJson(QJsonDocument::Compact));
+    });
+
+    file.write("\n]}\n");
+    return true;
+}
+
 void QmlProfilerData::setState(QmlProfilerData::State state)
 {
     // It's not an error, we are continuously calling "AcquiringData" for example
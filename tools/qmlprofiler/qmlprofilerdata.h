@@ -22,6 +22,13 @@ public:
         Done
     };
 
+    enum OutputFormat {
+        QmlTrace,           // .qtd file for Qt Creator
+        BindingStatistics,  // Bindings aggregated per location, as text
+        FlameGraph,         // Collapsed stacks of QML ranges
+        ChromeTrace         // Trace event JSON
+    };
+
     explicit QmlProfilerData(QObject *parent = nullptr);
     ~QmlProfilerData();
 
@@ -43,7 +50,7 @@ public:
     void setTraceStartTime(qint64 time);
 
     void complete();
-    bool save(const QString &filename);
+    bool save(const QString &filename, OutputFormat format = QmlTrace);
 
 Q_SIGNALS:
     void error(QString);
@@ -51,6 +58,11 @@ Q_SIGNALS:
     void dataReady();
 
 private:
+    bool saveQmlTrace(const QString &filename);
+    bool saveBindingStatistics(const QString &filename);
+    bool saveFlameGraph(const QString &filename);
+    bool saveChromeTrace(const QString &filename);
+
     void sortStartTimes();
     void computeQmlTime();
     void setState(QmlProfilerData::State state);